@@ -0,0 +1,942 @@
+/**
+ * @file: BatchTransform.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BatchTransform.h"
+#include "SimdUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+static_assert(sizeof(Vec4f) == 4*sizeof(float), "Vec4f must be tightly packed");
+static_assert(sizeof(Vec3f) == 3*sizeof(float), "Vec3f must be tightly packed");
+static_assert(sizeof(Vec2f) == 2*sizeof(float), "Vec2f must be tightly packed");
+static_assert(sizeof(Vec2) == 2*sizeof(int32_t), "Vec2 must be tightly packed");
+static_assert(sizeof(Vec2h) == 2*sizeof(int16_t), "Vec2h must be tightly packed");
+static_assert(sizeof(Vec4f16) == 4*sizeof(Half), "Vec4f16 must be tightly packed");
+static_assert(sizeof(Vec3f16) == 3*sizeof(Half), "Vec3f16 must be tightly packed");
+
+// The out[i] formulas of the half precision overloads in BatchTransform.h
+static_assert(std::is_same<decltype(FloatToHalf(HalfToFloat(std::declval<const Vec4f16&>()) * std::declval<const Mat4&>())), Vec4f16>::value,
+              "TransformBatch(Vec4f16) formula must compile");
+static_assert(std::is_same<decltype(Vec4f(HalfToFloat(std::declval<const Vec3f16&>()), 1) * std::declval<const Mat4&>()), Vec4f>::value,
+              "TransformPointBatch(Vec3f16) formula must compile");
+
+//**********************************************************************
+//* Scalar helpers
+//**********************************************************************
+static inline void storeScreen(Vec2f& o, float x, float y)
+{
+    o = Vec2f(x, y);
+}
+
+static inline void storeScreen(Vec2& o, float x, float y)
+{
+    o = Vec2(static_cast<int32_t>(lrintf(x)), static_cast<int32_t>(lrintf(y)));
+}
+
+static inline int16_t saturateInt16(long v)
+{
+    return static_cast<int16_t>(v < INT16_MIN ? INT16_MIN : (v > INT16_MAX ? INT16_MAX : v));
+}
+
+static inline void storeScreen(Vec2h& o, float x, float y)
+{
+    o = Vec2h(saturateInt16(lrintf(x)), saturateInt16(lrintf(y)));
+}
+
+template<class Out>
+static void project_scalar(const Mat4& m, const Viewport& vp, const Vec3f* in, Out* screen, float* invW, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const Vec4f v = Vec4f(in[i], 1.0f) * m;
+        assert(v.w != 0);
+        const float wInv = 1.0f / v.w;
+
+        storeScreen(screen[i], v.x * wInv * vp.scaleX + vp.offsetX,
+                               v.y * wInv * vp.scaleY + vp.offsetY);
+        if (invW)
+            invW[i] = wInv;
+    }
+}
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* SSE4.1 kernels
+//**********************************************************************
+// Row vector times matrix: out = x*row0 + y*row1 + z*row2 + w*row3
+
+VECTOR_TARGET_SSE41 static void transform4_sse41(const Mat4& m, const Vec4f* in, Vec4f* out, size_t n)
+{
+    const __m128 r0 = _mm_load_ps(m.data[0]);
+    const __m128 r1 = _mm_load_ps(m.data[1]);
+    const __m128 r2 = _mm_load_ps(m.data[2]);
+    const __m128 r3 = _mm_load_ps(m.data[3]);
+
+    const float* src = reinterpret_cast<const float*>(in);
+    float* dst = reinterpret_cast<float*>(out);
+
+    for (size_t i = 0; i < n; i++, src += 4, dst += 4)
+    {
+        const __m128 v = _mm_loadu_ps(src);
+        const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(v, v, 0x00), r0),
+                                     _mm_mul_ps(_mm_shuffle_ps(v, v, 0x55), r1));
+        const __m128 zw = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(v, v, 0xAA), r2),
+                                     _mm_mul_ps(_mm_shuffle_ps(v, v, 0xFF), r3));
+        _mm_storeu_ps(dst, _mm_add_ps(xy, zw));
+    }
+}
+
+template<bool point, bool storeW>
+VECTOR_TARGET_SSE41 static void transform3_sse41(const Mat4& m, const Vec3f* in, float* dst, size_t n)
+{
+    const __m128 r0 = _mm_load_ps(m.data[0]);
+    const __m128 r1 = _mm_load_ps(m.data[1]);
+    const __m128 r2 = _mm_load_ps(m.data[2]);
+    const __m128 r3 = point ? _mm_load_ps(m.data[3]) : _mm_setzero_ps();
+
+    for (size_t i = 0; i < n; i++)
+    {
+        const __m128 x = _mm_set1_ps(in[i].x);
+        const __m128 y = _mm_set1_ps(in[i].y);
+        const __m128 z = _mm_set1_ps(in[i].z);
+        const __m128 xy = _mm_add_ps(_mm_mul_ps(x, r0), _mm_mul_ps(y, r1));
+        const __m128 zw = _mm_add_ps(_mm_mul_ps(z, r2), r3);
+        const __m128 r = _mm_add_ps(xy, zw);
+
+        if (storeW)
+        {
+            _mm_storeu_ps(dst, r);
+            dst += 4;
+        }
+        else
+        {
+            _mm_storel_pi(reinterpret_cast<__m64*>(dst), r);
+            _mm_store_ss(dst + 2, _mm_movehl_ps(r, r));
+            dst += 3;
+        }
+    }
+}
+
+//**********************************************************************
+//* AVX2 + FMA kernels
+//**********************************************************************
+// Two vectors per 256 bit register. Matrix rows are duplicated in both lanes.
+
+VECTOR_TARGET_AVX2 static inline __m256 transform4x2_avx2(__m256 v, __m256 r0, __m256 r1, __m256 r2, __m256 r3)
+{
+    const __m256 xy = _mm256_fmadd_ps(_mm256_permute_ps(v, 0x00), r0, _mm256_mul_ps(_mm256_permute_ps(v, 0x55), r1));
+    const __m256 zw = _mm256_fmadd_ps(_mm256_permute_ps(v, 0xAA), r2, _mm256_mul_ps(_mm256_permute_ps(v, 0xFF), r3));
+    return _mm256_add_ps(xy, zw);
+}
+
+VECTOR_TARGET_AVX2 static void transform4_avx2(const Mat4& m, const Vec4f* in, Vec4f* out, size_t n)
+{
+    const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[0]));
+    const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[1]));
+    const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[2]));
+    const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[3]));
+
+    const float* src = reinterpret_cast<const float*>(in);
+    float* dst = reinterpret_cast<float*>(out);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, src += 16, dst += 16)
+    {
+        const __m256 a = _mm256_loadu_ps(src);
+        const __m256 b = _mm256_loadu_ps(src + 8);
+        _mm256_storeu_ps(dst, transform4x2_avx2(a, r0, r1, r2, r3));
+        _mm256_storeu_ps(dst + 8, transform4x2_avx2(b, r0, r1, r2, r3));
+    }
+
+    for (; i < n; i++, src += 4, dst += 4)
+    {
+        const __m128 v = _mm_loadu_ps(src);
+        const __m128 xy = _mm_fmadd_ps(_mm_permute_ps(v, 0x00), _mm256_castps256_ps128(r0),
+                                       _mm_mul_ps(_mm_permute_ps(v, 0x55), _mm256_castps256_ps128(r1)));
+        const __m128 zw = _mm_fmadd_ps(_mm_permute_ps(v, 0xAA), _mm256_castps256_ps128(r2),
+                                       _mm_mul_ps(_mm_permute_ps(v, 0xFF), _mm256_castps256_ps128(r3)));
+        _mm_storeu_ps(dst, _mm_add_ps(xy, zw));
+    }
+}
+
+template<bool point, bool storeW>
+VECTOR_TARGET_AVX2 static void transform3_avx2(const Mat4& m, const Vec3f* in, float* dst, size_t n)
+{
+    const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[0]));
+    const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[1]));
+    const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[2]));
+    const __m256 r3 = point ? _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[3])) : _mm256_setzero_ps();
+
+    // Lane indices to splat x/y/z of two packed Vec3f (x0 y0 z0 x1 y1 z1 ..)
+    const __m256i splatX = _mm256_setr_epi32(0, 0, 0, 0, 3, 3, 3, 3);
+    const __m256i splatY = _mm256_setr_epi32(1, 1, 1, 1, 4, 4, 4, 4);
+    const __m256i splatZ = _mm256_setr_epi32(2, 2, 2, 2, 5, 5, 5, 5);
+    // Drop w of both results to get six packed floats
+    const __m256i packXYZ = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+    const float* src = reinterpret_cast<const float*>(in);
+
+    size_t i = 0;
+    // Each iteration reads 8 floats, so keep at least a third vector ahead
+    for (; i + 3 <= n; i += 2, src += 6)
+    {
+        const __m256 v = _mm256_loadu_ps(src);
+        const __m256 xy = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(v, splatX), r0,
+                                          _mm256_mul_ps(_mm256_permutevar8x32_ps(v, splatY), r1));
+        const __m256 r = _mm256_add_ps(xy, _mm256_fmadd_ps(_mm256_permutevar8x32_ps(v, splatZ), r2, r3));
+
+        if (storeW)
+        {
+            _mm256_storeu_ps(dst, r);
+            dst += 8;
+        }
+        else
+        {
+            const __m256 p = _mm256_permutevar8x32_ps(r, packXYZ);
+            _mm_storeu_ps(dst, _mm256_castps256_ps128(p));
+            _mm_storel_pi(reinterpret_cast<__m64*>(dst + 4), _mm256_extractf128_ps(p, 1));
+            dst += 6;
+        }
+    }
+
+    for (; i < n; i++, src += 3)
+    {
+        const __m128 xy = _mm_fmadd_ps(_mm_broadcast_ss(src), _mm256_castps256_ps128(r0),
+                                       _mm_mul_ps(_mm_broadcast_ss(src + 1), _mm256_castps256_ps128(r1)));
+        const __m128 r = _mm_add_ps(xy, _mm_fmadd_ps(_mm_broadcast_ss(src + 2), _mm256_castps256_ps128(r2),
+                                                     _mm256_castps256_ps128(r3)));
+        if (storeW)
+        {
+            _mm_storeu_ps(dst, r);
+            dst += 4;
+        }
+        else
+        {
+            _mm_storel_pi(reinterpret_cast<__m64*>(dst), r);
+            _mm_store_ss(dst + 2, _mm_movehl_ps(r, r));
+            dst += 3;
+        }
+    }
+}
+
+//**********************************************************************
+//* Half precision kernels (AVX2 + F16C)
+//**********************************************************************
+// Halves are widened with vcvtph2ps on load and the results narrowed with
+// vcvtps2ph on store. The float math is done in the same order as
+// transform4_avx2 / transform3_avx2, so the results match widening, calling
+// the float kernel and narrowing.
+
+VECTOR_TARGET_AVX2 static void transform4h_avx2(const Mat4& m, const Vec4f16* in, Vec4f16* out, size_t n)
+{
+    const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[0]));
+    const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[1]));
+    const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[2]));
+    const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[3]));
+
+    const __m128i* src = reinterpret_cast<const __m128i*>(in);
+    __m128i* dst = reinterpret_cast<__m128i*>(out);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, src += 2, dst += 2)
+    {
+        const __m256 a = _mm256_cvtph_ps(_mm_loadu_si128(src));
+        const __m256 b = _mm256_cvtph_ps(_mm_loadu_si128(src + 1));
+        _mm_storeu_si128(dst,     _mm256_cvtps_ph(transform4x2_avx2(a, r0, r1, r2, r3), _MM_FROUND_TO_NEAREST_INT));
+        _mm_storeu_si128(dst + 1, _mm256_cvtps_ph(transform4x2_avx2(b, r0, r1, r2, r3), _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    const Vec4f16* rest = reinterpret_cast<const Vec4f16*>(src);
+    Vec4f16* restOut = reinterpret_cast<Vec4f16*>(dst);
+    for (; i < n; i++, rest++, restOut++)
+    {
+        const __m128 v = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(rest)));
+        const __m128 xy = _mm_fmadd_ps(_mm_permute_ps(v, 0x00), _mm256_castps256_ps128(r0),
+                                       _mm_mul_ps(_mm_permute_ps(v, 0x55), _mm256_castps256_ps128(r1)));
+        const __m128 zw = _mm_fmadd_ps(_mm_permute_ps(v, 0xAA), _mm256_castps256_ps128(r2),
+                                       _mm_mul_ps(_mm_permute_ps(v, 0xFF), _mm256_castps256_ps128(r3)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(restOut), _mm_cvtps_ph(_mm_add_ps(xy, zw), _MM_FROUND_TO_NEAREST_INT));
+    }
+}
+
+// Same scheme as transform3_avx2: two vectors per iteration, x/y/z splatted
+// across the lanes holding each vector. The 16 byte load covers two Vec3f16
+// and part of a third, so one more vector must follow.
+template<bool point, class Out>
+VECTOR_TARGET_AVX2 static void transform3h_avx2(const Mat4& m, const Vec3f16* in, Out* out, size_t n)
+{
+    constexpr bool storeW = std::is_same<Out, Vec4f>::value;
+    const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[0]));
+    const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[1]));
+    const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[2]));
+    const __m256 r3 = point ? _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.data[3])) : _mm256_setzero_ps();
+
+    const __m256i splatX = _mm256_setr_epi32(0, 0, 0, 0, 3, 3, 3, 3);
+    const __m256i splatY = _mm256_setr_epi32(1, 1, 1, 1, 4, 4, 4, 4);
+    const __m256i splatZ = _mm256_setr_epi32(2, 2, 2, 2, 5, 5, 5, 5);
+    const __m256i packXYZ = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+    const Vec3f16* src = in;
+    Out* dst = out;
+
+    size_t i = 0;
+    for (; i + 3 <= n; i += 2, src += 2, dst += 2)
+    {
+        const __m256 v = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+        const __m256 xy = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(v, splatX), r0,
+                                          _mm256_mul_ps(_mm256_permutevar8x32_ps(v, splatY), r1));
+        const __m256 r = _mm256_add_ps(xy, _mm256_fmadd_ps(_mm256_permutevar8x32_ps(v, splatZ), r2, r3));
+
+        if constexpr (storeW)
+        {
+            _mm256_storeu_ps(reinterpret_cast<float*>(dst), r);
+        }
+        else
+        {
+            const __m128i h = _mm256_cvtps_ph(_mm256_permutevar8x32_ps(r, packXYZ), _MM_FROUND_TO_NEAREST_INT);
+            const int32_t z1 = _mm_extract_epi32(h, 2);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), h);
+            memcpy(&dst[1].y, &z1, sizeof(z1));
+        }
+    }
+
+    for (; i < n; i++, src++, dst++)
+    {
+        uint16_t h[4] = { src->x.bits, src->y.bits, src->z.bits, 0 };
+        const __m128 v = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(h)));
+        const __m128 xy = _mm_fmadd_ps(_mm_permute_ps(v, 0x00), _mm256_castps256_ps128(r0),
+                                       _mm_mul_ps(_mm_permute_ps(v, 0x55), _mm256_castps256_ps128(r1)));
+        const __m128 r = _mm_add_ps(xy, _mm_fmadd_ps(_mm_permute_ps(v, 0xAA), _mm256_castps256_ps128(r2),
+                                                     _mm256_castps256_ps128(r3)));
+        if constexpr (storeW)
+        {
+            _mm_storeu_ps(reinterpret_cast<float*>(dst), r);
+        }
+        else
+        {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(h), _mm_cvtps_ph(r, _MM_FROUND_TO_NEAREST_INT));
+            memcpy(dst, h, sizeof(Vec3f16));
+        }
+    }
+}
+
+//**********************************************************************
+//* Projection kernels
+//**********************************************************************
+// Vertices are deinterleaved into x/y/z registers, so each matrix element is
+// a broadcast and the three dot products needed (clip x, y and w) become
+// plain multiply-adds across vertices. The incomplete last block goes
+// through the same code using a zero padded copy of the input.
+
+template<class Out>
+VECTOR_TARGET_SSE41 static void projectBlock_sse41(const __m128 (&c)[16], const float* src, Out* screen, float* invW)
+{
+    __m128 x, y, z;
+    deinterleave3_sse41(src, x, y, z);
+
+    const __m128 cx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, c[0]), _mm_mul_ps(y, c[1])), _mm_add_ps(_mm_mul_ps(z, c[2]), c[3]));
+    const __m128 cy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, c[4]), _mm_mul_ps(y, c[5])), _mm_add_ps(_mm_mul_ps(z, c[6]), c[7]));
+    const __m128 cw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, c[8]), _mm_mul_ps(y, c[9])), _mm_add_ps(_mm_mul_ps(z, c[10]), c[11]));
+
+    const __m128 r = rcpNewton_sse41(cw);
+    const __m128 sx = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(cx, r), c[12]), c[14]);
+    const __m128 sy = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(cy, r), c[13]), c[15]);
+
+    if (invW)
+        _mm_storeu_ps(invW, r);
+
+    if constexpr (std::is_same<Out, Vec2f>::value)
+    {
+        float* dst = reinterpret_cast<float*>(screen);
+        _mm_storeu_ps(dst,     _mm_unpacklo_ps(sx, sy));
+        _mm_storeu_ps(dst + 4, _mm_unpackhi_ps(sx, sy));
+    }
+    else if constexpr (std::is_same<Out, Vec2>::value)
+    {
+        const __m128i ix = _mm_cvtps_epi32(sx);
+        const __m128i iy = _mm_cvtps_epi32(sy);
+        __m128i* dst = reinterpret_cast<__m128i*>(screen);
+        _mm_storeu_si128(dst,     _mm_unpacklo_epi32(ix, iy));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi32(ix, iy));
+    }
+    else
+    {
+        static_assert(std::is_same<Out, Vec2h>::value, "Unsupported screen type");
+        // x0..x3 y0..y3 -> x0 y0 x1 y1 x2 y2 x3 y3
+        const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(sx), _mm_cvtps_epi32(sy));
+        const __m128i order = _mm_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(screen), _mm_shuffle_epi8(packed, order));
+    }
+}
+
+template<class Out>
+VECTOR_TARGET_SSE41 static void project_sse41(const Mat4& m, const Viewport& vp, const Vec3f* in, Out* screen, float* invW, size_t n)
+{
+    const __m128 c[16] = {
+        _mm_set1_ps(m.data[0][0]), _mm_set1_ps(m.data[1][0]), _mm_set1_ps(m.data[2][0]), _mm_set1_ps(m.data[3][0]),
+        _mm_set1_ps(m.data[0][1]), _mm_set1_ps(m.data[1][1]), _mm_set1_ps(m.data[2][1]), _mm_set1_ps(m.data[3][1]),
+        _mm_set1_ps(m.data[0][3]), _mm_set1_ps(m.data[1][3]), _mm_set1_ps(m.data[2][3]), _mm_set1_ps(m.data[3][3]),
+        _mm_set1_ps(vp.scaleX), _mm_set1_ps(vp.scaleY), _mm_set1_ps(vp.offsetX), _mm_set1_ps(vp.offsetY),
+    };
+
+    const float* src = reinterpret_cast<const float*>(in);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, src += 12)
+        projectBlock_sse41(c, src, screen + i, invW ? invW + i : nullptr);
+
+    const size_t rest = n - i;
+    if (rest)
+    {
+        float tmpIn[12] = {0};
+        Out tmpOut[4];
+        float tmpW[4];
+        memcpy(tmpIn, src, rest * sizeof(Vec3f));
+        projectBlock_sse41(c, tmpIn, tmpOut, tmpW);
+        memcpy(screen + i, tmpOut, rest * sizeof(Out));
+        if (invW)
+            memcpy(invW + i, tmpW, rest * sizeof(float));
+    }
+}
+
+template<class Out>
+VECTOR_TARGET_AVX2 static void projectBlock_avx2(const __m256 (&c)[16], const float* src, Out* screen, float* invW)
+{
+    __m256 x, y, z;
+    deinterleave3_avx2(src, x, y, z);
+
+    const __m256 cx = _mm256_fmadd_ps(x, c[0], _mm256_fmadd_ps(y, c[1], _mm256_fmadd_ps(z, c[2], c[3])));
+    const __m256 cy = _mm256_fmadd_ps(x, c[4], _mm256_fmadd_ps(y, c[5], _mm256_fmadd_ps(z, c[6], c[7])));
+    const __m256 cw = _mm256_fmadd_ps(x, c[8], _mm256_fmadd_ps(y, c[9], _mm256_fmadd_ps(z, c[10], c[11])));
+
+    const __m256 r = rcpNewton_avx2(cw);
+    const __m256 sx = _mm256_fmadd_ps(_mm256_mul_ps(cx, r), c[12], c[14]);
+    const __m256 sy = _mm256_fmadd_ps(_mm256_mul_ps(cy, r), c[13], c[15]);
+
+    if (invW)
+        _mm256_storeu_ps(invW, r);
+
+    // Lane 0 holds vertices 0-3 and lane 1 vertices 4-7
+    if constexpr (std::is_same<Out, Vec2f>::value)
+    {
+        const __m256 lo = _mm256_unpacklo_ps(sx, sy); // v0 v1 | v4 v5
+        const __m256 hi = _mm256_unpackhi_ps(sx, sy); // v2 v3 | v6 v7
+        float* dst = reinterpret_cast<float*>(screen);
+        _mm256_storeu_ps(dst,     _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    else if constexpr (std::is_same<Out, Vec2>::value)
+    {
+        const __m256i ix = _mm256_cvtps_epi32(sx);
+        const __m256i iy = _mm256_cvtps_epi32(sy);
+        const __m256i lo = _mm256_unpacklo_epi32(ix, iy);
+        const __m256i hi = _mm256_unpackhi_epi32(ix, iy);
+        __m256i* dst = reinterpret_cast<__m256i*>(screen);
+        _mm256_storeu_si256(dst,     _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    else
+    {
+        static_assert(std::is_same<Out, Vec2h>::value, "Unsupported screen type");
+        const __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(sx), _mm256_cvtps_epi32(sy));
+        const __m256i order = _mm256_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15,
+                                               0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(screen), _mm256_shuffle_epi8(packed, order));
+    }
+}
+
+template<class Out>
+VECTOR_TARGET_AVX2 static void project_avx2(const Mat4& m, const Viewport& vp, const Vec3f* in, Out* screen, float* invW, size_t n)
+{
+    const __m256 c[16] = {
+        _mm256_set1_ps(m.data[0][0]), _mm256_set1_ps(m.data[1][0]), _mm256_set1_ps(m.data[2][0]), _mm256_set1_ps(m.data[3][0]),
+        _mm256_set1_ps(m.data[0][1]), _mm256_set1_ps(m.data[1][1]), _mm256_set1_ps(m.data[2][1]), _mm256_set1_ps(m.data[3][1]),
+        _mm256_set1_ps(m.data[0][3]), _mm256_set1_ps(m.data[1][3]), _mm256_set1_ps(m.data[2][3]), _mm256_set1_ps(m.data[3][3]),
+        _mm256_set1_ps(vp.scaleX), _mm256_set1_ps(vp.scaleY), _mm256_set1_ps(vp.offsetX), _mm256_set1_ps(vp.offsetY),
+    };
+
+    const float* src = reinterpret_cast<const float*>(in);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, src += 24)
+        projectBlock_avx2(c, src, screen + i, invW ? invW + i : nullptr);
+
+    const size_t rest = n - i;
+    if (rest)
+    {
+        float tmpIn[24] = {0};
+        Out tmpOut[8];
+        float tmpW[8];
+        memcpy(tmpIn, src, rest * sizeof(Vec3f));
+        projectBlock_avx2(c, tmpIn, tmpOut, tmpW);
+        memcpy(screen + i, tmpOut, rest * sizeof(Out));
+        if (invW)
+            memcpy(invW + i, tmpW, rest * sizeof(float));
+    }
+}
+
+//**********************************************************************
+//* Matrix product kernels
+//**********************************************************************
+// Row i of A * B is the sum over k of A[i][k] * row k of B. The SSE4.1 kernel
+// does the same arithmetic as Mat4::operator*, the wider ones fuse the x and
+// z products into FMAs. All inputs of an iteration are loaded before its outputs are
+// stored, which makes C == A or C == B safe. manyA / manyB select whether the
+// operand advances with the index or is a single shared matrix.
+
+VECTOR_TARGET_SSE41 static inline __m128 rowTimes_sse41(__m128 a, const float* B)
+{
+    const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, 0x00), _mm_load_ps(B)),
+                                 _mm_mul_ps(_mm_shuffle_ps(a, a, 0x55), _mm_load_ps(B + 4)));
+    const __m128 zw = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, 0xAA), _mm_load_ps(B + 8)),
+                                 _mm_mul_ps(_mm_shuffle_ps(a, a, 0xFF), _mm_load_ps(B + 12)));
+    return _mm_add_ps(xy, zw);
+}
+
+template<bool manyA, bool manyB>
+VECTOR_TARGET_SSE41 static void multiply_sse41(const float* A, const float* B, float* C, size_t n)
+{
+    for (size_t i = 0; i < n; i++, C += 16)
+    {
+        const float* a = manyA ? A + 16*i : A;
+        const float* b = manyB ? B + 16*i : B;
+
+        const __m128 r0 = rowTimes_sse41(_mm_load_ps(a),      b);
+        const __m128 r1 = rowTimes_sse41(_mm_load_ps(a + 4),  b);
+        const __m128 r2 = rowTimes_sse41(_mm_load_ps(a + 8),  b);
+        const __m128 r3 = rowTimes_sse41(_mm_load_ps(a + 12), b);
+
+        _mm_store_ps(C,      r0);
+        _mm_store_ps(C + 4,  r1);
+        _mm_store_ps(C + 8,  r2);
+        _mm_store_ps(C + 12, r3);
+    }
+}
+
+// Two rows of A per 256 bit register, rows of B duplicated in both lanes.
+// Two matrices are processed per iteration.
+VECTOR_TARGET_AVX2 static inline __m256 rowsTimes_avx2(__m256 a, const float* B)
+{
+    const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(B));
+    const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(B + 4));
+    const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(B + 8));
+    const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(B + 12));
+
+    const __m256 xy = _mm256_fmadd_ps(_mm256_permute_ps(a, 0x00), b0, _mm256_mul_ps(_mm256_permute_ps(a, 0x55), b1));
+    const __m256 zw = _mm256_fmadd_ps(_mm256_permute_ps(a, 0xAA), b2, _mm256_mul_ps(_mm256_permute_ps(a, 0xFF), b3));
+    return _mm256_add_ps(xy, zw);
+}
+
+template<bool manyA, bool manyB>
+VECTOR_TARGET_AVX2 static void multiply_avx2(const float* A, const float* B, float* C, size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2, C += 32)
+    {
+        const float* a0 = manyA ? A + 16*i : A;
+        const float* a1 = manyA ? a0 + 16  : A;
+        const float* b0 = manyB ? B + 16*i : B;
+        const float* b1 = manyB ? b0 + 16  : B;
+
+        const __m256 r0 = rowsTimes_avx2(_mm256_loadu_ps(a0),     b0);
+        const __m256 r1 = rowsTimes_avx2(_mm256_loadu_ps(a0 + 8), b0);
+        const __m256 r2 = rowsTimes_avx2(_mm256_loadu_ps(a1),     b1);
+        const __m256 r3 = rowsTimes_avx2(_mm256_loadu_ps(a1 + 8), b1);
+
+        _mm256_storeu_ps(C,      r0);
+        _mm256_storeu_ps(C + 8,  r1);
+        _mm256_storeu_ps(C + 16, r2);
+        _mm256_storeu_ps(C + 24, r3);
+    }
+
+    if (i < n)
+    {
+        const float* a = manyA ? A + 16*i : A;
+        const float* b = manyB ? B + 16*i : B;
+        const __m256 r0 = rowsTimes_avx2(_mm256_loadu_ps(a),     b);
+        const __m256 r1 = rowsTimes_avx2(_mm256_loadu_ps(a + 8), b);
+        _mm256_storeu_ps(C,     r0);
+        _mm256_storeu_ps(C + 8, r1);
+    }
+}
+
+// A whole matrix per 512 bit register: 128 bit lane i holds row i of A.
+// Four matrices are processed per iteration.
+VECTOR_TARGET_AVX512 static inline __m512 matTimes_avx512(__m512 a, const float* B)
+{
+    const __m512 b0 = _mm512_broadcast_f32x4(_mm_load_ps(B));
+    const __m512 b1 = _mm512_broadcast_f32x4(_mm_load_ps(B + 4));
+    const __m512 b2 = _mm512_broadcast_f32x4(_mm_load_ps(B + 8));
+    const __m512 b3 = _mm512_broadcast_f32x4(_mm_load_ps(B + 12));
+
+    const __m512 xy = _mm512_fmadd_ps(_mm512_permute_ps(a, 0x00), b0, _mm512_mul_ps(_mm512_permute_ps(a, 0x55), b1));
+    const __m512 zw = _mm512_fmadd_ps(_mm512_permute_ps(a, 0xAA), b2, _mm512_mul_ps(_mm512_permute_ps(a, 0xFF), b3));
+    return _mm512_add_ps(xy, zw);
+}
+
+template<bool manyA, bool manyB>
+VECTOR_TARGET_AVX512 static void multiply_avx512(const float* A, const float* B, float* C, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, C += 64)
+    {
+        __m512 r[4];
+        for (int k = 0; k < 4; k++)
+        {
+            const float* a = manyA ? A + 16*(i + k) : A;
+            const float* b = manyB ? B + 16*(i + k) : B;
+            r[k] = matTimes_avx512(_mm512_loadu_ps(a), b);
+        }
+        for (int k = 0; k < 4; k++)
+            _mm512_storeu_ps(C + 16*k, r[k]);
+    }
+
+    for (; i < n; i++, C += 16)
+    {
+        const float* a = manyA ? A + 16*i : A;
+        const float* b = manyB ? B + 16*i : B;
+        _mm512_storeu_ps(C, matTimes_avx512(_mm512_loadu_ps(a), b));
+    }
+}
+
+// Mat3x4 rows: row r of a * b is b[r][0..2] applied to the rows of a plus
+// (0, 0, 0, b[r][3]). The SSE4.1 kernel uses the inline row of
+// Mat3x4::operator*, the AVX2 one fuses the x and z products into FMAs.
+
+VECTOR_TARGET_AVX2 static inline __m128 affineRow_avx2(__m128 b, __m128 a0, __m128 a1, __m128 a2, __m128 wMask)
+{
+    const __m128 xy = _mm_fmadd_ps(_mm_permute_ps(b, 0x00), a0, _mm_mul_ps(_mm_permute_ps(b, 0x55), a1));
+    const __m128 zw = _mm_fmadd_ps(_mm_permute_ps(b, 0xAA), a2, _mm_and_ps(b, wMask));
+    return _mm_add_ps(xy, zw);
+}
+
+template<bool manyA, bool manyB>
+VECTOR_TARGET_SSE41 static void multiplyAffine_sse41(const float* A, const float* B, float* C, size_t n)
+{
+    for (size_t i = 0; i < n; i++, C += 12)
+    {
+        const float* a = manyA ? A + 12*i : A;
+        const float* b = manyB ? B + 12*i : B;
+        const __m128 a0 = _mm_load_ps(a);
+        const __m128 a1 = _mm_load_ps(a + 4);
+        const __m128 a2 = _mm_load_ps(a + 8);
+
+        const __m128 r0 = rowTimes3x4_sse(_mm_load_ps(b),     a0, a1, a2);
+        const __m128 r1 = rowTimes3x4_sse(_mm_load_ps(b + 4), a0, a1, a2);
+        const __m128 r2 = rowTimes3x4_sse(_mm_load_ps(b + 8), a0, a1, a2);
+        _mm_store_ps(C,     r0);
+        _mm_store_ps(C + 4, r1);
+        _mm_store_ps(C + 8, r2);
+    }
+}
+
+template<bool manyA, bool manyB>
+VECTOR_TARGET_AVX2 static void multiplyAffine_avx2(const float* A, const float* B, float* C, size_t n)
+{
+    const __m128 wMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+    for (size_t i = 0; i < n; i++, C += 12)
+    {
+        const float* a = manyA ? A + 12*i : A;
+        const float* b = manyB ? B + 12*i : B;
+        const __m128 a0 = _mm_load_ps(a);
+        const __m128 a1 = _mm_load_ps(a + 4);
+        const __m128 a2 = _mm_load_ps(a + 8);
+
+        const __m128 r0 = affineRow_avx2(_mm_load_ps(b),     a0, a1, a2, wMask);
+        const __m128 r1 = affineRow_avx2(_mm_load_ps(b + 4), a0, a1, a2, wMask);
+        const __m128 r2 = affineRow_avx2(_mm_load_ps(b + 8), a0, a1, a2, wMask);
+        _mm_store_ps(C,     r0);
+        _mm_store_ps(C + 4, r1);
+        _mm_store_ps(C + 8, r2);
+    }
+}
+
+#endif // VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Public API
+//**********************************************************************
+void TransformBatch(const Mat4& m, const Vec4f* in, Vec4f* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return transform4_avx2(m, in, out, n);
+    case SimdLevel::SSE41: return transform4_sse41(m, in, out, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        out[i] = in[i] * m;
+}
+
+void TransformPointBatch(const Mat4& m, const Vec3f* in, Vec4f* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    float* dst = reinterpret_cast<float*>(out);
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return transform3_avx2<true, true>(m, in, dst, n);
+    case SimdLevel::SSE41: return transform3_sse41<true, true>(m, in, dst, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        out[i] = Vec4f(in[i], 1.0f) * m;
+}
+
+void TransformPointBatch(const Mat4& m, const Vec3f* in, Vec3f* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    float* dst = reinterpret_cast<float*>(out);
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return transform3_avx2<true, false>(m, in, dst, n);
+    case SimdLevel::SSE41: return transform3_sse41<true, false>(m, in, dst, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+    {
+        const Vec4f v = Vec4f(in[i], 1.0f) * m;
+        out[i] = Vec3f(v.x, v.y, v.z);
+    }
+}
+
+void TransformDirectionBatch(const Mat4& m, const Vec3f* in, Vec3f* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    float* dst = reinterpret_cast<float*>(out);
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return transform3_avx2<false, false>(m, in, dst, n);
+    case SimdLevel::SSE41: return transform3_sse41<false, false>(m, in, dst, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+    {
+        const Vec4f v = Vec4f(in[i], 0.0f) * m;
+        out[i] = Vec3f(v.x, v.y, v.z);
+    }
+}
+
+//**********************************************************************
+//* Half precision vertices
+//**********************************************************************
+// Below the AVX2 level there is no F16C: widen a block to float, run the
+// float overload and narrow its output. Each block is read completely before
+// its output is written, so in and out may be the same array.
+template<class FloatIn, class FloatOut, class In, class Out, class Fn>
+static void throughFloat(const In* in, Out* out, size_t n, Fn transform)
+{
+    constexpr size_t block = 32;
+    constexpr size_t inCount = sizeof(In) / sizeof(Half);
+    constexpr size_t outCount = sizeof(Out) / sizeof(Half);
+
+    FloatIn tmpIn[block];
+    for (size_t i = 0; i < n; i += block)
+    {
+        const size_t k = std::min(block, n - i);
+        HalfToFloatBatch(reinterpret_cast<const Half*>(in + i), reinterpret_cast<float*>(tmpIn), k * inCount);
+        if constexpr (std::is_same<Out, FloatOut>::value)
+        {
+            transform(tmpIn, out + i, k);
+        }
+        else
+        {
+            FloatOut tmpOut[block];
+            transform(tmpIn, tmpOut, k);
+            FloatToHalfBatch(reinterpret_cast<const float*>(tmpOut), reinterpret_cast<Half*>(out + i), k * outCount);
+        }
+    }
+}
+
+void TransformBatch(const Mat4& m, const Vec4f16* in, Vec4f16* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    if (SimdActiveLevel() >= SimdLevel::AVX2)
+        return transform4h_avx2(m, in, out, n);
+#endif
+    throughFloat<Vec4f, Vec4f>(in, out, n, [&m](const Vec4f* a, Vec4f* b, size_t k) {
+        TransformBatch(m, a, b, k);
+    });
+}
+
+void TransformPointBatch(const Mat4& m, const Vec3f16* in, Vec4f* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    if (SimdActiveLevel() >= SimdLevel::AVX2)
+        return transform3h_avx2<true>(m, in, out, n);
+#endif
+    throughFloat<Vec3f, Vec4f>(in, out, n, [&m](const Vec3f* a, Vec4f* b, size_t k) {
+        TransformPointBatch(m, a, b, k);
+    });
+}
+
+void TransformPointBatch(const Mat4& m, const Vec3f16* in, Vec3f16* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    if (SimdActiveLevel() >= SimdLevel::AVX2)
+        return transform3h_avx2<true>(m, in, out, n);
+#endif
+    throughFloat<Vec3f, Vec3f>(in, out, n, [&m](const Vec3f* a, Vec3f* b, size_t k) {
+        TransformPointBatch(m, a, b, k);
+    });
+}
+
+void TransformDirectionBatch(const Mat4& m, const Vec3f16* in, Vec3f16* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    if (SimdActiveLevel() >= SimdLevel::AVX2)
+        return transform3h_avx2<false>(m, in, out, n);
+#endif
+    throughFloat<Vec3f, Vec3f>(in, out, n, [&m](const Vec3f* a, Vec3f* b, size_t k) {
+        TransformDirectionBatch(m, a, b, k);
+    });
+}
+
+template<class Out>
+static void project(const Mat4& m, const Viewport& vp, const Vec3f* in, Out* screen, float* invW, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return project_avx2(m, vp, in, screen, invW, n);
+    case SimdLevel::SSE41: return project_sse41(m, vp, in, screen, invW, n);
+    default: break;
+    }
+#endif
+    project_scalar(m, vp, in, screen, invW, n);
+}
+
+void ProjectBatch(const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2f* screen, float* invW, size_t n)
+{
+    project(mvp, vp, in, screen, invW, n);
+}
+
+void ProjectBatch(const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2* screen, float* invW, size_t n)
+{
+    project(mvp, vp, in, screen, invW, n);
+}
+
+void ProjectBatch(const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2h* screen, float* invW, size_t n)
+{
+    project(mvp, vp, in, screen, invW, n);
+}
+
+//**********************************************************************
+//* Matrix products
+//**********************************************************************
+template<bool manyA, bool manyB>
+static void multiply(const Mat4* A, const Mat4* B, Mat4* C, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    // The arrays may be null when n == 0
+    const float* a = reinterpret_cast<const float*>(A);
+    const float* b = reinterpret_cast<const float*>(B);
+    float* c = reinterpret_cast<float*>(C);
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512: return multiply_avx512<manyA, manyB>(a, b, c, n);
+    case SimdLevel::AVX2:   return multiply_avx2<manyA, manyB>(a, b, c, n);
+    case SimdLevel::SSE41:  return multiply_sse41<manyA, manyB>(a, b, c, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        C[i] = A[manyA ? i : 0] * B[manyB ? i : 0];
+}
+
+void MultiplyBatch(const Mat4* A, const Mat4* B, Mat4* C, size_t n)
+{
+    multiply<true, true>(A, B, C, n);
+}
+
+void MultiplyBatch(const Mat4& A, const Mat4* B, Mat4* C, size_t n)
+{
+    // Private copy, so the shared matrix may live in the output array
+    const Mat4 a = A;
+    multiply<false, true>(&a, B, C, n);
+}
+
+void MultiplyBatch(const Mat4* A, const Mat4& B, Mat4* C, size_t n)
+{
+    const Mat4 b = B;
+    multiply<true, false>(A, &b, C, n);
+}
+
+template<bool manyA, bool manyB>
+static void multiply(const Mat3x4* A, const Mat3x4* B, Mat3x4* C, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    // The arrays may be null when n == 0
+    const float* a = reinterpret_cast<const float*>(A);
+    const float* b = reinterpret_cast<const float*>(B);
+    float* c = reinterpret_cast<float*>(C);
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return multiplyAffine_avx2<manyA, manyB>(a, b, c, n);
+    case SimdLevel::SSE41: return multiplyAffine_sse41<manyA, manyB>(a, b, c, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        C[i] = A[manyA ? i : 0] * B[manyB ? i : 0];
+}
+
+void MultiplyBatch(const Mat3x4* A, const Mat3x4* B, Mat3x4* C, size_t n)
+{
+    multiply<true, true>(A, B, C, n);
+}
+
+void MultiplyBatch(const Mat3x4& A, const Mat3x4* B, Mat3x4* C, size_t n)
+{
+    const Mat3x4 a = A;
+    multiply<false, true>(&a, B, C, n);
+}
+
+void MultiplyBatch(const Mat3x4* A, const Mat3x4& B, Mat3x4* C, size_t n)
+{
+    const Mat3x4 b = B;
+    multiply<true, false>(A, &b, C, n);
+}
+
+void TransformPointBatch(const Mat3x4& m, const Vec3f* in, Vec3f* out, size_t n)
+{
+    TransformPointBatch(m.ToMat4(), in, out, n);
+}
+
+void TransformDirectionBatch(const Mat3x4& m, const Vec3f* in, Vec3f* out, size_t n)
+{
+    TransformDirectionBatch(m.ToMat4(), in, out, n);
+}
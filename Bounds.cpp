@@ -0,0 +1,1078 @@
+/**
+ * @file: Bounds.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "Bounds.h"
+#include "SimdUtil.h"
+#include <vector>
+
+static_assert(sizeof(Vec3f) == 3*sizeof(float), "Vec3f must be tightly packed");
+
+// Points per chunk. The chunks and the order their results are combined in
+// only depend on n, never on the number of threads.
+static constexpr size_t ReduceChunk = 16384;
+
+// Farthest point passes before the sphere growth falls back to one
+// incremental pass over every point
+static constexpr int MaxGrowPasses = 16;
+
+// EPOS-14 directions: 3 axes and 4 diagonals
+static constexpr int EposDirections = 7;
+
+/** @brief Point with the largest squared distance, lowest index on ties. */
+struct Farthest
+{
+    float dist2;
+    size_t index;
+};
+
+/** @brief Lowest and highest projection on each direction, lowest index on ties. */
+struct Extremes
+{
+    float lo[EposDirections];
+    float hi[EposDirections];
+    size_t loIndex[EposDirections];
+    size_t hiIndex[EposDirections];
+};
+
+//**********************************************************************
+//* Scalar helpers, also used for the kernel tails
+//**********************************************************************
+static inline float distance2(const Vec3f& p, const Vec3f& c)
+{
+    const float dx = p.x - c.x;
+    const float dy = p.y - c.y;
+    const float dz = p.z - c.z;
+    return dx*dx + dy*dy + dz*dz;
+}
+
+// Projections on the EPOS directions. The kernels use the same operations.
+static inline void project7(const Vec3f& p, float* d)
+{
+    const float xy = p.x + p.y;
+    const float xmy = p.x - p.y;
+    d[0] = p.x;
+    d[1] = p.y;
+    d[2] = p.z;
+    d[3] = xy + p.z;
+    d[4] = xy - p.z;
+    d[5] = xmy + p.z;
+    d[6] = xmy - p.z;
+}
+
+static inline void keep(Farthest& a, float dist2, size_t index)
+{
+    if (dist2 > a.dist2 || (dist2 == a.dist2 && index < a.index))
+        a = {dist2, index};
+}
+
+static inline void keepLo(Extremes& e, int d, float v, size_t index)
+{
+    if (v < e.lo[d] || (v == e.lo[d] && index < e.loIndex[d]))
+    {
+        e.lo[d] = v;
+        e.loIndex[d] = index;
+    }
+}
+
+static inline void keepHi(Extremes& e, int d, float v, size_t index)
+{
+    if (v > e.hi[d] || (v == e.hi[d] && index < e.hiIndex[d]))
+    {
+        e.hi[d] = v;
+        e.hiIndex[d] = index;
+    }
+}
+
+static Extremes noExtremes()
+{
+    Extremes e;
+    for (int d = 0; d < EposDirections; d++)
+    {
+        e.lo[d] = std::numeric_limits<float>::infinity();
+        e.hi[d] = -std::numeric_limits<float>::infinity();
+        e.loIndex[d] = SIZE_MAX;
+        e.hiIndex[d] = SIZE_MAX;
+    }
+    return e;
+}
+
+static void combine(Extremes& a, const Extremes& b)
+{
+    for (int d = 0; d < EposDirections; d++)
+    {
+        keepLo(a, d, b.lo[d], b.loIndex[d]);
+        keepHi(a, d, b.hi[d], b.hiIndex[d]);
+    }
+}
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* SSE4.1 kernels
+//**********************************************************************
+// Min/max and sums work on the packed floats directly: lane j of the k-th
+// register of a block always holds component (4k + j) % 3 of some point, so
+// the components are only separated once at the end. Distances and
+// projections deinterleave 4 points per block. Tails use the scalar code.
+
+VECTOR_TARGET_SSE41 static AABB3 bounds_sse41(const Vec3f* in, size_t n)
+{
+    AABB3 box = AABB3::Empty();
+    size_t i = 0;
+    if (n >= 4)
+    {
+        const float* src = reinterpret_cast<const float*>(in);
+        __m128 lo[3], hi[3];
+        for (int k = 0; k < 3; k++)
+            lo[k] = hi[k] = _mm_loadu_ps(src + 4*k);
+
+        for (i = 4, src += 12; i + 4 <= n; i += 4, src += 12)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                const __m128 v = _mm_loadu_ps(src + 4*k);
+                lo[k] = _mm_min_ps(lo[k], v);
+                hi[k] = _mm_max_ps(hi[k], v);
+            }
+        }
+
+        alignas(16) float l[12], h[12];
+        for (int k = 0; k < 3; k++)
+        {
+            _mm_store_ps(l + 4*k, lo[k]);
+            _mm_store_ps(h + 4*k, hi[k]);
+        }
+        for (int j = 0; j < 12; j++)
+        {
+            box.min[j % 3] = l[j] < box.min[j % 3] ? l[j] : box.min[j % 3];
+            box.max[j % 3] = h[j] > box.max[j % 3] ? h[j] : box.max[j % 3];
+        }
+    }
+    for (; i < n; i++)
+        box.Expand(in[i]);
+    return box;
+}
+
+VECTOR_TARGET_SSE41 static void sum_sse41(const Vec3f* in, size_t n, double* sum)
+{
+    size_t i = 0;
+    if (n >= 4)
+    {
+        const float* src = reinterpret_cast<const float*>(in);
+        __m128d acc[6];
+        for (int k = 0; k < 6; k++)
+            acc[k] = _mm_setzero_pd();
+
+        for (; i + 4 <= n; i += 4, src += 12)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                const __m128 v = _mm_loadu_ps(src + 4*k);
+                acc[2*k] = _mm_add_pd(acc[2*k], _mm_cvtps_pd(v));
+                acc[2*k + 1] = _mm_add_pd(acc[2*k + 1], _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+            }
+        }
+
+        alignas(16) double s[12];
+        for (int k = 0; k < 6; k++)
+            _mm_store_pd(s + 2*k, acc[k]);
+        for (int j = 0; j < 12; j++)
+            sum[j % 3] += s[j];
+    }
+    for (; i < n; i++)
+    {
+        sum[0] += in[i].x;
+        sum[1] += in[i].y;
+        sum[2] += in[i].z;
+    }
+}
+
+VECTOR_TARGET_SSE41 static Farthest farthest_sse41(const Vec3f* in, size_t n, const Vec3f& c)
+{
+    Farthest best = {-1.0f, 0};
+    size_t i = 0;
+    if (n >= 4)
+    {
+        const float* src = reinterpret_cast<const float*>(in);
+        const __m128 cx = _mm_set1_ps(c.x);
+        const __m128 cy = _mm_set1_ps(c.y);
+        const __m128 cz = _mm_set1_ps(c.z);
+        __m128 bestD = _mm_set1_ps(-1.0f);
+        __m128i bestI = _mm_setzero_si128();
+        __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+
+        for (; i + 4 <= n; i += 4, src += 12)
+        {
+            __m128 x, y, z;
+            deinterleave3_sse41(src, x, y, z);
+            const __m128 dx = _mm_sub_ps(x, cx);
+            const __m128 dy = _mm_sub_ps(y, cy);
+            const __m128 dz = _mm_sub_ps(z, cz);
+            const __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+            const __m128 gt = _mm_cmpgt_ps(d2, bestD);
+            bestD = _mm_blendv_ps(bestD, d2, gt);
+            bestI = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(bestI), _mm_castsi128_ps(index), gt));
+            index = _mm_add_epi32(index, _mm_set1_epi32(4));
+        }
+
+        alignas(16) float d[4];
+        alignas(16) int32_t idx[4];
+        _mm_store_ps(d, bestD);
+        _mm_store_si128(reinterpret_cast<__m128i*>(idx), bestI);
+        for (int j = 0; j < 4; j++)
+            keep(best, d[j], idx[j]);
+    }
+    for (; i < n; i++)
+        keep(best, distance2(in[i], c), i);
+    return best;
+}
+
+VECTOR_TARGET_SSE41 static Extremes extremes_sse41(const Vec3f* in, size_t n)
+{
+    Extremes e = noExtremes();
+    size_t i = 0;
+    if (n >= 4)
+    {
+        const float* src = reinterpret_cast<const float*>(in);
+        __m128 lo[EposDirections], hi[EposDirections];
+        __m128i loI[EposDirections], hiI[EposDirections];
+        for (int d = 0; d < EposDirections; d++)
+        {
+            lo[d] = _mm_set1_ps(std::numeric_limits<float>::infinity());
+            hi[d] = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+            loI[d] = hiI[d] = _mm_setzero_si128();
+        }
+        __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+
+        for (; i + 4 <= n; i += 4, src += 12)
+        {
+            __m128 p[EposDirections];
+            deinterleave3_sse41(src, p[0], p[1], p[2]);
+            const __m128 xy = _mm_add_ps(p[0], p[1]);
+            const __m128 xmy = _mm_sub_ps(p[0], p[1]);
+            p[3] = _mm_add_ps(xy, p[2]);
+            p[4] = _mm_sub_ps(xy, p[2]);
+            p[5] = _mm_add_ps(xmy, p[2]);
+            p[6] = _mm_sub_ps(xmy, p[2]);
+
+            const __m128 fi = _mm_castsi128_ps(index);
+            for (int d = 0; d < EposDirections; d++)
+            {
+                const __m128 lt = _mm_cmplt_ps(p[d], lo[d]);
+                const __m128 gt = _mm_cmpgt_ps(p[d], hi[d]);
+                lo[d] = _mm_blendv_ps(lo[d], p[d], lt);
+                hi[d] = _mm_blendv_ps(hi[d], p[d], gt);
+                loI[d] = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(loI[d]), fi, lt));
+                hiI[d] = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(hiI[d]), fi, gt));
+            }
+            index = _mm_add_epi32(index, _mm_set1_epi32(4));
+        }
+
+        for (int d = 0; d < EposDirections; d++)
+        {
+            alignas(16) float l[4], h[4];
+            alignas(16) int32_t li[4], hj[4];
+            _mm_store_ps(l, lo[d]);
+            _mm_store_ps(h, hi[d]);
+            _mm_store_si128(reinterpret_cast<__m128i*>(li), loI[d]);
+            _mm_store_si128(reinterpret_cast<__m128i*>(hj), hiI[d]);
+            for (int j = 0; j < 4; j++)
+            {
+                keepLo(e, d, l[j], li[j]);
+                keepHi(e, d, h[j], hj[j]);
+            }
+        }
+    }
+    for (; i < n; i++)
+    {
+        float p[EposDirections];
+        project7(in[i], p);
+        for (int d = 0; d < EposDirections; d++)
+        {
+            keepLo(e, d, p[d], i);
+            keepHi(e, d, p[d], i);
+        }
+    }
+    return e;
+}
+
+//**********************************************************************
+//* AVX2 kernels
+//**********************************************************************
+// Same as SSE4.1 with 8 points (24 floats) per block. Sums convert each
+// 128 bit half to 4 doubles. No FMA, so distances and projections match
+// the scalar code bit for bit.
+
+VECTOR_TARGET_AVX2 static AABB3 bounds_avx2(const Vec3f* in, size_t n)
+{
+    AABB3 box = AABB3::Empty();
+    size_t i = 0;
+    if (n >= 8)
+    {
+        const float* src = reinterpret_cast<const float*>(in);
+        __m256 lo[3], hi[3];
+        for (int k = 0; k < 3; k++)
+            lo[k] = hi[k] = _mm256_loadu_ps(src + 8*k);
+
+        for (i = 8, src += 24; i + 8 <= n; i += 8, src += 24)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                const __m256 v = _mm256_loadu_ps(src + 8*k);
+                lo[k] = _mm256_min_ps(lo[k], v);
+                hi[k] = _mm256_max_ps(hi[k], v);
+            }
+        }
+
+        alignas(32) float l[24], h[24];
+        for (int k = 0; k < 3; k++)
+        {
+            _mm256_store_ps(l + 8*k, lo[k]);
+            _mm256_store_ps(h + 8*k, hi[k]);
+        }
+        for (int j = 0; j < 24; j++)
+        {
+            box.min[j % 3] = l[j] < box.min[j % 3] ? l[j] : box.min[j % 3];
+            box.max[j % 3] = h[j] > box.max[j % 3] ? h[j] : box.max[j % 3];
+        }
+    }
+    for (; i < n; i++)
+        box.Expand(in[i]);
+    return box;
+}
+
+VECTOR_TARGET_AVX2 static void sum_avx2(const Vec3f* in, size_t n, double* sum)
+{
+    size_t i = 0;
+    if (n >= 8)
+    {
+        const float* src = reinterpret_cast<const float*>(in);
+        __m256d acc[6];
+        for (int k = 0; k < 6; k++)
+            acc[k] = _mm256_setzero_pd();
+
+        for (; i + 8 <= n; i += 8, src += 24)
+        {
+            for (int k = 0; k < 6; k++)
+                acc[k] = _mm256_add_pd(acc[k], _mm256_cvtps_pd(_mm_loadu_ps(src + 4*k)));
+        }
+
+        alignas(32) double s[24];
+        for (int k = 0; k < 6; k++)
+            _mm256_store_pd(s + 4*k, acc[k]);
+        for (int j = 0; j < 24; j++)
+            sum[j % 3] += s[j];
+    }
+    for (; i < n; i++)
+    {
+        sum[0] += in[i].x;
+        sum[1] += in[i].y;
+        sum[2] += in[i].z;
+    }
+}
+
+VECTOR_TARGET_AVX2 static Farthest farthest_avx2(const Vec3f* in, size_t n, const Vec3f& c)
+{
+    Farthest best = {-1.0f, 0};
+    size_t i = 0;
+    if (n >= 8)
+    {
+        const float* src = reinterpret_cast<const float*>(in);
+        const __m256 cx = _mm256_set1_ps(c.x);
+        const __m256 cy = _mm256_set1_ps(c.y);
+        const __m256 cz = _mm256_set1_ps(c.z);
+        __m256 bestD = _mm256_set1_ps(-1.0f);
+        __m256i bestI = _mm256_setzero_si256();
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        for (; i + 8 <= n; i += 8, src += 24)
+        {
+            __m256 x, y, z;
+            deinterleave3_avx2(src, x, y, z);
+            const __m256 dx = _mm256_sub_ps(x, cx);
+            const __m256 dy = _mm256_sub_ps(y, cy);
+            const __m256 dz = _mm256_sub_ps(z, cz);
+            const __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                            _mm256_mul_ps(dz, dz));
+
+            const __m256 gt = _mm256_cmp_ps(d2, bestD, _CMP_GT_OQ);
+            bestD = _mm256_blendv_ps(bestD, d2, gt);
+            bestI = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestI), _mm256_castsi256_ps(index), gt));
+            index = _mm256_add_epi32(index, _mm256_set1_epi32(8));
+        }
+
+        alignas(32) float d[8];
+        alignas(32) int32_t idx[8];
+        _mm256_store_ps(d, bestD);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(idx), bestI);
+        for (int j = 0; j < 8; j++)
+            keep(best, d[j], idx[j]);
+    }
+    for (; i < n; i++)
+        keep(best, distance2(in[i], c), i);
+    return best;
+}
+
+VECTOR_TARGET_AVX2 static Extremes extremes_avx2(const Vec3f* in, size_t n)
+{
+    Extremes e = noExtremes();
+    size_t i = 0;
+    if (n >= 8)
+    {
+        const float* src = reinterpret_cast<const float*>(in);
+        __m256 lo[EposDirections], hi[EposDirections];
+        __m256i loI[EposDirections], hiI[EposDirections];
+        for (int d = 0; d < EposDirections; d++)
+        {
+            lo[d] = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+            hi[d] = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+            loI[d] = hiI[d] = _mm256_setzero_si256();
+        }
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        for (; i + 8 <= n; i += 8, src += 24)
+        {
+            __m256 p[EposDirections];
+            deinterleave3_avx2(src, p[0], p[1], p[2]);
+            const __m256 xy = _mm256_add_ps(p[0], p[1]);
+            const __m256 xmy = _mm256_sub_ps(p[0], p[1]);
+            p[3] = _mm256_add_ps(xy, p[2]);
+            p[4] = _mm256_sub_ps(xy, p[2]);
+            p[5] = _mm256_add_ps(xmy, p[2]);
+            p[6] = _mm256_sub_ps(xmy, p[2]);
+
+            const __m256 fi = _mm256_castsi256_ps(index);
+            for (int d = 0; d < EposDirections; d++)
+            {
+                const __m256 lt = _mm256_cmp_ps(p[d], lo[d], _CMP_LT_OQ);
+                const __m256 gt = _mm256_cmp_ps(p[d], hi[d], _CMP_GT_OQ);
+                lo[d] = _mm256_blendv_ps(lo[d], p[d], lt);
+                hi[d] = _mm256_blendv_ps(hi[d], p[d], gt);
+                loI[d] = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(loI[d]), fi, lt));
+                hiI[d] = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(hiI[d]), fi, gt));
+            }
+            index = _mm256_add_epi32(index, _mm256_set1_epi32(8));
+        }
+
+        for (int d = 0; d < EposDirections; d++)
+        {
+            alignas(32) float l[8], h[8];
+            alignas(32) int32_t li[8], hj[8];
+            _mm256_store_ps(l, lo[d]);
+            _mm256_store_ps(h, hi[d]);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(li), loI[d]);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(hj), hiI[d]);
+            for (int j = 0; j < 8; j++)
+            {
+                keepLo(e, d, l[j], li[j]);
+                keepHi(e, d, h[j], hj[j]);
+            }
+        }
+    }
+    for (; i < n; i++)
+    {
+        float p[EposDirections];
+        project7(in[i], p);
+        for (int d = 0; d < EposDirections; d++)
+        {
+            keepLo(e, d, p[d], i);
+            keepHi(e, d, p[d], i);
+        }
+    }
+    return e;
+}
+
+//**********************************************************************
+//* Box and sphere transform kernels
+//**********************************************************************
+// One box or sphere per SSE register, two per AVX2 register with the matrix
+// rows in both lanes. A box is loaded as min.xyz + max.x and min.z + max.xyz
+// so no load or store crosses the end of the array.
+
+static_assert(sizeof(AABB3) == 6*sizeof(float), "AABB3 must be tightly packed");
+static_assert(sizeof(BoundingSphere) == 4*sizeof(float), "BoundingSphere must be tightly packed");
+
+VECTOR_TARGET_SSE41 static inline __m128 absRow_sse41(const float* row)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_load_ps(row));
+}
+
+VECTOR_TARGET_SSE41 static inline __m128 point_sse41(__m128 v, __m128 r0, __m128 r1, __m128 r2, __m128 r3)
+{
+    const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(v, v, 0x00), r0), _mm_mul_ps(_mm_shuffle_ps(v, v, 0x55), r1));
+    const __m128 zw = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(v, v, 0xAA), r2), r3);
+    return _mm_add_ps(xy, zw);
+}
+
+template<bool many>
+VECTOR_TARGET_SSE41 static void transformAABB_sse41(const Mat4* m, const AABB3* in, AABB3* out, size_t n)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128 r0 = _mm_load_ps(m->data[0]), r1 = _mm_load_ps(m->data[1]);
+    __m128 r2 = _mm_load_ps(m->data[2]), r3 = _mm_load_ps(m->data[3]);
+    __m128 a0 = absRow_sse41(m->data[0]), a1 = absRow_sse41(m->data[1]), a2 = absRow_sse41(m->data[2]);
+
+    const float* src = reinterpret_cast<const float*>(in);
+    float* dst = reinterpret_cast<float*>(out);
+    for (size_t i = 0; i < n; i++, src += 6, dst += 6)
+    {
+        if (many)
+        {
+            r0 = _mm_load_ps(m[i].data[0]);
+            r1 = _mm_load_ps(m[i].data[1]);
+            r2 = _mm_load_ps(m[i].data[2]);
+            r3 = _mm_load_ps(m[i].data[3]);
+            a0 = absRow_sse41(m[i].data[0]);
+            a1 = absRow_sse41(m[i].data[1]);
+            a2 = absRow_sse41(m[i].data[2]);
+        }
+
+        const __m128 lo = _mm_loadu_ps(src);
+        const __m128 zhi = _mm_loadu_ps(src + 2);
+        const __m128 hi = _mm_shuffle_ps(zhi, zhi, _MM_SHUFFLE(3, 3, 2, 1));
+        const __m128 c = _mm_mul_ps(_mm_add_ps(lo, hi), half);
+        const __m128 e = _mm_mul_ps(_mm_sub_ps(hi, lo), half);
+
+        const __m128 tc = point_sse41(c, r0, r1, r2, r3);
+        const __m128 exy = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(e, e, 0x00), a0), _mm_mul_ps(_mm_shuffle_ps(e, e, 0x55), a1));
+        const __m128 te = _mm_add_ps(exy, _mm_mul_ps(_mm_shuffle_ps(e, e, 0xAA), a2));
+
+        const __m128 rlo = _mm_sub_ps(tc, te);
+        const __m128 rhi = _mm_add_ps(tc, te);
+        const __m128 first = _mm_blend_ps(rlo, _mm_shuffle_ps(rhi, rhi, 0x00), 0x8); // lo.xyz hi.x
+        _mm_storeu_ps(dst, first);
+        _mm_storel_pi(reinterpret_cast<__m64*>(dst + 4), _mm_shuffle_ps(rhi, rhi, _MM_SHUFFLE(3, 3, 2, 1)));
+    }
+}
+
+template<bool many>
+VECTOR_TARGET_SSE41 static void transformSphere_sse41(const Mat4* m, const BoundingSphere* in, BoundingSphere* out, size_t n)
+{
+    __m128 r0 = _mm_load_ps(m->data[0]), r1 = _mm_load_ps(m->data[1]);
+    __m128 r2 = _mm_load_ps(m->data[2]), r3 = _mm_load_ps(m->data[3]);
+    __m128 scale = _mm_set1_ps(MaxStretch(*m));
+
+    const float* src = reinterpret_cast<const float*>(in);
+    float* dst = reinterpret_cast<float*>(out);
+    for (size_t i = 0; i < n; i++, src += 4, dst += 4)
+    {
+        if (many)
+        {
+            r0 = _mm_load_ps(m[i].data[0]);
+            r1 = _mm_load_ps(m[i].data[1]);
+            r2 = _mm_load_ps(m[i].data[2]);
+            r3 = _mm_load_ps(m[i].data[3]);
+            scale = _mm_set1_ps(MaxStretch(m[i]));
+        }
+
+        const __m128 v = _mm_loadu_ps(src);
+        const __m128 radius = _mm_mul_ps(_mm_shuffle_ps(v, v, 0xFF), scale);
+        _mm_storeu_ps(dst, _mm_blend_ps(point_sse41(v, r0, r1, r2, r3), radius, 0x8));
+    }
+}
+
+VECTOR_TARGET_AVX2 static inline __m256 rows_avx2(const Mat4* m, size_t i, int row)
+{
+    return load2x128_avx2(m[i].data[row], m[i + 1].data[row]);
+}
+
+VECTOR_TARGET_AVX2 static inline __m256 point_avx2(__m256 v, __m256 r0, __m256 r1, __m256 r2, __m256 r3)
+{
+    const __m256 xy = _mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(v, 0x00), r0), _mm256_mul_ps(_mm256_permute_ps(v, 0x55), r1));
+    const __m256 zw = _mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(v, 0xAA), r2), r3);
+    return _mm256_add_ps(xy, zw);
+}
+
+template<bool many>
+VECTOR_TARGET_AVX2 static void transformAABB_avx2(const Mat4* m, const AABB3* in, AABB3* out, size_t n)
+{
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 r[4], a[3];
+    for (int k = 0; k < 4; k++)
+        r[k] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m->data[k]));
+
+    const float* src = reinterpret_cast<const float*>(in);
+    float* dst = reinterpret_cast<float*>(out);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2, src += 12, dst += 12)
+    {
+        if (many)
+            for (int k = 0; k < 4; k++)
+                r[k] = rows_avx2(m, i, k);
+        for (int k = 0; k < 3; k++)
+            a[k] = _mm256_andnot_ps(sign, r[k]);
+
+        const __m256 lo = load2x128_avx2(src, src + 6);
+        const __m256 zhi = load2x128_avx2(src + 2, src + 8);
+        const __m256 hi = _mm256_permute_ps(zhi, _MM_SHUFFLE(3, 3, 2, 1));
+        const __m256 c = _mm256_mul_ps(_mm256_add_ps(lo, hi), half);
+        const __m256 e = _mm256_mul_ps(_mm256_sub_ps(hi, lo), half);
+
+        const __m256 tc = point_avx2(c, r[0], r[1], r[2], r[3]);
+        const __m256 exy = _mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(e, 0x00), a[0]),
+                                         _mm256_mul_ps(_mm256_permute_ps(e, 0x55), a[1]));
+        const __m256 te = _mm256_add_ps(exy, _mm256_mul_ps(_mm256_permute_ps(e, 0xAA), a[2]));
+
+        const __m256 rlo = _mm256_sub_ps(tc, te);
+        const __m256 rhi = _mm256_add_ps(tc, te);
+        store2x128_avx2(dst, dst + 6, _mm256_blend_ps(rlo, _mm256_permute_ps(rhi, 0x00), 0x88));
+        const __m256 yz = _mm256_permute_ps(rhi, _MM_SHUFFLE(3, 3, 2, 1));
+        _mm_storel_pi(reinterpret_cast<__m64*>(dst + 4), _mm256_castps256_ps128(yz));
+        _mm_storel_pi(reinterpret_cast<__m64*>(dst + 10), _mm256_extractf128_ps(yz, 1));
+    }
+
+    if (i < n)
+        transformAABB_sse41<many>(many ? m + i : m, in + i, out + i, n - i);
+}
+
+template<bool many>
+VECTOR_TARGET_AVX2 static void transformSphere_avx2(const Mat4* m, const BoundingSphere* in, BoundingSphere* out, size_t n)
+{
+    __m256 r[4];
+    for (int k = 0; k < 4; k++)
+        r[k] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m->data[k]));
+    __m256 scale = _mm256_set1_ps(MaxStretch(*m));
+
+    const float* src = reinterpret_cast<const float*>(in);
+    float* dst = reinterpret_cast<float*>(out);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2, src += 8, dst += 8)
+    {
+        if (many)
+        {
+            for (int k = 0; k < 4; k++)
+                r[k] = rows_avx2(m, i, k);
+            scale = _mm256_set_m128(_mm_set1_ps(MaxStretch(m[i + 1])), _mm_set1_ps(MaxStretch(m[i])));
+        }
+
+        const __m256 v = _mm256_loadu_ps(src);
+        const __m256 radius = _mm256_mul_ps(_mm256_permute_ps(v, 0xFF), scale);
+        _mm256_storeu_ps(dst, _mm256_blend_ps(point_avx2(v, r[0], r[1], r[2], r[3]), radius, 0x88));
+    }
+
+    if (i < n)
+        transformSphere_sse41<many>(many ? m + i : m, in + i, out + i, n - i);
+}
+
+#endif // VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Dispatch, one chunk at a time
+//**********************************************************************
+static AABB3 boundsChunk(const Vec3f* in, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return bounds_avx2(in, n);
+    case SimdLevel::SSE41: return bounds_sse41(in, n);
+    default: break;
+    }
+#endif
+    AABB3 box = AABB3::Empty();
+    for (size_t i = 0; i < n; i++)
+        box.Expand(in[i]);
+    return box;
+}
+
+struct Sum
+{
+    double v[3];
+};
+
+static Sum sumChunk(const Vec3f* in, size_t n)
+{
+    Sum s = {{0.0, 0.0, 0.0}};
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  sum_avx2(in, n, s.v); return s;
+    case SimdLevel::SSE41: sum_sse41(in, n, s.v); return s;
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+    {
+        s.v[0] += in[i].x;
+        s.v[1] += in[i].y;
+        s.v[2] += in[i].z;
+    }
+    return s;
+}
+
+// Indices are relative to in
+static Farthest farthestChunk(const Vec3f* in, size_t n, const Vec3f& c)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return farthest_avx2(in, n, c);
+    case SimdLevel::SSE41: return farthest_sse41(in, n, c);
+    default: break;
+    }
+#endif
+    Farthest best = {-1.0f, 0};
+    for (size_t i = 0; i < n; i++)
+        keep(best, distance2(in[i], c), i);
+    return best;
+}
+
+// Indices are relative to in
+static Extremes extremesChunk(const Vec3f* in, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return extremes_avx2(in, n);
+    case SimdLevel::SSE41: return extremes_sse41(in, n);
+    default: break;
+    }
+#endif
+    Extremes e = noExtremes();
+    for (size_t i = 0; i < n; i++)
+    {
+        float p[EposDirections];
+        project7(in[i], p);
+        for (int d = 0; d < EposDirections; d++)
+        {
+            keepLo(e, d, p[d], i);
+            keepHi(e, d, p[d], i);
+        }
+    }
+    return e;
+}
+
+/**
+ * @brief Run kernel(begin, end) on every chunk of [0, n), serially or on the
+ *        pool, and fold the results in chunk order
+ *
+ * @param pool    Pool to use, nullptr to run on the calling thread
+ * @param result  Initial value, receives the folded result
+ * @param kernel  T kernel(size_t begin, size_t end)
+ * @param fold    void fold(T& result, const T& chunkResult)
+ */
+template<class T, class Kernel, class Fold>
+static void reduce(ThreadPool* pool, size_t n, T& result, Kernel kernel, Fold fold)
+{
+    if (pool == nullptr || pool->Size() == 1 || n <= ReduceChunk)
+    {
+        for (size_t begin = 0; begin < n; begin += ReduceChunk)
+            fold(result, kernel(begin, n - begin > ReduceChunk ? begin + ReduceChunk : n));
+        return;
+    }
+
+    std::vector<T> partial((n + ReduceChunk - 1) / ReduceChunk);
+    pool->ParallelFor(n, ReduceChunk, [&](size_t begin, size_t end) {
+        partial[begin / ReduceChunk] = kernel(begin, end);
+    });
+    for (const T& p : partial)
+        fold(result, p);
+}
+
+//**********************************************************************
+//* Shared implementations, pool may be nullptr
+//**********************************************************************
+static AABB3 bounds(ThreadPool* pool, const Vec3f* points, size_t n)
+{
+    AABB3 box = AABB3::Empty();
+    reduce(pool, n, box,
+           [points](size_t begin, size_t end) { return boundsChunk(points + begin, end - begin); },
+           [](AABB3& a, const AABB3& b) { a.Expand(b); });
+    return box;
+}
+
+static Vec3f centroid(ThreadPool* pool, const Vec3f* points, size_t n)
+{
+    assert(n > 0);
+    Sum s = {{0.0, 0.0, 0.0}};
+    reduce(pool, n, s,
+           [points](size_t begin, size_t end) { return sumChunk(points + begin, end - begin); },
+           [](Sum& a, const Sum& b) {
+               for (int k = 0; k < 3; k++)
+                   a.v[k] += b.v[k];
+           });
+    return Vec3f(static_cast<float>(s.v[0] / n), static_cast<float>(s.v[1] / n), static_cast<float>(s.v[2] / n));
+}
+
+static Farthest farthest(ThreadPool* pool, const Vec3f* points, size_t n, const Vec3f& c)
+{
+    Farthest best = {-1.0f, 0};
+    reduce(pool, n, best,
+           [points, &c](size_t begin, size_t end) {
+               Farthest f = farthestChunk(points + begin, end - begin, c);
+               f.index += begin;
+               return f;
+           },
+           [](Farthest& a, const Farthest& b) { keep(a, b.dist2, b.index); });
+    return best;
+}
+
+/**
+ * @brief Grow s until it contains every point. Each pass expands it towards
+ *        the farthest point outside, which usually settles in one or two
+ *        passes. Slow cases finish with Ritter's incremental pass.
+ */
+static BoundingSphere grow(ThreadPool* pool, const Vec3f* points, size_t n, BoundingSphere s)
+{
+    for (int pass = 0; pass < MaxGrowPasses; pass++)
+    {
+        const Farthest f = farthest(pool, points, n, s.center);
+        if (f.dist2 <= s.radius * s.radius)
+            return s;
+        s.Expand(points[f.index]);
+    }
+
+    for (size_t i = 0; i < n; i++)
+        s.Expand(points[i]);
+    return s;
+}
+
+static BoundingSphere ritter(ThreadPool* pool, const Vec3f* points, size_t n)
+{
+    assert(n > 0);
+    const size_t a = farthest(pool, points, n, points[0]).index;
+    const size_t b = farthest(pool, points, n, points[a]).index;
+
+    BoundingSphere s(points[a], 0.0f);
+    s.Expand(points[b]);
+    return grow(pool, points, n, s);
+}
+
+typedef Vector3<double> Vec3d;
+
+static inline double dot(const Vec3d& a, const Vec3d& b)
+{
+    return a.x*b.x + a.y*b.y + a.z*b.z;
+}
+
+/**
+ * @brief Minimum sphere of a few points. Tries every sphere through 2, 3 or 4
+ *        of them, in double precision, and keeps the smallest one that
+ *        contains all of them. Only meant for the 14 EPOS points.
+ */
+static BoundingSphere minimumSphere(const Vec3f* pts, int count)
+{
+    Vec3d p[2 * EposDirections];
+    assert(count <= 2 * EposDirections);
+    for (int i = 0; i < count; i++)
+        p[i] = Vec3d(pts[i]);
+
+    Vec3d bestCenter = p[0];
+    double bestR2 = std::numeric_limits<double>::infinity();
+
+    auto consider = [&](const Vec3d& c, double r2) {
+        if (r2 >= bestR2)
+            return;
+        const double limit = r2 * (1.0 + 1e-9);
+        for (int i = 0; i < count; i++)
+            if (dot(p[i] - c, p[i] - c) > limit)
+                return;
+        bestCenter = c;
+        bestR2 = r2;
+    };
+
+    if (count == 1)
+        bestR2 = 0.0;
+
+    for (int i = 0; i < count; i++)
+    for (int j = i + 1; j < count; j++)
+    {
+        const Vec3d ab = p[j] - p[i];
+        consider((p[i] + p[j]) * 0.5, dot(ab, ab) * 0.25);
+
+        for (int k = j + 1; k < count; k++)
+        {
+            // Circumcenter of the triangle
+            const Vec3d ac = p[k] - p[i];
+            const Vec3d nrm = CrossProduct(ab, ac);
+            const double n2 = dot(nrm, nrm);
+            if (n2 <= 1e-24 * dot(ab, ab) * dot(ac, ac))
+                continue;
+            const Vec3d o = (CrossProduct(nrm, ab) * dot(ac, ac) + CrossProduct(ac, nrm) * dot(ab, ab)) / (2.0 * n2);
+            consider(p[i] + o, dot(o, o));
+
+            for (int l = k + 1; l < count; l++)
+            {
+                // Circumcenter of the tetrahedron
+                const Vec3d ad = p[l] - p[i];
+                const double det = 2.0 * dot(ab, CrossProduct(ac, ad));
+                if (std::fabs(det) <= 1e-12 * std::sqrt(dot(ab, ab) * dot(ac, ac) * dot(ad, ad)))
+                    continue;
+                const Vec3d t = (CrossProduct(ac, ad) * dot(ab, ab) + CrossProduct(ad, ab) * dot(ac, ac)
+                               + CrossProduct(ab, ac) * dot(ad, ad)) / det;
+                consider(p[i] + t, dot(t, t));
+            }
+        }
+    }
+
+    return BoundingSphere(Vec3f(bestCenter), static_cast<float>(std::sqrt(bestR2)));
+}
+
+static BoundingSphere epos(ThreadPool* pool, const Vec3f* points, size_t n)
+{
+    assert(n > 0);
+    Extremes e = noExtremes();
+    reduce(pool, n, e,
+           [points](size_t begin, size_t end) {
+               Extremes c = extremesChunk(points + begin, end - begin);
+               for (int d = 0; d < EposDirections; d++)
+               {
+                   c.loIndex[d] += begin;
+                   c.hiIndex[d] += begin;
+               }
+               return c;
+           },
+           [](Extremes& a, const Extremes& b) { combine(a, b); });
+
+    Vec3f ext[2 * EposDirections];
+    for (int d = 0; d < EposDirections; d++)
+    {
+        ext[2*d] = points[e.loIndex[d]];
+        ext[2*d + 1] = points[e.hiIndex[d]];
+    }
+    return grow(pool, points, n, minimumSphere(ext, 2 * EposDirections));
+}
+
+//**********************************************************************
+//* Public API, reductions
+//**********************************************************************
+AABB3 ComputeBounds(const Vec3f* points, size_t n)
+{
+    return bounds(nullptr, points, n);
+}
+
+AABB3 ComputeBounds(ThreadPool& pool, const Vec3f* points, size_t n)
+{
+    return bounds(&pool, points, n);
+}
+
+Vec3f ComputeCentroid(const Vec3f* points, size_t n)
+{
+    return centroid(nullptr, points, n);
+}
+
+Vec3f ComputeCentroid(ThreadPool& pool, const Vec3f* points, size_t n)
+{
+    return centroid(&pool, points, n);
+}
+
+BoundingSphere RitterSphere(const Vec3f* points, size_t n)
+{
+    return ritter(nullptr, points, n);
+}
+
+BoundingSphere RitterSphere(ThreadPool& pool, const Vec3f* points, size_t n)
+{
+    return ritter(&pool, points, n);
+}
+
+BoundingSphere EposSphere(const Vec3f* points, size_t n)
+{
+    return epos(nullptr, points, n);
+}
+
+BoundingSphere EposSphere(ThreadPool& pool, const Vec3f* points, size_t n)
+{
+    return epos(&pool, points, n);
+}
+
+//**********************************************************************
+//* Public API, transforms
+//**********************************************************************
+template<bool many>
+static void transformAABB(const Mat4* m, const AABB3* in, AABB3* out, size_t n)
+{
+    if (n == 0)
+        return;
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return transformAABB_avx2<many>(m, in, out, n);
+    case SimdLevel::SSE41: return transformAABB_sse41<many>(m, in, out, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        out[i] = TransformAABB(m[many ? i : 0], in[i]);
+}
+
+template<bool many>
+static void transformSphere(const Mat4* m, const BoundingSphere* in, BoundingSphere* out, size_t n)
+{
+    if (n == 0)
+        return;
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return transformSphere_avx2<many>(m, in, out, n);
+    case SimdLevel::SSE41: return transformSphere_sse41<many>(m, in, out, n);
+    default: break;
+    }
+#endif
+    if (many)
+    {
+        for (size_t i = 0; i < n; i++)
+            out[i] = TransformSphere(m[i], in[i]);
+        return;
+    }
+
+    const float scale = MaxStretch(*m);
+    for (size_t i = 0; i < n; i++)
+    {
+        const Vec3f c = in[i].center;
+        const float radius = in[i].radius * scale;
+        for (int j = 0; j < 3; j++)
+            out[i].center[j] = (c.x*m->data[0][j] + c.y*m->data[1][j]) + (c.z*m->data[2][j] + m->data[3][j]);
+        out[i].radius = radius;
+    }
+}
+
+void TransformAABB(const Mat4& m, const AABB3* in, AABB3* out, size_t n)
+{
+    transformAABB<false>(&m, in, out, n);
+}
+
+void TransformAABB(const Mat4* m, const AABB3* in, AABB3* out, size_t n)
+{
+    transformAABB<true>(m, in, out, n);
+}
+
+void TransformSphere(const Mat4& m, const BoundingSphere* in, BoundingSphere* out, size_t n)
+{
+    transformSphere<false>(&m, in, out, n);
+}
+
+void TransformSphere(const Mat4* m, const BoundingSphere* in, BoundingSphere* out, size_t n)
+{
+    transformSphere<true>(m, in, out, n);
+}
@@ -0,0 +1,735 @@
+/**
+ * @file: Bvh.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "Bvh.h"
+#include <math.h>
+#include <algorithm>
+
+static_assert(sizeof(Bvh::Node) == 32, "Bvh::Node must be 32 bytes");
+
+// Triangles per chunk of the parallel passes. Every pass folds exact
+// quantities (min, max, counts), so the result does not depend on chunking.
+static constexpr size_t BuildChunk = 4096;
+
+// Nodes with more triangles are split one at a time with parallel passes,
+// smaller ones are built as independent subtrees, one per thread
+static constexpr size_t SubtreeThreshold = 16384;
+
+// Cost of visiting an inner node relative to one triangle test
+static constexpr float TraversalCost = 1.0f;
+
+// Rays per chunk of the parallel batch query, a multiple of the packet size
+static constexpr size_t RayChunk = 64;
+
+/** @brief Triangle bounds and centroids, indexed by mesh triangle. */
+struct BuildInput
+{
+    std::vector<AABB3> boxes;
+    std::vector<Vec3f> centers;
+    std::vector<uint32_t> order;    // Mesh triangles, permuted into leaf order
+};
+
+/** @brief Bounds of a range of triangles and of their centroids. */
+struct RangeInfo
+{
+    AABB3 box;
+    AABB3 centers;
+};
+
+/** @brief Centroid bins of a range along the three axes. */
+struct BinSet
+{
+    AABB3 box[3][Bvh::Bins];
+    uint32_t count[3][Bvh::Bins];
+};
+
+/** @brief Subtree still to be built: triangles [first, last) below node. */
+struct BuildTask
+{
+    uint32_t node;
+    uint32_t first;
+    uint32_t last;
+    int depth;
+};
+
+//**********************************************************************
+//* Build passes
+//**********************************************************************
+/**
+ * @brief Reduce [first, last) in BuildChunk sized pieces, on pool if it is not nullptr
+ *
+ * @param kernel  T kernel(size_t begin, size_t end)
+ * @param fold    void fold(T& result, const T& chunkResult)
+ */
+template<class T, class Kernel, class Fold>
+static void reduce(ThreadPool* pool, size_t first, size_t last, T& result, Kernel kernel, Fold fold)
+{
+    const size_t n = last - first;
+    if (pool == nullptr || pool->Size() == 1 || n <= BuildChunk)
+    {
+        fold(result, kernel(first, last));
+        return;
+    }
+
+    std::vector<T> partial((n + BuildChunk - 1) / BuildChunk);
+    pool->ParallelFor(n, BuildChunk, [&](size_t begin, size_t end) {
+        partial[begin / BuildChunk] = kernel(first + begin, first + end);
+    });
+    for (const T& p : partial)
+        fold(result, p);
+}
+
+static RangeInfo rangeInfo(ThreadPool* pool, const BuildInput& in, size_t first, size_t last)
+{
+    RangeInfo info = {AABB3::Empty(), AABB3::Empty()};
+    reduce(pool, first, last, info,
+           [&in](size_t begin, size_t end) {
+               RangeInfo r = {AABB3::Empty(), AABB3::Empty()};
+               for (size_t i = begin; i < end; i++)
+               {
+                   r.box.Expand(in.boxes[in.order[i]]);
+                   r.centers.Expand(in.centers[in.order[i]]);
+               }
+               return r;
+           },
+           [](RangeInfo& a, const RangeInfo& b) {
+               a.box.Expand(b.box);
+               a.centers.Expand(b.centers);
+           });
+    return info;
+}
+
+/**
+ * @brief Bin mapping of one axis: bin = (c - origin) * scale, clamped
+ */
+struct Binning
+{
+    float origin[3];
+    float scale[3];     // 0 for axes where every centroid is equal
+
+    Binning(const AABB3& centers)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            const float extent = centers.max[k] - centers.min[k];
+            const float s = Bvh::Bins / extent;
+            origin[k] = centers.min[k];
+            scale[k] = extent > 0.0f && isfinite(s) ? s : 0.0f;
+        }
+    }
+
+    int Bin(const Vec3f& c, int axis) const
+    {
+        const int b = static_cast<int>((c[axis] - origin[axis]) * scale[axis]);
+        return b < Bvh::Bins - 1 ? b : Bvh::Bins - 1;
+    }
+};
+
+static void binRange(ThreadPool* pool, const BuildInput& in, size_t first, size_t last, const Binning& bin, BinSet& out)
+{
+    for (int k = 0; k < 3; k++)
+    {
+        for (int b = 0; b < Bvh::Bins; b++)
+        {
+            out.box[k][b] = AABB3::Empty();
+            out.count[k][b] = 0;
+        }
+    }
+    reduce(pool, first, last, out,
+           [&in, &bin](size_t begin, size_t end) {
+               BinSet s;
+               for (int k = 0; k < 3; k++)
+               {
+                   for (int b = 0; b < Bvh::Bins; b++)
+                   {
+                       s.box[k][b] = AABB3::Empty();
+                       s.count[k][b] = 0;
+                   }
+               }
+               for (size_t i = begin; i < end; i++)
+               {
+                   const uint32_t tri = in.order[i];
+                   for (int k = 0; k < 3; k++)
+                   {
+                       if (bin.scale[k] == 0.0f)
+                           continue;
+                       const int b = bin.Bin(in.centers[tri], k);
+                       s.box[k][b].Expand(in.boxes[tri]);
+                       s.count[k][b]++;
+                   }
+               }
+               return s;
+           },
+           [](BinSet& a, const BinSet& b) {
+               for (int k = 0; k < 3; k++)
+               {
+                   for (int i = 0; i < Bvh::Bins; i++)
+                   {
+                       a.box[k][i].Expand(b.box[k][i]);
+                       a.count[k][i] += b.count[k][i];
+                   }
+               }
+           });
+}
+
+/**
+ * @brief Set the bounds of node and choose how to split [first, last)
+ *
+ * @return uint32_t End of the first child's triangles, or first if the node
+ *         stays a leaf. order is partitioned accordingly
+ */
+static uint32_t splitNode(ThreadPool* pool, BuildInput& in, uint32_t first, uint32_t last, int depth, Bvh::Node& node)
+{
+    const RangeInfo info = rangeInfo(pool, in, first, last);
+    node.min = info.box.min;
+    node.max = info.box.max;
+
+    const uint32_t count = last - first;
+    if (count <= 1 || depth >= Bvh::MaxDepth)
+        return first;
+
+    const Binning binning(info.centers);
+    BinSet bins;
+    binRange(pool, in, first, last, binning, bins);
+
+    // Sweep every axis: cost of putting bins [0, b] on the left
+    float bestCost = INFINITY;
+    int bestAxis = -1;
+    int bestBin = 0;
+    for (int k = 0; k < 3; k++)
+    {
+        if (binning.scale[k] == 0.0f)
+            continue;
+
+        float rightArea[Bvh::Bins];
+        uint32_t rightCount[Bvh::Bins];
+        AABB3 box = AABB3::Empty();
+        uint32_t n = 0;
+        for (int b = Bvh::Bins - 1; b > 0; b--)
+        {
+            box.Expand(bins.box[k][b]);
+            n += bins.count[k][b];
+            rightArea[b] = box.SurfaceArea();
+            rightCount[b] = n;
+        }
+
+        box = AABB3::Empty();
+        n = 0;
+        for (int b = 0; b < Bvh::Bins - 1; b++)
+        {
+            box.Expand(bins.box[k][b]);
+            n += bins.count[k][b];
+            if (n == 0 || rightCount[b + 1] == 0)
+                continue;
+            const float cost = n * box.SurfaceArea() + rightCount[b + 1] * rightArea[b + 1];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = k;
+                bestBin = b;
+            }
+        }
+    }
+
+    if (bestAxis < 0)
+    {
+        // Every centroid is equal: keep a leaf or cut the range in half
+        return count <= Bvh::MaxLeafSize ? first : first + count / 2;
+    }
+
+    const float area = info.box.SurfaceArea();
+    if (count <= Bvh::MaxLeafSize && TraversalCost * area + bestCost >= count * area)
+        return first;
+
+    const uint32_t* begin = in.order.data();
+    uint32_t* mid = std::partition(in.order.data() + first, in.order.data() + last, [&](uint32_t tri) {
+        return binning.Bin(in.centers[tri], bestAxis) <= bestBin;
+    });
+    return static_cast<uint32_t>(mid - begin);
+}
+
+static void makeLeaf(Bvh::Node& node, uint32_t first, uint32_t last)
+{
+    node.first = first;
+    node.count = last - first;
+}
+
+/**
+ * @brief Build a subtree serially into out, with its root at out[0]
+ */
+static void buildSubtree(BuildInput& in, const BuildTask& task, std::vector<Bvh::Node>& out)
+{
+    struct Pending
+    {
+        uint32_t node;
+        uint32_t first;
+        uint32_t last;
+        int depth;
+    };
+
+    out.resize(1);
+    std::vector<Pending> stack = {{0, task.first, task.last, task.depth}};
+    while (!stack.empty())
+    {
+        const Pending p = stack.back();
+        stack.pop_back();
+
+        Bvh::Node node;
+        const uint32_t mid = splitNode(nullptr, in, p.first, p.last, p.depth, node);
+        if (mid == p.first)
+        {
+            makeLeaf(node, p.first, p.last);
+        }
+        else
+        {
+            node.first = static_cast<uint32_t>(out.size());
+            node.count = 0;
+            out.resize(out.size() + 2);
+            stack.push_back({node.first + 1, mid, p.last, p.depth + 1});
+            stack.push_back({node.first, p.first, mid, p.depth + 1});
+        }
+        out[p.node] = node;
+    }
+}
+
+//**********************************************************************
+//* Shared implementations, pool may be nullptr
+//**********************************************************************
+void Bvh::build(ThreadPool* pool, const Vec3f* vertices, const uint32_t* meshIndices, size_t triCount)
+{
+    assert(triCount < UINT32_MAX && "Bvh: too many triangles");
+    Clear();
+    if (triCount == 0)
+        return;
+
+    // Triangle bounds and centroids
+    BuildInput in;
+    in.boxes.resize(triCount);
+    in.centers.resize(triCount);
+    in.order.resize(triCount);
+    auto prepare = [&](size_t begin, size_t end) {
+        for (size_t tri = begin; tri < end; tri++)
+        {
+            AABB3 box = AABB3::Empty();
+            for (int k = 0; k < 3; k++)
+                box.Expand(vertices[meshIndices[3*tri + k]]);
+            in.boxes[tri] = box;
+            in.centers[tri] = box.Center();
+            in.order[tri] = static_cast<uint32_t>(tri);
+        }
+    };
+    if (pool)
+        pool->ParallelFor(triCount, BuildChunk, prepare);
+    else
+        prepare(0, triCount);
+
+    // Split the large nodes one at a time with parallel passes
+    std::vector<BuildTask> pending = {{0, 0, static_cast<uint32_t>(triCount), 0}};
+    std::vector<BuildTask> subtrees;
+    nodes.resize(1);
+    while (!pending.empty())
+    {
+        const BuildTask t = pending.back();
+        pending.pop_back();
+        if (t.last - t.first <= SubtreeThreshold)
+        {
+            subtrees.push_back(t);
+            continue;
+        }
+
+        Node node;
+        const uint32_t mid = splitNode(pool, in, t.first, t.last, t.depth, node);
+        if (mid == t.first)
+        {
+            makeLeaf(node, t.first, t.last);
+        }
+        else
+        {
+            node.first = static_cast<uint32_t>(nodes.size());
+            node.count = 0;
+            nodes.resize(nodes.size() + 2);
+            pending.push_back({node.first + 1, mid, t.last, t.depth + 1});
+            pending.push_back({node.first, t.first, mid, t.depth + 1});
+        }
+        nodes[t.node] = node;
+    }
+
+    // Build the small subtrees independently, then append them in task order
+    std::vector<std::vector<Node>> built(subtrees.size());
+    auto buildRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            buildSubtree(in, subtrees[i], built[i]);
+    };
+    if (pool && subtrees.size() > 1)
+        pool->ParallelFor(subtrees.size(), 1, buildRange);
+    else
+        buildRange(0, subtrees.size());
+
+    for (size_t i = 0; i < subtrees.size(); i++)
+    {
+        // Local node j > 0 lands at base + j
+        const std::vector<Node>& local = built[i];
+        const uint32_t base = static_cast<uint32_t>(nodes.size()) - 1;
+        for (size_t j = 0; j < local.size(); j++)
+        {
+            Node node = local[j];
+            if (!node.IsLeaf())
+                node.first += base;
+            if (j == 0)
+                nodes[subtrees[i].node] = node;
+            else
+                nodes.push_back(node);
+        }
+    }
+
+    // Reordered triangles
+    prims.swap(in.order);
+    indices.resize(3 * triCount);
+    for (size_t i = 0; i < triCount; i++)
+    {
+        for (int k = 0; k < 3; k++)
+            indices[3*i + k] = meshIndices[3*prims[i] + k];
+    }
+}
+
+AABB3 Bvh::leafBounds(const Node& leaf, const Vec3f* vertices) const
+{
+    AABB3 box = AABB3::Empty();
+    for (uint32_t i = 3 * leaf.first; i < 3 * (leaf.first + leaf.count); i++)
+        box.Expand(vertices[indices[i]]);
+    return box;
+}
+
+void Bvh::refit(ThreadPool* pool, const Vec3f* vertices)
+{
+    // Leaves first, in parallel, then every inner node after its children
+    // with one backward pass
+    if (pool && pool->Size() > 1 && nodes.size() > BuildChunk)
+    {
+        pool->ParallelFor(nodes.size(), BuildChunk, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                if (nodes[i].IsLeaf())
+                {
+                    const AABB3 box = leafBounds(nodes[i], vertices);
+                    nodes[i].min = box.min;
+                    nodes[i].max = box.max;
+                }
+            }
+        });
+    }
+    else
+    {
+        pool = nullptr;
+    }
+
+    for (size_t i = nodes.size(); i-- > 0;)
+    {
+        Node& node = nodes[i];
+        AABB3 box;
+        if (!node.IsLeaf())
+            box = Merge(nodes[node.first].Bounds(), nodes[node.first + 1].Bounds());
+        else if (!pool)
+            box = leafBounds(node, vertices);
+        else
+            continue;
+        node.min = box.min;
+        node.max = box.max;
+    }
+}
+
+void Bvh::intersect(ThreadPool* pool, const Ray* rays, RayHit* hits, size_t n, const Vec3f* vertices) const
+{
+    auto trace = [&](size_t begin, size_t end) {
+        RayPacket packet;
+        RayPacketHit packetHit;
+        for (size_t i = begin; i < end; i += RayPacket::Size)
+        {
+            const int count = end - i < RayPacket::Size ? static_cast<int>(end - i) : RayPacket::Size;
+            packet.Load(rays + i, count);
+            packetHit.Reset();
+            Intersect(packet, vertices, packetHit);
+            for (int k = 0; k < count; k++)
+                hits[i + k] = packetHit.Get(k);
+        }
+    };
+    if (pool && n > RayChunk)
+        pool->ParallelFor(n, RayChunk, trace);
+    else
+        trace(0, n);
+}
+
+//**********************************************************************
+//* Public API, build
+//**********************************************************************
+void Bvh::Build(const Vec3f* vertices, const uint32_t* indices, size_t triCount)
+{
+    build(nullptr, vertices, indices, triCount);
+}
+
+void Bvh::Build(ThreadPool& pool, const Vec3f* vertices, const uint32_t* indices, size_t triCount)
+{
+    build(&pool, vertices, indices, triCount);
+}
+
+void Bvh::Refit(const Vec3f* vertices)
+{
+    refit(nullptr, vertices);
+}
+
+void Bvh::Refit(ThreadPool& pool, const Vec3f* vertices)
+{
+    refit(&pool, vertices);
+}
+
+void Bvh::Clear()
+{
+    nodes.clear();
+    indices.clear();
+    prims.clear();
+}
+
+//**********************************************************************
+//* Public API, queries
+//**********************************************************************
+bool Bvh::Intersect(Ray& ray, const Vec3f* vertices, RayHit& hit) const
+{
+    if (nodes.empty())
+        return false;
+
+    struct Entry
+    {
+        uint32_t node;
+        float tNear;
+    };
+    Entry stack[MaxDepth];
+    int top = 0;
+
+    const Vec3f inv = ray.InverseDirection();
+    float tNear;
+    if (!IntersectAABB(ray, inv, nodes[0].Bounds(), tNear))
+        return false;
+
+    bool found = false;
+    uint32_t current = 0;
+    for (;;)
+    {
+        const Node& node = nodes[current];
+        if (node.IsLeaf())
+        {
+            found |= IntersectTriangles(ray, vertices, indices.data(), node.first, node.first + node.count, hit);
+        }
+        else
+        {
+            float t0, t1;
+            const bool hit0 = IntersectAABB(ray, inv, nodes[node.first].Bounds(), t0);
+            const bool hit1 = IntersectAABB(ray, inv, nodes[node.first + 1].Bounds(), t1);
+            if (hit0 && hit1)
+            {
+                // Nearer child first, the other one waits on the stack
+                const bool swap = t1 < t0;
+                assert(top < MaxDepth);
+                stack[top++] = {node.first + !swap, swap ? t0 : t1};
+                current = node.first + swap;
+                continue;
+            }
+            if (hit0 || hit1)
+            {
+                current = node.first + hit1;
+                continue;
+            }
+        }
+
+        // Next pending node that is not behind the closest hit yet
+        do
+        {
+            if (top == 0)
+            {
+                if (found)
+                    hit.prim = prims[hit.prim];
+                return found;
+            }
+            --top;
+        } while (stack[top].tNear > ray.tMax);
+        current = stack[top].node;
+    }
+}
+
+void Bvh::Intersect(RayPacket& rays, const Vec3f* vertices, RayPacketHit& hit) const
+{
+    if (nodes.empty() || IntersectAABB(rays, nodes[0].Bounds(), nullptr) == 0)
+        return;
+
+    float tMax[RayPacket::Size];
+    for (int i = 0; i < RayPacket::Size; i++)
+        tMax[i] = rays.tMax[i];
+
+    uint32_t stack[MaxDepth];
+    int top = 0;
+    uint32_t current = 0;
+    for (;;)
+    {
+        const Node& node = nodes[current];
+        if (node.IsLeaf())
+        {
+            IntersectTriangles(rays, vertices, indices.data(), node.first, node.first + node.count, hit);
+        }
+        else
+        {
+            float t0[RayPacket::Size], t1[RayPacket::Size];
+            const uint32_t mask0 = IntersectAABB(rays, nodes[node.first].Bounds(), t0);
+            const uint32_t mask1 = IntersectAABB(rays, nodes[node.first + 1].Bounds(), t1);
+            if (mask0 && mask1)
+            {
+                // Visit first the child with the nearest entry over its lanes
+                float near0 = INFINITY, near1 = INFINITY;
+                for (int i = 0; i < RayPacket::Size; i++)
+                {
+                    if (mask0 >> i & 1)
+                        near0 = std::min(near0, t0[i]);
+                    if (mask1 >> i & 1)
+                        near1 = std::min(near1, t1[i]);
+                }
+                const bool swap = near1 < near0;
+                assert(top < MaxDepth);
+                stack[top++] = node.first + !swap;
+                current = node.first + swap;
+                continue;
+            }
+            if (mask0 || mask1)
+            {
+                current = node.first + (mask1 != 0);
+                continue;
+            }
+        }
+
+        // Next pending node that some lane can still reach
+        do
+        {
+            if (top == 0)
+            {
+                for (int i = 0; i < RayPacket::Size; i++)
+                {
+                    if (rays.tMax[i] != tMax[i])
+                        hit.prim[i] = prims[hit.prim[i]];
+                }
+                return;
+            }
+            --top;
+        } while (IntersectAABB(rays, nodes[stack[top]].Bounds(), nullptr) == 0);
+        current = stack[top];
+    }
+}
+
+void Bvh::Intersect(const Ray* rays, RayHit* hits, size_t n, const Vec3f* vertices) const
+{
+    intersect(nullptr, rays, hits, n, vertices);
+}
+
+void Bvh::Intersect(ThreadPool& pool, const Ray* rays, RayHit* hits, size_t n, const Vec3f* vertices) const
+{
+    intersect(&pool, rays, hits, n, vertices);
+}
+
+bool Bvh::Occluded(const Ray& ray, const Vec3f* vertices) const
+{
+    if (nodes.empty())
+        return false;
+
+    const Vec3f inv = ray.InverseDirection();
+    uint32_t stack[MaxDepth + 1];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const Node& node = nodes[stack[--top]];
+        float tNear;
+        if (!IntersectAABB(ray, inv, node.Bounds(), tNear))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            for (uint32_t tri = node.first; tri < node.first + node.count; tri++)
+            {
+                float t, u, v;
+                if (IntersectTriangle(ray, vertices[indices[3*tri]], vertices[indices[3*tri + 1]],
+                                      vertices[indices[3*tri + 2]], t, u, v))
+                    return true;
+            }
+        }
+        else
+        {
+            assert(top + 2 <= MaxDepth + 1);
+            stack[top++] = node.first + 1;
+            stack[top++] = node.first;
+        }
+    }
+    return false;
+}
+
+uint32_t Bvh::Occluded(const RayPacket& rays, const Vec3f* vertices) const
+{
+    if (nodes.empty())
+        return 0;
+
+    // Occluded lanes are cleared so the remaining boxes and triangles skip them
+    RayPacket live = rays;
+    RayPacketHit scratch;
+    scratch.Reset();
+    uint32_t occluded = 0;
+
+    uint32_t stack[MaxDepth + 1];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const Node& node = nodes[stack[--top]];
+        if (IntersectAABB(live, node.Bounds(), nullptr) == 0)
+            continue;
+
+        if (node.IsLeaf())
+        {
+            float tMax[RayPacket::Size];
+            for (int i = 0; i < RayPacket::Size; i++)
+                tMax[i] = live.tMax[i];
+            IntersectTriangles(live, vertices, indices.data(), node.first, node.first + node.count, scratch);
+            for (int i = 0; i < RayPacket::Size; i++)
+            {
+                if (live.tMax[i] != tMax[i])
+                {
+                    occluded |= 1u << i;
+                    live.Clear(i);
+                }
+            }
+        }
+        else
+        {
+            assert(top + 2 <= MaxDepth + 1);
+            stack[top++] = node.first + 1;
+            stack[top++] = node.first;
+        }
+    }
+    return occluded;
+}
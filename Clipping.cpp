@@ -0,0 +1,165 @@
+/**
+ * @file: Clipping.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Clipping.h"
+#include "SimdUtil.h"
+#include <cstring>
+
+static_assert(sizeof(Vec4f) == 4*sizeof(float), "Vec4f must be tightly packed");
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Outcode kernels
+//**********************************************************************
+// Vertices are transposed to x/y/z/w registers, each plane test is one
+// compare whose all-ones mask is ANDed with the plane bit and ORed into the
+// code. The 32 bit codes are then narrowed to bytes with saturating packs.
+
+VECTOR_TARGET_SSE41 static size_t outcodes_sse41(const float* p, uint8_t* codes, size_t n)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign = _mm_set1_ps(-0.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, p += 16)
+    {
+        __m128 x = _mm_loadu_ps(p);
+        __m128 y = _mm_loadu_ps(p + 4);
+        __m128 z = _mm_loadu_ps(p + 8);
+        __m128 w = _mm_loadu_ps(p + 12);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        const __m128 nw = _mm_xor_ps(w, sign);
+
+        __m128i c =                   _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(x, nw)),   _mm_set1_epi32(ClipLeft));
+        c = _mm_or_si128(c, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(x, w)),    _mm_set1_epi32(ClipRight)));
+        c = _mm_or_si128(c, _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(y, nw)),   _mm_set1_epi32(ClipBottom)));
+        c = _mm_or_si128(c, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(y, w)),    _mm_set1_epi32(ClipTop)));
+        c = _mm_or_si128(c, _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(z, zero)), _mm_set1_epi32(ClipNear)));
+        c = _mm_or_si128(c, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(z, w)),    _mm_set1_epi32(ClipFar)));
+
+        c = _mm_packus_epi16(_mm_packs_epi32(c, c), c);
+        const uint32_t packed = static_cast<uint32_t>(_mm_cvtsi128_si32(c));
+        memcpy(codes + i, &packed, sizeof(packed));
+    }
+    return i;
+}
+
+VECTOR_TARGET_AVX2 static size_t outcodes_avx2(const float* p, uint8_t* codes, size_t n)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, p += 32)
+    {
+        __m256 x, y, z, w;
+        deinterleave4_avx2(p, x, y, z, w);
+        const __m256 nw = _mm256_xor_ps(w, sign);
+
+        __m256i c =                      _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(x, nw, _CMP_LT_OQ)),   _mm256_set1_epi32(ClipLeft));
+        c = _mm256_or_si256(c, _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(x, w, _CMP_GT_OQ)),    _mm256_set1_epi32(ClipRight)));
+        c = _mm256_or_si256(c, _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(y, nw, _CMP_LT_OQ)),   _mm256_set1_epi32(ClipBottom)));
+        c = _mm256_or_si256(c, _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(y, w, _CMP_GT_OQ)),    _mm256_set1_epi32(ClipTop)));
+        c = _mm256_or_si256(c, _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(z, zero, _CMP_LT_OQ)), _mm256_set1_epi32(ClipNear)));
+        c = _mm256_or_si256(c, _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(z, w, _CMP_GT_OQ)),    _mm256_set1_epi32(ClipFar)));
+
+        // Per lane: 4 codes in the low dword of each 128 bit half
+        c = _mm256_packus_epi16(_mm256_packs_epi32(c, c), c);
+        const uint64_t packed = static_cast<uint32_t>(_mm256_cvtsi256_si32(c)) |
+                                static_cast<uint64_t>(static_cast<uint32_t>(_mm256_extract_epi32(c, 4))) << 32;
+        memcpy(codes + i, &packed, sizeof(packed));
+    }
+    return i;
+}
+
+#endif // VECTOR_X86_SIMD
+
+void ComputeOutcodes(const Vec4f* clip, uint8_t* codes, size_t n)
+{
+    size_t i = 0;
+#ifdef VECTOR_X86_SIMD
+    const float* p = reinterpret_cast<const float*>(clip);
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+        i = outcodes_avx2(p, codes, n);
+    else if (level == SimdLevel::SSE41)
+        i = outcodes_sse41(p, codes, n);
+#endif
+    for (; i < n; i++)
+        codes[i] = ComputeOutcode(clip[i]);
+}
+
+//**********************************************************************
+//* Triangle classification
+//**********************************************************************
+template<class Index>
+static size_t classifyTriangles(const uint8_t* codes, const Index* indices, size_t triCount,
+                                uint32_t* accept, uint32_t* reject, uint32_t* needsClip)
+{
+    size_t accepted = 0;
+
+    for (size_t word = 0; word * 32 < triCount; word++)
+    {
+        const size_t first = word * 32;
+        const size_t count = triCount - first < 32 ? triCount - first : 32;
+        const Index* idx = indices + 3 * first;
+
+        uint32_t acceptBits = 0;
+        uint32_t rejectBits = 0;
+        for (size_t t = 0; t < count; t++, idx += 3)
+        {
+            const uint32_t c0 = codes[idx[0]];
+            const uint32_t c1 = codes[idx[1]];
+            const uint32_t c2 = codes[idx[2]];
+
+            // No branches: comparisons become 0/1 and are shifted into place
+            acceptBits |= static_cast<uint32_t>((c0 | c1 | c2) == 0) << t;
+            rejectBits |= static_cast<uint32_t>((c0 & c1 & c2) != 0) << t;
+        }
+
+        const uint32_t valid = count == 32 ? 0xFFFFFFFFu : ((1u << count) - 1);
+        if (accept)
+            accept[word] = acceptBits;
+        if (reject)
+            reject[word] = rejectBits;
+        if (needsClip)
+            needsClip[word] = ~(acceptBits | rejectBits) & valid;
+
+        accepted += __builtin_popcount(acceptBits);
+    }
+    return accepted;
+}
+
+size_t ClassifyTriangles(const uint8_t* codes, const uint32_t* indices, size_t triCount,
+                         uint32_t* accept, uint32_t* reject, uint32_t* needsClip)
+{
+    return classifyTriangles(codes, indices, triCount, accept, reject, needsClip);
+}
+
+size_t ClassifyTriangles(const uint8_t* codes, const uint16_t* indices, size_t triCount,
+                         uint32_t* accept, uint32_t* reject, uint32_t* needsClip)
+{
+    return classifyTriangles(codes, indices, triCount, accept, reject, needsClip);
+}
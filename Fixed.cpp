@@ -0,0 +1,259 @@
+/**
+ * @file: Fixed.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Fixed.h"
+#include "Simd.h"
+#include <type_traits>
+#include <utility>
+
+static_assert(sizeof(Q15) == sizeof(int16_t), "Q15 must be a plain int16_t");
+static_assert(sizeof(Vec4q15) == 4*sizeof(int16_t), "Vec4q15 must be tightly packed");
+
+// Floating point values must not reach Q16 through the implicit int
+// constructor, in a conversion or as an operand
+namespace
+{
+    template <class T, class = void>
+    struct MulQ16 : std::false_type {};
+
+    template <class T>
+    struct MulQ16<T, decltype(void(std::declval<Q16>() * std::declval<T>()))> : std::true_type {};
+}
+
+static_assert(std::is_constructible<Q16, float>::value, "Q16(0.5f) must compile");
+static_assert(!std::is_convertible<float, Q16>::value, "Q16 x = 2.75f must not compile");
+static_assert(!std::is_convertible<double, Q16>::value, "Q16 x = 2.75 must not compile");
+static_assert(!MulQ16<float>::value && !MulQ16<double>::value, "q * 0.5f must not compile");
+static_assert(MulQ16<int>::value && MulQ16<Q16>::value, "q * 2 and q * q must compile");
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Q1.15 products
+//**********************************************************************
+// pmulhrsw computes (a * b + 2^14) >> 15 like the scalar operator, but wraps
+// (-1) * (-1) to -1. That is the only product that yields 0x8000, so it is
+// turned back into 0x7FFF by flipping every bit of the lanes that hold it.
+
+VECTOR_TARGET_SSE41 static inline __m128i mulq15_sse41(__m128i a, __m128i b)
+{
+    const __m128i p = _mm_mulhrs_epi16(a, b);
+    return _mm_xor_si128(p, _mm_cmpeq_epi16(p, _mm_set1_epi16(INT16_MIN)));
+}
+
+VECTOR_TARGET_AVX2 static inline __m256i mulq15_avx2(__m256i a, __m256i b)
+{
+    const __m256i p = _mm256_mulhrs_epi16(a, b);
+    return _mm256_xor_si256(p, _mm256_cmpeq_epi16(p, _mm256_set1_epi16(INT16_MIN)));
+}
+
+VECTOR_TARGET_SSE41 static void multiply_sse41(const Q15* a, const Q15* b, Q15* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), mulq15_sse41(va, vb));
+    }
+    for (; i < n; i++)
+        out[i] = a[i] * b[i];
+}
+
+VECTOR_TARGET_AVX2 static void multiply_avx2(const Q15* a, const Q15* b, Q15* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), mulq15_avx2(va, vb));
+    }
+    for (; i < n; i++)
+        out[i] = a[i] * b[i];
+}
+
+VECTOR_TARGET_SSE41 static void scale_sse41(const Q15* in, Q15 s, Q15* out, size_t n)
+{
+    const __m128i vs = _mm_set1_epi16(s.raw);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), mulq15_sse41(v, vs));
+    }
+    for (; i < n; i++)
+        out[i] = in[i] * s;
+}
+
+VECTOR_TARGET_AVX2 static void scale_avx2(const Q15* in, Q15 s, Q15* out, size_t n)
+{
+    const __m256i vs = _mm256_set1_epi16(s.raw);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), mulq15_avx2(v, vs));
+    }
+    for (; i < n; i++)
+        out[i] = in[i] * s;
+}
+
+//**********************************************************************
+//* Q1.15 dot products
+//**********************************************************************
+// The products of 8 (SSE4.1) or 16 (AVX2) vectors are transposed into
+// x/y/z/w registers and summed with paddsw in the scalar order,
+// ((x + y) + z) + w. The transpose leaves the sums in the order
+// 0 2 1 3 4 6 5 7 within each 128-bit lane, which pshufb undoes.
+
+VECTOR_TARGET_SSE41 static inline __m128i dotSum_sse41(__m128i p0, __m128i p1, __m128i p2, __m128i p3)
+{
+    const __m128i t0 = _mm_unpacklo_epi16(p0, p1);
+    const __m128i t1 = _mm_unpackhi_epi16(p0, p1);
+    const __m128i t2 = _mm_unpacklo_epi16(p2, p3);
+    const __m128i t3 = _mm_unpackhi_epi16(p2, p3);
+    const __m128i u0 = _mm_unpacklo_epi32(t0, t1);
+    const __m128i u1 = _mm_unpackhi_epi32(t0, t1);
+    const __m128i u2 = _mm_unpacklo_epi32(t2, t3);
+    const __m128i u3 = _mm_unpackhi_epi32(t2, t3);
+
+    const __m128i x = _mm_unpacklo_epi64(u0, u2);
+    const __m128i y = _mm_unpackhi_epi64(u0, u2);
+    const __m128i z = _mm_unpacklo_epi64(u1, u3);
+    const __m128i w = _mm_unpackhi_epi64(u1, u3);
+    const __m128i sum = _mm_adds_epi16(_mm_adds_epi16(_mm_adds_epi16(x, y), z), w);
+    return _mm_shuffle_epi8(sum, _mm_setr_epi8(0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15));
+}
+
+VECTOR_TARGET_AVX2 static inline __m256i dotSum_avx2(__m256i p0, __m256i p1, __m256i p2, __m256i p3)
+{
+    const __m256i t0 = _mm256_unpacklo_epi16(p0, p1);
+    const __m256i t1 = _mm256_unpackhi_epi16(p0, p1);
+    const __m256i t2 = _mm256_unpacklo_epi16(p2, p3);
+    const __m256i t3 = _mm256_unpackhi_epi16(p2, p3);
+    const __m256i u0 = _mm256_unpacklo_epi32(t0, t1);
+    const __m256i u1 = _mm256_unpackhi_epi32(t0, t1);
+    const __m256i u2 = _mm256_unpacklo_epi32(t2, t3);
+    const __m256i u3 = _mm256_unpackhi_epi32(t2, t3);
+
+    const __m256i x = _mm256_unpacklo_epi64(u0, u2);
+    const __m256i y = _mm256_unpackhi_epi64(u0, u2);
+    const __m256i z = _mm256_unpacklo_epi64(u1, u3);
+    const __m256i w = _mm256_unpackhi_epi64(u1, u3);
+    __m256i sum = _mm256_adds_epi16(_mm256_adds_epi16(_mm256_adds_epi16(x, y), z), w);
+
+    // Lane 0 holds vectors 0 1 4 5 8 9 12 13, lane 1 the rest: sort the
+    // pairs within each lane, then interleave the lanes pair by pair
+    const __m256i pairs = _mm256_setr_epi8(0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15,
+                                           0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15);
+    sum = _mm256_shuffle_epi8(sum, pairs);
+    return _mm256_permutevar8x32_epi32(sum, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+VECTOR_TARGET_SSE41 static void dot_sse41(const Vec4q15* a, const Vec4q15* b, Q15* out, size_t n)
+{
+    const __m128i* pa = reinterpret_cast<const __m128i*>(a);
+    const __m128i* pb = reinterpret_cast<const __m128i*>(b);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, pa += 4, pb += 4)
+    {
+        const __m128i p0 = mulq15_sse41(_mm_loadu_si128(pa),     _mm_loadu_si128(pb));
+        const __m128i p1 = mulq15_sse41(_mm_loadu_si128(pa + 1), _mm_loadu_si128(pb + 1));
+        const __m128i p2 = mulq15_sse41(_mm_loadu_si128(pa + 2), _mm_loadu_si128(pb + 2));
+        const __m128i p3 = mulq15_sse41(_mm_loadu_si128(pa + 3), _mm_loadu_si128(pb + 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), dotSum_sse41(p0, p1, p2, p3));
+    }
+    for (; i < n; i++)
+        out[i] = a[i] * b[i];
+}
+
+VECTOR_TARGET_AVX2 static void dot_avx2(const Vec4q15* a, const Vec4q15* b, Q15* out, size_t n)
+{
+    const __m256i* pa = reinterpret_cast<const __m256i*>(a);
+    const __m256i* pb = reinterpret_cast<const __m256i*>(b);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16, pa += 4, pb += 4)
+    {
+        const __m256i p0 = mulq15_avx2(_mm256_loadu_si256(pa),     _mm256_loadu_si256(pb));
+        const __m256i p1 = mulq15_avx2(_mm256_loadu_si256(pa + 1), _mm256_loadu_si256(pb + 1));
+        const __m256i p2 = mulq15_avx2(_mm256_loadu_si256(pa + 2), _mm256_loadu_si256(pb + 2));
+        const __m256i p3 = mulq15_avx2(_mm256_loadu_si256(pa + 3), _mm256_loadu_si256(pb + 3));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), dotSum_avx2(p0, p1, p2, p3));
+    }
+    for (; i < n; i++)
+        out[i] = a[i] * b[i];
+}
+
+#endif // VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Public API
+//**********************************************************************
+void MultiplyBatch(const Q15* a, const Q15* b, Q15* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return multiply_avx2(a, b, out, n);
+    case SimdLevel::SSE41: return multiply_sse41(a, b, out, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        out[i] = a[i] * b[i];
+}
+
+void ScaleBatch(const Q15* in, Q15 s, Q15* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return scale_avx2(in, s, out, n);
+    case SimdLevel::SSE41: return scale_sse41(in, s, out, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        out[i] = in[i] * s;
+}
+
+void DotBatch(const Vec4q15* a, const Vec4q15* b, Q15* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return dot_avx2(a, b, out, n);
+    case SimdLevel::SSE41: return dot_sse41(a, b, out, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        out[i] = a[i] * b[i];
+}
@@ -0,0 +1,179 @@
+/**
+ * @file: FixedMatrix.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "FixedMatrix.h"
+
+static_assert(sizeof(Vec4q) == 4*sizeof(int32_t), "Vec4q must be tightly packed");
+static_assert(sizeof(Mat4q) == 16*sizeof(int32_t), "Mat4q must be tightly packed");
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Q16.16 row vector x matrix kernels
+//**********************************************************************
+// pmuldq multiplies the even int32 lanes into exact 64 bit products, so the
+// even columns (0, 2) are computed with the matrix rows as they are and the
+// odd columns (1, 3) with the rows shifted down by 32 bits. The sums start
+// at the rounding constant 2^15 and are kept in 64 bit lanes, which can not
+// wrap while every matrix element is below 2^30 (16384.0) in magnitude:
+// four products then stay below 2^63 - 2^33. Larger matrices take the
+// scalar path, see kernelFits().
+//
+// narrow() takes bits 16..47 of each sum (the Q16 result) and saturates the
+// lanes whose bits 47..63 are not all equal, i.e. that do not fit in int32.
+
+VECTOR_TARGET_SSE41 static inline __m128i narrow_sse41(__m128i even, __m128i odd)
+{
+    const __m128i lo = _mm_blend_epi16(_mm_srli_epi64(even, 16), _mm_slli_epi64(odd, 16), 0xCC);
+    const __m128i hi = _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC);
+    const __m128i sign = _mm_srai_epi32(hi, 31);
+    const __m128i fits = _mm_cmpeq_epi32(_mm_srai_epi32(hi, 15), sign);
+    const __m128i sat = _mm_xor_si128(sign, _mm_set1_epi32(INT32_MAX));
+    return _mm_blendv_epi8(sat, lo, fits);
+}
+
+VECTOR_TARGET_AVX2 static inline __m256i narrow_avx2(__m256i even, __m256i odd)
+{
+    const __m256i lo = _mm256_blend_epi32(_mm256_srli_epi64(even, 16), _mm256_slli_epi64(odd, 16), 0xAA);
+    const __m256i hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    const __m256i sign = _mm256_srai_epi32(hi, 31);
+    const __m256i fits = _mm256_cmpeq_epi32(_mm256_srai_epi32(hi, 15), sign);
+    const __m256i sat = _mm256_xor_si256(sign, _mm256_set1_epi32(INT32_MAX));
+    return _mm256_blendv_epi8(sat, lo, fits);
+}
+
+// One vector per 128-bit register
+VECTOR_TARGET_SSE41 static void transform_sse41(const int32_t* m, const int32_t* in, int32_t* out, size_t n)
+{
+    const __m128i r0 = _mm_load_si128(reinterpret_cast<const __m128i*>(m));
+    const __m128i r1 = _mm_load_si128(reinterpret_cast<const __m128i*>(m + 4));
+    const __m128i r2 = _mm_load_si128(reinterpret_cast<const __m128i*>(m + 8));
+    const __m128i r3 = _mm_load_si128(reinterpret_cast<const __m128i*>(m + 12));
+    const __m128i o0 = _mm_srli_epi64(r0, 32);
+    const __m128i o1 = _mm_srli_epi64(r1, 32);
+    const __m128i o2 = _mm_srli_epi64(r2, 32);
+    const __m128i o3 = _mm_srli_epi64(r3, 32);
+    const __m128i round = _mm_set1_epi64x(1 << 15);
+
+    for (size_t i = 0; i < n; i++, in += 4, out += 4)
+    {
+        const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(in));
+        const __m128i x = _mm_shuffle_epi32(v, 0x00);
+        const __m128i y = _mm_shuffle_epi32(v, 0x55);
+        const __m128i z = _mm_shuffle_epi32(v, 0xAA);
+        const __m128i w = _mm_shuffle_epi32(v, 0xFF);
+
+        __m128i even = _mm_add_epi64(round, _mm_mul_epi32(x, r0));
+        __m128i odd  = _mm_add_epi64(round, _mm_mul_epi32(x, o0));
+        even = _mm_add_epi64(even, _mm_mul_epi32(y, r1));
+        odd  = _mm_add_epi64(odd,  _mm_mul_epi32(y, o1));
+        even = _mm_add_epi64(even, _mm_mul_epi32(z, r2));
+        odd  = _mm_add_epi64(odd,  _mm_mul_epi32(z, o2));
+        even = _mm_add_epi64(even, _mm_mul_epi32(w, r3));
+        odd  = _mm_add_epi64(odd,  _mm_mul_epi32(w, o3));
+        _mm_store_si128(reinterpret_cast<__m128i*>(out), narrow_sse41(even, odd));
+    }
+}
+
+// Two vectors per 256-bit register, the matrix rows broadcast to both lanes
+VECTOR_TARGET_AVX2 static void transform_avx2(const int32_t* m, const int32_t* in, int32_t* out, size_t n)
+{
+    const __m256i r0 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(m)));
+    const __m256i r1 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(m + 4)));
+    const __m256i r2 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(m + 8)));
+    const __m256i r3 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(m + 12)));
+    const __m256i o0 = _mm256_srli_epi64(r0, 32);
+    const __m256i o1 = _mm256_srli_epi64(r1, 32);
+    const __m256i o2 = _mm256_srli_epi64(r2, 32);
+    const __m256i o3 = _mm256_srli_epi64(r3, 32);
+    const __m256i round = _mm256_set1_epi64x(1 << 15);
+
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2, in += 8, out += 8)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        const __m256i x = _mm256_shuffle_epi32(v, 0x00);
+        const __m256i y = _mm256_shuffle_epi32(v, 0x55);
+        const __m256i z = _mm256_shuffle_epi32(v, 0xAA);
+        const __m256i w = _mm256_shuffle_epi32(v, 0xFF);
+
+        __m256i even = _mm256_add_epi64(round, _mm256_mul_epi32(x, r0));
+        __m256i odd  = _mm256_add_epi64(round, _mm256_mul_epi32(x, o0));
+        even = _mm256_add_epi64(even, _mm256_mul_epi32(y, r1));
+        odd  = _mm256_add_epi64(odd,  _mm256_mul_epi32(y, o1));
+        even = _mm256_add_epi64(even, _mm256_mul_epi32(z, r2));
+        odd  = _mm256_add_epi64(odd,  _mm256_mul_epi32(z, o2));
+        even = _mm256_add_epi64(even, _mm256_mul_epi32(w, r3));
+        odd  = _mm256_add_epi64(odd,  _mm256_mul_epi32(w, o3));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), narrow_avx2(even, odd));
+    }
+    if (i < n)
+        transform_sse41(m, in, out, 1);
+}
+
+// True if no 64 bit sum of the kernels can wrap with this matrix
+static bool kernelFits(const Mat4q& m)
+{
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            if (m.data[i][j].raw >= (1 << 30) || m.data[i][j].raw <= -(1 << 30))
+                return false;
+    return true;
+}
+
+static void transform(const int32_t* m, const int32_t* in, int32_t* out, size_t n)
+{
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return transform_avx2(m, in, out, n);
+    default:               return transform_sse41(m, in, out, n);
+    }
+}
+
+Mat4q Mat4q::multiplyKernel(const Mat4q& m) const
+{
+    Mat4q result;
+    if (kernelFits(m))
+        transform(&m.data[0][0].raw, &data[0][0].raw, &result.data[0][0].raw, 4);
+    else
+        for (int i = 0; i < 4; i++)
+            FixedDetail::RowTimesMatrix<4>(data[i], m.data, result.data[i]);
+    return result;
+}
+
+#endif // VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Public API
+//**********************************************************************
+void TransformBatch(const Mat4q& m, const Vec4q* in, Vec4q* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    if (SimdActiveLevel() != SimdLevel::Scalar && kernelFits(m))
+        return transform(&m.data[0][0].raw, reinterpret_cast<const int32_t*>(in), reinterpret_cast<int32_t*>(out), n);
+#endif
+    for (size_t i = 0; i < n; i++)
+        out[i] = in[i] * m;
+}
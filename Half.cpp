@@ -0,0 +1,100 @@
+/**
+ * @file: Half.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Half.h"
+#include <type_traits>
+#include <utility>
+
+static_assert(sizeof(Half) == sizeof(uint16_t), "Half must be a plain uint16_t");
+static_assert(sizeof(Vec3f16) == 3*sizeof(uint16_t), "Vec3f16 must be tightly packed");
+static_assert(sizeof(Vec4f16) == 4*sizeof(uint16_t), "Vec4f16 must be tightly packed");
+
+// Vector conversions documented in Half.h
+static_assert(!std::is_convertible<float, Half>::value && !std::is_convertible<Half, float>::value,
+              "Half must only convert explicitly");
+static_assert(std::is_same<decltype(FloatToHalf(std::declval<Vec2f>())), Vec2f16>::value &&
+              std::is_same<decltype(FloatToHalf(std::declval<Vec3f>())), Vec3f16>::value &&
+              std::is_same<decltype(FloatToHalf(std::declval<Vec4f>())), Vec4f16>::value,
+              "FloatToHalf(v) must give the half vector of the same size");
+static_assert(std::is_same<decltype(HalfToFloat(std::declval<Vec2f16>())), Vec2f>::value &&
+              std::is_same<decltype(HalfToFloat(std::declval<Vec3f16>())), Vec3f>::value &&
+              std::is_same<decltype(HalfToFloat(std::declval<Vec4f16>())), Vec4f>::value,
+              "HalfToFloat(h) must give the float vector of the same size");
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* F16C kernels
+//**********************************************************************
+// F16C is only used from the AVX2 level up. There is no SSE4.1 only CPU
+// with F16C, so that level uses the scalar conversions.
+
+VECTOR_TARGET_AVX2 static void toFloat_avx2(const Half* in, float* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+    }
+    for (; i < n; i++)
+        out[i] = in[i].ToFloat();
+}
+
+VECTOR_TARGET_AVX2 static void toHalf_avx2(const float* in, Half* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+    }
+    for (; i < n; i++)
+        out[i] = Half(in[i]);
+}
+
+#endif // VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Public API
+//**********************************************************************
+void HalfToFloatBatch(const Half* in, float* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    if (SimdActiveLevel() >= SimdLevel::AVX2)
+        return toFloat_avx2(in, out, n);
+#endif
+    for (size_t i = 0; i < n; i++)
+        out[i] = in[i].ToFloat();
+}
+
+void FloatToHalfBatch(const float* in, Half* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    if (SimdActiveLevel() >= SimdLevel::AVX2)
+        return toHalf_avx2(in, out, n);
+#endif
+    for (size_t i = 0; i < n; i++)
+        out[i] = Half(in[i]);
+}
@@ -3,7 +3,7 @@
  * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
  * Created Date: 2021-11-15
  * -----
- * Last Modified: 30-09-2025
+ * Last Modified: 17-10-2026
  * Modified By: Ricard Bitriá Ribes
  * -----
  * @copyright (c) 2021 Ricard Bitriá Ribes
@@ -23,153 +23,98 @@
  */
 
 #include "Mat4.h"
-#include <cmath>
-#include <cstring>
 
-Mat4& Mat4::operator*=(const Mat4& m)
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* x86 Mat4 inverse kernel
+//**********************************************************************
+// Block-wise adjugate. The matrix is split into 2x2 blocks
+//   M = | A B |
+//       | C D |
+// each stored in one register as (m00 m01 m10 m11). With X# the adjugate of
+// a 2x2 block and |X| its determinant:
+//   |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+// and the blocks of |M| * M^-1 are
+//   (|D|A - B(D#C))#   (|B|C - D(A#B)#)#
+//   (|C|B - A(D#C)#)#  (|A|D - C(A#B))#
+
+#define SHUF(v, x, y, z, w) _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+
+// 2x2 products on (m00 m01 m10 m11) registers: X*Y, X#*Y and X*Y#
+VECTOR_TARGET_SSE41 static inline __m128 mat2Mul(__m128 x, __m128 y)
 {
-#ifdef CONFIG_IDF_TARGET_ESP32S3
-    mult_4x4x4_asm(&data[0][0], &m.data[0][0], &data[0][0]);
-    return *this;
-#else
-    return *this = *this * m;
-#endif
+    return _mm_add_ps(_mm_mul_ps(x, SHUF(y, 0, 3, 0, 3)), _mm_mul_ps(SHUF(x, 1, 0, 3, 2), SHUF(y, 2, 1, 2, 1)));
 }
 
-Mat4 Mat4::operator*(const Mat4& m) const
+VECTOR_TARGET_SSE41 static inline __m128 mat2AdjMul(__m128 x, __m128 y)
 {
-    Mat4 result;
-
-#ifdef CONFIG_IDF_TARGET_ESP32S3
-    mult_4x4x4_asm(&data[0][0], &m.data[0][0], &result.data[0][0]);
-#else
-    result.data[0][0] = data[0][0]*m.data[0][0] + data[0][1]*m.data[1][0] + data[0][2]*m.data[2][0] + data[0][3]*m.data[3][0];
-    result.data[0][1] = data[0][0]*m.data[0][1] + data[0][1]*m.data[1][1] + data[0][2]*m.data[2][1] + data[0][3]*m.data[3][1];
-    result.data[0][2] = data[0][0]*m.data[0][2] + data[0][1]*m.data[1][2] + data[0][2]*m.data[2][2] + data[0][3]*m.data[3][2];
-    result.data[0][3] = data[0][0]*m.data[0][3] + data[0][1]*m.data[1][3] + data[0][2]*m.data[2][3] + data[0][3]*m.data[3][3];
-    result.data[1][0] = data[1][0]*m.data[0][0] + data[1][1]*m.data[1][0] + data[1][2]*m.data[2][0] + data[1][3]*m.data[3][0];
-    result.data[1][1] = data[1][0]*m.data[0][1] + data[1][1]*m.data[1][1] + data[1][2]*m.data[2][1] + data[1][3]*m.data[3][1];
-    result.data[1][2] = data[1][0]*m.data[0][2] + data[1][1]*m.data[1][2] + data[1][2]*m.data[2][2] + data[1][3]*m.data[3][2];
-    result.data[1][3] = data[1][0]*m.data[0][3] + data[1][1]*m.data[1][3] + data[1][2]*m.data[2][3] + data[1][3]*m.data[3][3];
-    result.data[2][0] = data[2][0]*m.data[0][0] + data[2][1]*m.data[1][0] + data[2][2]*m.data[2][0] + data[2][3]*m.data[3][0];
-    result.data[2][1] = data[2][0]*m.data[0][1] + data[2][1]*m.data[1][1] + data[2][2]*m.data[2][1] + data[2][3]*m.data[3][1];
-    result.data[2][2] = data[2][0]*m.data[0][2] + data[2][1]*m.data[1][2] + data[2][2]*m.data[2][2] + data[2][3]*m.data[3][2];
-    result.data[2][3] = data[2][0]*m.data[0][3] + data[2][1]*m.data[1][3] + data[2][2]*m.data[2][3] + data[2][3]*m.data[3][3];
-    result.data[3][0] = data[3][0]*m.data[0][0] + data[3][1]*m.data[1][0] + data[3][2]*m.data[2][0] + data[3][3]*m.data[3][0];
-    result.data[3][1] = data[3][0]*m.data[0][1] + data[3][1]*m.data[1][1] + data[3][2]*m.data[2][1] + data[3][3]*m.data[3][1];
-    result.data[3][2] = data[3][0]*m.data[0][2] + data[3][1]*m.data[1][2] + data[3][2]*m.data[2][2] + data[3][3]*m.data[3][2];
-    result.data[3][3] = data[3][0]*m.data[0][3] + data[3][1]*m.data[1][3] + data[3][2]*m.data[2][3] + data[3][3]*m.data[3][3];
-#endif
-    return result;
+    return _mm_sub_ps(_mm_mul_ps(SHUF(x, 3, 3, 0, 0), y), _mm_mul_ps(SHUF(x, 1, 1, 2, 2), SHUF(y, 2, 3, 0, 1)));
 }
 
-Mat4 Mat4::RotationZ(float theta)
+VECTOR_TARGET_SSE41 static inline __m128 mat2MulAdj(__m128 x, __m128 y)
 {
-    const float sinTheta = sinf(theta);
-    const float cosTheta = cosf(theta);
-    return {
-        cosTheta,  sinTheta, 0.0f, 0.0f,
-        -sinTheta, cosTheta, 0.0f, 0.0f,
-        0.0f,      0.0f,     1.0f, 0.0f,
-        0.0f,      0.0f,     0.0f, 1.0f,
-    };
+    return _mm_sub_ps(_mm_mul_ps(x, SHUF(y, 3, 0, 3, 0)), _mm_mul_ps(SHUF(x, 1, 0, 3, 2), SHUF(y, 2, 1, 2, 1)));
 }
 
-Mat4 Mat4::RotationY(float theta)
+VECTOR_TARGET_SSE41 static float inverse_sse41(const float* M, float* out)
 {
-    const float sinTheta = sinf(theta);
-    const float cosTheta = cosf(theta);
-
-    return {
-        cosTheta, 0.0f, -sinTheta, 0.0f,
-        0.0f,     1.0f, 0.0f,      0.0f,
-        sinTheta, 0.0f, cosTheta,  0.0f,
-        0.0f,     0.0f, 0.0f,      1.0f,
-    };
+    const __m128 r0 = _mm_load_ps(M);
+    const __m128 r1 = _mm_load_ps(M + 4);
+    const __m128 r2 = _mm_load_ps(M + 8);
+    const __m128 r3 = _mm_load_ps(M + 12);
+
+    const __m128 A = _mm_movelh_ps(r0, r1);
+    const __m128 B = _mm_movehl_ps(r1, r0);
+    const __m128 C = _mm_movelh_ps(r2, r3);
+    const __m128 D = _mm_movehl_ps(r3, r2);
+
+    // (|A| |B| |C| |D|)
+    const __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+        _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+    const __m128 detA = SHUF(detSub, 0, 0, 0, 0);
+    const __m128 detB = SHUF(detSub, 1, 1, 1, 1);
+    const __m128 detC = SHUF(detSub, 2, 2, 2, 2);
+    const __m128 detD = SHUF(detSub, 3, 3, 3, 3);
+
+    const __m128 DC = mat2AdjMul(D, C);
+    const __m128 AB = mat2AdjMul(A, B);
+    const __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, DC));
+    const __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, AB));
+    const __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, AB));
+    const __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, DC));
+
+    __m128 tr = _mm_mul_ps(AB, SHUF(DC, 0, 2, 1, 3));
+    tr = _mm_hadd_ps(tr, tr);
+    tr = _mm_hadd_ps(tr, tr);
+    const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+    // Signs of the 2x2 adjugate folded into the reciprocal
+    const __m128 rDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+    const __m128 x = _mm_mul_ps(X, rDet);
+    const __m128 y = _mm_mul_ps(Y, rDet);
+    const __m128 z = _mm_mul_ps(Z, rDet);
+    const __m128 w = _mm_mul_ps(W, rDet);
+
+    // Adjugate shuffle and block to row reordering in one step
+    _mm_store_ps(out,      _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_store_ps(out + 4,  _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_store_ps(out + 8,  _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_store_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+
+    return _mm_cvtss_f32(detM);
 }
 
-Mat4 Mat4::RotationX(float theta)
-{
-    const float sinTheta = sinf(theta);
-    const float cosTheta = cosf(theta);
-
-    return {
-        1.0f, 0.0f,     0.0f,     0.0f,
-        0.0f, cosTheta, sinTheta, 0.0f,
-        0.0f,-sinTheta, cosTheta, 0.0f,
-        0.0f, 0.0f,     0.0f,     1.0f,
-    };
-}
+#undef SHUF
 
-__attribute__((optimize("O3"))) Mat4 Mat4::Inverse() const
+Mat4 Mat4::inverseKernel(float* det) const
 {
-    Mat4 mIn = *this;
-    Mat4 mOut = Mat4::Identity();
-
-    // Compute the inverse using Gaussian elimination
-
-    for (int i = 0; i < 4; i++) {
-        // Find pivot
-        float pivot = mIn.data[i][i];
-        if (pivot == 0.0f) {
-            // Check rows below for a non-zero pivot
-            bool found = false;
-
-            for (int j = i + 1; j < 4; j++) {
-                if (mIn.data[j][i] != 0.0f) {
-                    // Swap rows in both matrices
-                    for (int k = 0; k < 4; k++) {
-                        float tmp = mIn.data[i][k];
-                        mIn.data[i][k] = mIn.data[j][k];
-                        mIn.data[j][k] = tmp;
-
-                        tmp = mOut.data[i][k];
-                        mOut.data[i][k] = mOut.data[j][k];
-                        mOut.data[j][k] = tmp;
-                    }
-                    pivot = mIn.data[i][i];
-                    found = true;
-                    break;
-                }
-            }
-
-            if (!found)
-                return Mat4(); // Singular matrix, return zero matrix
-        }
-        
-        // Scale pivot row
-        for (int j = 0; j < 4; j++) {
-            mIn.data[i][j] /= pivot;
-            mOut.data[i][j] /= pivot;
-        }
-        // Eliminate column
-        for (int j = 0; j < 4; j++) {
-            if (j != i) {
-                float factor = mIn.data[j][i];
-                for (int k = 0; k < 4; k++) {
-                    mIn.data[j][k] -= factor * mIn.data[i][k];
-                    mOut.data[j][k] -= factor * mOut.data[i][k];
-                }
-            }
-        }
-    }
-    return mOut;
+    Mat4 result;
+    const float d = inverse_sse41(&data[0][0], &result.data[0][0]);
+    if (det)
+        *det = d;
+    return d == 0.0f ? Mat4(0.0f) : result;
 }
 
-float Mat4::Determinant() const
-{
-    float det;
-    det  = data[0][3] * data[1][2] * data[2][1] * data[3][0] - data[0][2] * data[1][3] * data[2][1] * data[3][0]
-         - data[0][3] * data[1][1] * data[2][2] * data[3][0] + data[0][1] * data[1][3] * data[2][2] * data[3][0]
-         + data[0][2] * data[1][1] * data[2][3] * data[3][0] - data[0][1] * data[1][2] * data[2][3] * data[3][0]
-         - data[0][3] * data[1][2] * data[2][0] * data[3][1] + data[0][2] * data[1][3] * data[2][0] * data[3][1]
-         + data[0][3] * data[1][0] * data[2][2] * data[3][1] - data[0][0] * data[1][3] * data[2][2] * data[3][1]
-         - data[0][2] * data[1][0] * data[2][3] * data[3][1] + data[0][0] * data[1][2] * data[2][3] * data[3][1]
-         + data[0][3] * data[1][1] * data[2][0] * data[3][2] - data[0][1] * data[1][3] * data[2][0] * data[3][2]
-         - data[0][3] * data[1][0] * data[2][1] * data[3][2] + data[0][0] * data[1][3] * data[2][1] * data[3][2]
-         + data[0][1] * data[1][0] * data[2][3] * data[3][2] - data[0][0] * data[1][1] * data[2][3] * data[3][2]
-         - data[0][2] * data[1][1] * data[2][0] * data[3][3] + data[0][1] * data[1][2] * data[2][0] * data[3][3]
-         + data[0][2] * data[1][0] * data[2][1] * data[3][3] - data[0][0] * data[1][2] * data[2][1] * data[3][3]
-         - data[0][1] * data[1][0] * data[2][2] * data[3][3] + data[0][0] * data[1][1] * data[2][2] * data[3][3];
-    return det;
-}
+#endif // VECTOR_X86_SIMD
@@ -0,0 +1,153 @@
+/**
+ * @file: ParallelBatch.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "ParallelBatch.h"
+
+/**
+ * @brief Run kernel(begin, end) over [0, n), serially or on the pool
+ *
+ * @param bytes Bytes read and written per element
+ */
+template<class Kernel>
+static void parallelBatch(ThreadPool& pool, size_t n, size_t bytes, Kernel kernel)
+{
+    if (pool.Size() == 1 || n < ParallelBatchThreshold)
+    {
+        kernel(0, n);
+        return;
+    }
+
+    size_t chunk = ThreadPool::CacheSize() / 2 / bytes;
+    const size_t balanced = n / (pool.Size() * 4);
+    if (balanced < chunk)
+        chunk = balanced;
+    chunk -= chunk % ParallelBatchAlign;
+    if (chunk < ParallelBatchAlign)
+        chunk = ParallelBatchAlign;
+
+    pool.ParallelFor(n, chunk, kernel);
+}
+
+/** @brief out[i] = f(in[i]) over chunks of in/out, for kernels of the form f(in, out, n). */
+template<class In, class Out, class Fn>
+static void parallelMap(ThreadPool& pool, const In* in, Out* out, size_t n, Fn fn)
+{
+    parallelBatch(pool, n, sizeof(In) + sizeof(Out), [=](size_t begin, size_t end) {
+        fn(in + begin, out + begin, end - begin);
+    });
+}
+
+//**********************************************************************
+//* Transforms
+//**********************************************************************
+void TransformBatch(ThreadPool& pool, const Mat4& m, const Vec4f* in, Vec4f* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [&m](const Vec4f* i, Vec4f* o, size_t k) { TransformBatch(m, i, o, k); });
+}
+
+void TransformPointBatch(ThreadPool& pool, const Mat4& m, const Vec3f* in, Vec4f* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [&m](const Vec3f* i, Vec4f* o, size_t k) { TransformPointBatch(m, i, o, k); });
+}
+
+void TransformPointBatch(ThreadPool& pool, const Mat4& m, const Vec3f* in, Vec3f* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [&m](const Vec3f* i, Vec3f* o, size_t k) { TransformPointBatch(m, i, o, k); });
+}
+
+void TransformDirectionBatch(ThreadPool& pool, const Mat4& m, const Vec3f* in, Vec3f* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [&m](const Vec3f* i, Vec3f* o, size_t k) { TransformDirectionBatch(m, i, o, k); });
+}
+
+void TransformPointBatch(ThreadPool& pool, const Mat3x4& m, const Vec3f* in, Vec3f* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [&m](const Vec3f* i, Vec3f* o, size_t k) { TransformPointBatch(m, i, o, k); });
+}
+
+void TransformDirectionBatch(ThreadPool& pool, const Mat3x4& m, const Vec3f* in, Vec3f* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [&m](const Vec3f* i, Vec3f* o, size_t k) { TransformDirectionBatch(m, i, o, k); });
+}
+
+//**********************************************************************
+//* Half precision transforms
+//**********************************************************************
+void TransformBatch(ThreadPool& pool, const Mat4& m, const Vec4f16* in, Vec4f16* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [&m](const Vec4f16* i, Vec4f16* o, size_t k) { TransformBatch(m, i, o, k); });
+}
+
+void TransformPointBatch(ThreadPool& pool, const Mat4& m, const Vec3f16* in, Vec4f* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [&m](const Vec3f16* i, Vec4f* o, size_t k) { TransformPointBatch(m, i, o, k); });
+}
+
+void TransformPointBatch(ThreadPool& pool, const Mat4& m, const Vec3f16* in, Vec3f16* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [&m](const Vec3f16* i, Vec3f16* o, size_t k) { TransformPointBatch(m, i, o, k); });
+}
+
+void TransformDirectionBatch(ThreadPool& pool, const Mat4& m, const Vec3f16* in, Vec3f16* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [&m](const Vec3f16* i, Vec3f16* o, size_t k) { TransformDirectionBatch(m, i, o, k); });
+}
+
+//**********************************************************************
+//* Normalization and projection
+//**********************************************************************
+template<Precision P>
+void NormalizeBatch(ThreadPool& pool, const Vec3f* in, Vec3f* out, size_t n)
+{
+    parallelMap(pool, in, out, n, [](const Vec3f* i, Vec3f* o, size_t k) { NormalizeBatch<P>(i, o, k); });
+}
+
+template void NormalizeBatch<Precision::Exact>(ThreadPool&, const Vec3f*, Vec3f*, size_t);
+template void NormalizeBatch<Precision::Fast>(ThreadPool&, const Vec3f*, Vec3f*, size_t);
+template void NormalizeBatch<Precision::VeryFast>(ThreadPool&, const Vec3f*, Vec3f*, size_t);
+
+template<class Out>
+static void project(ThreadPool& pool, const Mat4& mvp, const Viewport& vp, const Vec3f* in, Out* screen, float* invW, size_t n)
+{
+    const size_t bytes = sizeof(Vec3f) + sizeof(Out) + (invW ? sizeof(float) : 0);
+    parallelBatch(pool, n, bytes, [&](size_t begin, size_t end) {
+        ProjectBatch(mvp, vp, in + begin, screen + begin, invW ? invW + begin : nullptr, end - begin);
+    });
+}
+
+void ProjectBatch(ThreadPool& pool, const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2f* screen, float* invW, size_t n)
+{
+    project(pool, mvp, vp, in, screen, invW, n);
+}
+
+void ProjectBatch(ThreadPool& pool, const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2* screen, float* invW, size_t n)
+{
+    project(pool, mvp, vp, in, screen, invW, n);
+}
+
+void ProjectBatch(ThreadPool& pool, const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2h* screen, float* invW, size_t n)
+{
+    project(pool, mvp, vp, in, screen, invW, n);
+}
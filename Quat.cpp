@@ -0,0 +1,401 @@
+/**
+ * @file: Quat.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Quat.h"
+#include "SimdUtil.h"
+#include <cmath>
+#include <cstring>
+
+static_assert(sizeof(Quat) == 4*sizeof(float), "Quat must be tightly packed");
+
+// Above this |dot| the inputs are nearly parallel and Slerp uses Nlerp
+static constexpr float slerpThreshold = 0.9995f;
+
+//**********************************************************************
+//* Construction and conversion
+//**********************************************************************
+Quat Quat::AxisAngle(const Vector3<float>& axis, float theta)
+{
+    const float s = sinf(theta * 0.5f);
+    return { axis.x * s, axis.y * s, axis.z * s, cosf(theta * 0.5f) };
+}
+
+Quat Quat::RotationX(float theta)
+{
+    return { sinf(theta * 0.5f), 0.0f, 0.0f, cosf(theta * 0.5f) };
+}
+
+Quat Quat::RotationY(float theta)
+{
+    return { 0.0f, sinf(theta * 0.5f), 0.0f, cosf(theta * 0.5f) };
+}
+
+Quat Quat::RotationZ(float theta)
+{
+    return { 0.0f, 0.0f, sinf(theta * 0.5f), cosf(theta * 0.5f) };
+}
+
+Quat Quat::FromMat3(const Mat3& m)
+{
+    // Shepperd's method: divide by the largest of 4w^2, 4x^2, 4y^2, 4z^2
+    const float (&d)[3][3] = m.data;
+    const float trace = d[0][0] + d[1][1] + d[2][2];
+    Quat q;
+
+    if (trace > 0.0f)
+    {
+        const float s = 2.0f * sqrtf(1.0f + trace);
+        const float inv = 1.0f / s;
+        q = { (d[1][2] - d[2][1]) * inv, (d[2][0] - d[0][2]) * inv, (d[0][1] - d[1][0]) * inv, 0.25f * s };
+    }
+    else if (d[0][0] > d[1][1] && d[0][0] > d[2][2])
+    {
+        const float s = 2.0f * sqrtf(1.0f + d[0][0] - d[1][1] - d[2][2]);
+        const float inv = 1.0f / s;
+        q = { 0.25f * s, (d[0][1] + d[1][0]) * inv, (d[0][2] + d[2][0]) * inv, (d[1][2] - d[2][1]) * inv };
+    }
+    else if (d[1][1] > d[2][2])
+    {
+        const float s = 2.0f * sqrtf(1.0f + d[1][1] - d[0][0] - d[2][2]);
+        const float inv = 1.0f / s;
+        q = { (d[0][1] + d[1][0]) * inv, 0.25f * s, (d[1][2] + d[2][1]) * inv, (d[2][0] - d[0][2]) * inv };
+    }
+    else
+    {
+        const float s = 2.0f * sqrtf(1.0f + d[2][2] - d[0][0] - d[1][1]);
+        const float inv = 1.0f / s;
+        q = { (d[0][2] + d[2][0]) * inv, (d[1][2] + d[2][1]) * inv, 0.25f * s, (d[0][1] - d[1][0]) * inv };
+    }
+
+    // q and -q are the same rotation, keep w positive
+    if (q.w < 0.0f)
+        q = { -q.x, -q.y, -q.z, -q.w };
+    return q;
+}
+
+Quat Quat::FromMat4(const Mat4& m)
+{
+    return FromMat3({
+        m.data[0][0], m.data[0][1], m.data[0][2],
+        m.data[1][0], m.data[1][1], m.data[1][2],
+        m.data[2][0], m.data[2][1], m.data[2][2],
+    });
+}
+
+Mat3 Quat::ToMat3() const
+{
+    const float xx = x * x, yy = y * y, zz = z * z;
+    const float xy = x * y, xz = x * z, yz = y * z;
+    const float wx = w * x, wy = w * y, wz = w * z;
+
+    // Row vector form, the transpose of the usual column vector matrix
+    return {
+        1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz),        2.0f * (xz - wy),
+        2.0f * (xy - wz),        1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx),
+        2.0f * (xz + wy),        2.0f * (yz - wx),        1.0f - 2.0f * (xx + yy),
+    };
+}
+
+Mat4 Quat::ToMat4() const
+{
+    return Mat4(ToMat3());
+}
+
+//**********************************************************************
+//* Interpolation
+//**********************************************************************
+static inline float dot(const Quat& a, const Quat& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+Quat Nlerp(const Quat& a, const Quat& b, float t)
+{
+    // Negating b when the dot product is negative takes the shortest path
+    const float wa = 1.0f - t;
+    const float wb = dot(a, b) < 0.0f ? -t : t;
+    Quat q(a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb);
+    q.Normalize();
+    return q;
+}
+
+Quat Slerp(const Quat& a, const Quat& b, float t)
+{
+    float d = dot(a, b);
+    const float sign = d < 0.0f ? -1.0f : 1.0f;
+    d *= sign;
+
+    if (d > slerpThreshold)
+        return Nlerp(a, b, t);
+
+    const float theta = acosf(d);
+    const float inv = 1.0f / sinf(theta);
+    const float wa = sinf((1.0f - t) * theta) * inv;
+    const float wb = sinf(t * theta) * inv * sign;
+    return { a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb };
+}
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Batch kernels
+//**********************************************************************
+// Quaternions are transposed to x/y/z/w registers, 4 (SSE4.1) or 8 (AVX2)
+// at a time. Nlerp uses the scalar operation order (no FMA) so results are
+// bit-identical. Slerp evaluates
+//   acos(d) = sqrt(1 - d) * P7(d)          |error| < 2e-8 for d in [0, 1]
+//   sin(x)  = Taylor series up to x^11     |error| < 6e-8 for x in [0, pi/2]
+// where d = |dot(a, b)| keeps every angle within [0, pi/2].
+
+static constexpr float acosCoef[8] = {
+    1.5707963050f, -0.2145988016f, 0.0889789874f, -0.0501743046f,
+    0.0308918810f, -0.0170881256f, 0.0066700901f, -0.0012624911f,
+};
+
+static constexpr float sinCoef[5] = {
+    -1.0f / 6.0f, 1.0f / 120.0f, -1.0f / 5040.0f, 1.0f / 362880.0f, -1.0f / 39916800.0f,
+};
+
+VECTOR_TARGET_SSE41 static inline __m128 acos_sse41(__m128 d)
+{
+    __m128 p = _mm_set1_ps(acosCoef[7]);
+    for (int i = 6; i >= 0; i--)
+        p = _mm_add_ps(_mm_mul_ps(p, d), _mm_set1_ps(acosCoef[i]));
+    return _mm_mul_ps(p, _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), d)));
+}
+
+VECTOR_TARGET_SSE41 static inline __m128 sin_sse41(__m128 x)
+{
+    const __m128 x2 = _mm_mul_ps(x, x);
+    __m128 p = _mm_set1_ps(sinCoef[4]);
+    for (int i = 3; i >= 0; i--)
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(sinCoef[i]));
+    return _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(p, x2), x));
+}
+
+template<bool slerp>
+VECTOR_TARGET_SSE41 static void blendBlock_sse41(const float* pa, const float* pb, __m128 t, float* out)
+{
+    __m128 ax = _mm_loadu_ps(pa),     ay = _mm_loadu_ps(pa + 4), az = _mm_loadu_ps(pa + 8), aw = _mm_loadu_ps(pa + 12);
+    __m128 bx = _mm_loadu_ps(pb),     by = _mm_loadu_ps(pb + 4), bz = _mm_loadu_ps(pb + 8), bw = _mm_loadu_ps(pb + 12);
+    _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+    _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+    const __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz)), _mm_mul_ps(aw, bw));
+    const __m128 negative = _mm_cmplt_ps(d, _mm_setzero_ps());
+    const __m128 signBit = _mm_and_ps(negative, _mm_set1_ps(-0.0f));
+
+    __m128 wa = _mm_sub_ps(_mm_set1_ps(1.0f), t);
+    __m128 wb = _mm_xor_ps(t, signBit);
+    __m128 normalize = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+    if constexpr (slerp)
+    {
+        const __m128 absD = _mm_andnot_ps(_mm_set1_ps(-0.0f), d);
+        const __m128 theta = acos_sse41(_mm_min_ps(absD, _mm_set1_ps(1.0f)));
+        const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), sin_sse41(theta));
+        const __m128 sa = _mm_mul_ps(sin_sse41(_mm_mul_ps(wa, theta)), inv);
+        const __m128 sb = _mm_xor_ps(_mm_mul_ps(sin_sse41(_mm_mul_ps(t, theta)), inv), signBit);
+
+        normalize = _mm_cmpgt_ps(absD, _mm_set1_ps(slerpThreshold));
+        wa = _mm_blendv_ps(sa, wa, normalize);
+        wb = _mm_blendv_ps(sb, wb, normalize);
+    }
+
+    __m128 x = _mm_add_ps(_mm_mul_ps(ax, wa), _mm_mul_ps(bx, wb));
+    __m128 y = _mm_add_ps(_mm_mul_ps(ay, wa), _mm_mul_ps(by, wb));
+    __m128 z = _mm_add_ps(_mm_mul_ps(az, wa), _mm_mul_ps(bz, wb));
+    __m128 w = _mm_add_ps(_mm_mul_ps(aw, wa), _mm_mul_ps(bw, wb));
+
+    const __m128 lsq = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)), _mm_mul_ps(w, w));
+    const __m128 invLen = _mm_blendv_ps(_mm_set1_ps(1.0f), _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lsq)), normalize);
+    x = _mm_mul_ps(x, invLen);
+    y = _mm_mul_ps(y, invLen);
+    z = _mm_mul_ps(z, invLen);
+    w = _mm_mul_ps(w, invLen);
+
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    _mm_storeu_ps(out,      x);
+    _mm_storeu_ps(out + 4,  y);
+    _mm_storeu_ps(out + 8,  z);
+    _mm_storeu_ps(out + 12, w);
+}
+
+VECTOR_TARGET_AVX2 static inline __m256 acos_avx2(__m256 d)
+{
+    __m256 p = _mm256_set1_ps(acosCoef[7]);
+    for (int i = 6; i >= 0; i--)
+        p = _mm256_fmadd_ps(p, d, _mm256_set1_ps(acosCoef[i]));
+    return _mm256_mul_ps(p, _mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), d)));
+}
+
+VECTOR_TARGET_AVX2 static inline __m256 sin_avx2(__m256 x)
+{
+    const __m256 x2 = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_set1_ps(sinCoef[4]);
+    for (int i = 3; i >= 0; i--)
+        p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(sinCoef[i]));
+    return _mm256_fmadd_ps(_mm256_mul_ps(p, x2), x, x);
+}
+
+template<bool slerp>
+VECTOR_TARGET_AVX2 static inline void blendBlock_avx2(const float* pa, const float* pb, __m256 t, float* out)
+{
+    __m256 ax, ay, az, aw, bx, by, bz, bw;
+    deinterleave4_avx2(pa, ax, ay, az, aw);
+    deinterleave4_avx2(pb, bx, by, bz, bw);
+
+    const __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz)), _mm256_mul_ps(aw, bw));
+    const __m256 negative = _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_LT_OQ);
+    const __m256 signBit = _mm256_and_ps(negative, _mm256_set1_ps(-0.0f));
+
+    __m256 wa = _mm256_sub_ps(_mm256_set1_ps(1.0f), t);
+    __m256 wb = _mm256_xor_ps(t, signBit);
+    __m256 normalize = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    if constexpr (slerp)
+    {
+        const __m256 absD = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), d);
+        const __m256 theta = acos_avx2(_mm256_min_ps(absD, _mm256_set1_ps(1.0f)));
+        const __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), sin_avx2(theta));
+        const __m256 sa = _mm256_mul_ps(sin_avx2(_mm256_mul_ps(wa, theta)), inv);
+        const __m256 sb = _mm256_xor_ps(_mm256_mul_ps(sin_avx2(_mm256_mul_ps(t, theta)), inv), signBit);
+
+        normalize = _mm256_cmp_ps(absD, _mm256_set1_ps(slerpThreshold), _CMP_GT_OQ);
+        wa = _mm256_blendv_ps(sa, wa, normalize);
+        wb = _mm256_blendv_ps(sb, wb, normalize);
+    }
+
+    __m256 x = _mm256_add_ps(_mm256_mul_ps(ax, wa), _mm256_mul_ps(bx, wb));
+    __m256 y = _mm256_add_ps(_mm256_mul_ps(ay, wa), _mm256_mul_ps(by, wb));
+    __m256 z = _mm256_add_ps(_mm256_mul_ps(az, wa), _mm256_mul_ps(bz, wb));
+    __m256 w = _mm256_add_ps(_mm256_mul_ps(aw, wa), _mm256_mul_ps(bw, wb));
+
+    const __m256 lsq = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)), _mm256_mul_ps(w, w));
+    const __m256 invLen = _mm256_blendv_ps(_mm256_set1_ps(1.0f), _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lsq)), normalize);
+    interleave4_avx2(_mm256_mul_ps(x, invLen), _mm256_mul_ps(y, invLen), _mm256_mul_ps(z, invLen), _mm256_mul_ps(w, invLen), out);
+}
+
+// Full blocks read a, b and t in place. The last partial block runs on a
+// copy padded with identity quaternions and t = 0.
+template<bool slerp, bool tArray>
+VECTOR_TARGET_SSE41 static void blend_sse41(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n)
+{
+    const float* pa = reinterpret_cast<const float*>(a);
+    const float* pb = reinterpret_cast<const float*>(b);
+    float* dst = reinterpret_cast<float*>(out);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        blendBlock_sse41<slerp>(pa + 4*i, pb + 4*i, tArray ? _mm_loadu_ps(t + i) : _mm_set1_ps(*t), dst + 4*i);
+
+    if (i < n)
+    {
+        const size_t rem = n - i;
+        const Quat identity = Quat::Identity();
+        alignas(16) float ta[16], tb[16], tt[4] = {0};
+        for (int k = 0; k < 4; k++)
+        {
+            memcpy(ta + 4*k, &identity, sizeof(Quat));
+            memcpy(tb + 4*k, &identity, sizeof(Quat));
+        }
+        memcpy(ta, pa + 4*i, rem * sizeof(Quat));
+        memcpy(tb, pb + 4*i, rem * sizeof(Quat));
+        memcpy(tt, tArray ? t + i : t, (tArray ? rem : 1) * sizeof(float));
+
+        blendBlock_sse41<slerp>(ta, tb, tArray ? _mm_load_ps(tt) : _mm_set1_ps(*t), ta);
+        memcpy(dst + 4*i, ta, rem * sizeof(Quat));
+    }
+}
+
+template<bool slerp, bool tArray>
+VECTOR_TARGET_AVX2 static void blend_avx2(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n)
+{
+    const float* pa = reinterpret_cast<const float*>(a);
+    const float* pb = reinterpret_cast<const float*>(b);
+    float* dst = reinterpret_cast<float*>(out);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        blendBlock_avx2<slerp>(pa + 4*i, pb + 4*i, tArray ? _mm256_loadu_ps(t + i) : _mm256_set1_ps(*t), dst + 4*i);
+
+    if (i < n)
+    {
+        const size_t rem = n - i;
+        const Quat identity = Quat::Identity();
+        alignas(32) float ta[32], tb[32], tt[8] = {0};
+        for (int k = 0; k < 8; k++)
+        {
+            memcpy(ta + 4*k, &identity, sizeof(Quat));
+            memcpy(tb + 4*k, &identity, sizeof(Quat));
+        }
+        memcpy(ta, pa + 4*i, rem * sizeof(Quat));
+        memcpy(tb, pb + 4*i, rem * sizeof(Quat));
+        memcpy(tt, tArray ? t + i : t, (tArray ? rem : 1) * sizeof(float));
+
+        blendBlock_avx2<slerp>(ta, tb, tArray ? _mm256_load_ps(tt) : _mm256_set1_ps(*t), ta);
+        memcpy(dst + 4*i, ta, rem * sizeof(Quat));
+    }
+}
+
+#endif // VECTOR_X86_SIMD
+
+template<bool slerp, bool tArray>
+static void blend(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return blend_avx2<slerp, tArray>(a, b, t, out, n);
+    case SimdLevel::SSE41: return blend_sse41<slerp, tArray>(a, b, t, out, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+    {
+        const float ti = tArray ? t[i] : *t;
+        out[i] = slerp ? Slerp(a[i], b[i], ti) : Nlerp(a[i], b[i], ti);
+    }
+}
+
+void NlerpBatch(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n)
+{
+    blend<false, true>(a, b, t, out, n);
+}
+
+void NlerpBatch(const Quat* a, const Quat* b, float t, Quat* out, size_t n)
+{
+    blend<false, false>(a, b, &t, out, n);
+}
+
+void SlerpBatch(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n)
+{
+    blend<true, true>(a, b, t, out, n);
+}
+
+void SlerpBatch(const Quat* a, const Quat* b, float t, Quat* out, size_t n)
+{
+    blend<true, false>(a, b, &t, out, n);
+}
@@ -0,0 +1,350 @@
+/**
+ * @file: Ray.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "Ray.h"
+#include "SimdUtil.h"
+
+static_assert(sizeof(Ray) == 8*sizeof(float), "Ray must be tightly packed");
+
+//**********************************************************************
+//* Scalar reference
+//**********************************************************************
+// Kept out of line so they are always built with the library flags
+// (-ffp-contract=off) and match the SIMD kernels bit for bit.
+
+bool IntersectTriangle(const Ray& ray, const Vec3f& a, const Vec3f& b, const Vec3f& c,
+                       float& t, float& u, float& v)
+{
+    const Vec3f e1 = b - a;
+    const Vec3f e2 = c - a;
+    const Vec3f p = CrossProduct(ray.direction, e2);
+    const float det = e1 * p;
+    if (det == 0.0f)
+        return false;
+
+    const float inv = 1.0f / det;
+    const Vec3f s = ray.origin - a;
+    const float hu = (s * p) * inv;
+    const Vec3f q = CrossProduct(s, e1);
+    const float hv = (ray.direction * q) * inv;
+    const float ht = (e2 * q) * inv;
+    if (!(hu >= 0.0f && hv >= 0.0f && hu + hv <= 1.0f && ht >= ray.tMin && ht < ray.tMax))
+        return false;
+
+    t = ht;
+    u = hu;
+    v = hv;
+    return true;
+}
+
+bool IntersectAABB(const Ray& ray, const Vec3f& invDir, const AABB3& box, float& tNear)
+{
+    // Same semantics as minps/maxps: the second operand wins unless the
+    // comparison holds, in particular when the first one is NaN
+    auto lo = [](float x, float y) { return x < y ? x : y; };
+    auto hi = [](float x, float y) { return x > y ? x : y; };
+
+    float tn = ray.tMin;
+    float tf = ray.tMax;
+    for (int k = 0; k < 3; k++)
+    {
+        const float t1 = (box.min[k] - ray.origin[k]) * invDir[k];
+        const float t2 = (box.max[k] - ray.origin[k]) * invDir[k];
+        tn = hi(lo(t1, t2), tn);
+        tf = lo(hi(t1, t2), tf);
+    }
+    tNear = tn;
+    return tn <= tf;
+}
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* SSE4.1 kernels, 4 lanes
+//**********************************************************************
+VECTOR_TARGET_SSE41 static uint32_t aabb_sse41(const RayPacket& r, int lane, const AABB3& box, float* tNear)
+{
+    const float* o[3] = {r.ox + lane, r.oy + lane, r.oz + lane};
+    const float* inv[3] = {r.idx + lane, r.idy + lane, r.idz + lane};
+    __m128 tn = _mm_load_ps(r.tMin + lane);
+    __m128 tf = _mm_load_ps(r.tMax + lane);
+    for (int k = 0; k < 3; k++)
+    {
+        const __m128 org = _mm_load_ps(o[k]);
+        const __m128 id = _mm_load_ps(inv[k]);
+        const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.min[k]), org), id);
+        const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.max[k]), org), id);
+        tn = _mm_max_ps(_mm_min_ps(t1, t2), tn);
+        tf = _mm_min_ps(_mm_max_ps(t1, t2), tf);
+    }
+    if (tNear)
+        _mm_storeu_ps(tNear + lane, tn);
+    return _mm_movemask_ps(_mm_cmple_ps(tn, tf));
+}
+
+VECTOR_TARGET_SSE41 static void triangles_sse41(RayPacket& r, int lane, const Vec3f* vertices, const uint32_t* indices,
+                                                size_t first, size_t last, RayPacketHit& hit)
+{
+    const __m128 ox = _mm_load_ps(r.ox + lane), oy = _mm_load_ps(r.oy + lane), oz = _mm_load_ps(r.oz + lane);
+    const __m128 dx = _mm_load_ps(r.dx + lane), dy = _mm_load_ps(r.dy + lane), dz = _mm_load_ps(r.dz + lane);
+    const __m128 tMin = _mm_load_ps(r.tMin + lane);
+    __m128 tMax = _mm_load_ps(r.tMax + lane);
+    __m128 ht = _mm_load_ps(hit.t + lane), hu = _mm_load_ps(hit.u + lane), hv = _mm_load_ps(hit.v + lane);
+    __m128 hp = _mm_load_ps(reinterpret_cast<const float*>(hit.prim + lane));
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (size_t tri = first; tri < last; tri++)
+    {
+        const Vec3f& a = vertices[indices[3*tri]];
+        const Vec3f e1 = vertices[indices[3*tri + 1]] - a;
+        const Vec3f e2 = vertices[indices[3*tri + 2]] - a;
+        const __m128 e1x = _mm_set1_ps(e1.x), e1y = _mm_set1_ps(e1.y), e1z = _mm_set1_ps(e1.z);
+        const __m128 e2x = _mm_set1_ps(e2.x), e2y = _mm_set1_ps(e2.y), e2z = _mm_set1_ps(e2.z);
+
+        // p = d x e2, det = e1 . p
+        const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+        const __m128 inv = _mm_div_ps(one, det);
+
+        // s = o - a, q = s x e1
+        const __m128 sx = _mm_sub_ps(ox, _mm_set1_ps(a.x));
+        const __m128 sy = _mm_sub_ps(oy, _mm_set1_ps(a.y));
+        const __m128 sz = _mm_sub_ps(oz, _mm_set1_ps(a.z));
+        const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inv);
+        const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inv);
+        const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inv);
+
+        __m128 mask = _mm_and_ps(_mm_cmpneq_ps(det, zero), _mm_cmpge_ps(u, zero));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(t, tMin));
+        mask = _mm_and_ps(mask, _mm_cmplt_ps(t, tMax));
+        if (_mm_movemask_ps(mask) == 0)
+            continue;
+
+        tMax = _mm_blendv_ps(tMax, t, mask);
+        ht = _mm_blendv_ps(ht, t, mask);
+        hu = _mm_blendv_ps(hu, u, mask);
+        hv = _mm_blendv_ps(hv, v, mask);
+        hp = _mm_blendv_ps(hp, _mm_castsi128_ps(_mm_set1_epi32(static_cast<int32_t>(tri))), mask);
+    }
+
+    _mm_store_ps(r.tMax + lane, tMax);
+    _mm_store_ps(hit.t + lane, ht);
+    _mm_store_ps(hit.u + lane, hu);
+    _mm_store_ps(hit.v + lane, hv);
+    _mm_store_ps(reinterpret_cast<float*>(hit.prim + lane), hp);
+}
+
+//**********************************************************************
+//* AVX2 kernels, 8 lanes
+//**********************************************************************
+// Same operations as SSE4.1, FMA is deliberately not used.
+
+VECTOR_TARGET_AVX2 static uint32_t aabb_avx2(const RayPacket& r, const AABB3& box, float* tNear)
+{
+    const float* o[3] = {r.ox, r.oy, r.oz};
+    const float* inv[3] = {r.idx, r.idy, r.idz};
+    __m256 tn = _mm256_load_ps(r.tMin);
+    __m256 tf = _mm256_load_ps(r.tMax);
+    for (int k = 0; k < 3; k++)
+    {
+        const __m256 org = _mm256_load_ps(o[k]);
+        const __m256 id = _mm256_load_ps(inv[k]);
+        const __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.min[k]), org), id);
+        const __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.max[k]), org), id);
+        tn = _mm256_max_ps(_mm256_min_ps(t1, t2), tn);
+        tf = _mm256_min_ps(_mm256_max_ps(t1, t2), tf);
+    }
+    if (tNear)
+        _mm256_storeu_ps(tNear, tn);
+    return _mm256_movemask_ps(_mm256_cmp_ps(tn, tf, _CMP_LE_OQ));
+}
+
+VECTOR_TARGET_AVX2 static void triangles_avx2(RayPacket& r, const Vec3f* vertices, const uint32_t* indices,
+                                              size_t first, size_t last, RayPacketHit& hit)
+{
+    const __m256 ox = _mm256_load_ps(r.ox), oy = _mm256_load_ps(r.oy), oz = _mm256_load_ps(r.oz);
+    const __m256 dx = _mm256_load_ps(r.dx), dy = _mm256_load_ps(r.dy), dz = _mm256_load_ps(r.dz);
+    const __m256 tMin = _mm256_load_ps(r.tMin);
+    __m256 tMax = _mm256_load_ps(r.tMax);
+    __m256 ht = _mm256_load_ps(hit.t), hu = _mm256_load_ps(hit.u), hv = _mm256_load_ps(hit.v);
+    __m256 hp = _mm256_load_ps(reinterpret_cast<const float*>(hit.prim));
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    for (size_t tri = first; tri < last; tri++)
+    {
+        const Vec3f& a = vertices[indices[3*tri]];
+        const Vec3f e1 = vertices[indices[3*tri + 1]] - a;
+        const Vec3f e2 = vertices[indices[3*tri + 2]] - a;
+        const __m256 e1x = _mm256_set1_ps(e1.x), e1y = _mm256_set1_ps(e1.y), e1z = _mm256_set1_ps(e1.z);
+        const __m256 e2x = _mm256_set1_ps(e2.x), e2y = _mm256_set1_ps(e2.y), e2z = _mm256_set1_ps(e2.z);
+
+        // p = d x e2, det = e1 . p
+        const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+        const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+        const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+        const __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)),
+                                         _mm256_mul_ps(e1z, pz));
+        const __m256 inv = _mm256_div_ps(one, det);
+
+        // s = o - a, q = s x e1
+        const __m256 sx = _mm256_sub_ps(ox, _mm256_set1_ps(a.x));
+        const __m256 sy = _mm256_sub_ps(oy, _mm256_set1_ps(a.y));
+        const __m256 sz = _mm256_sub_ps(oz, _mm256_set1_ps(a.z));
+        const __m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)),
+                                                     _mm256_mul_ps(sz, pz)), inv);
+        const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+        const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+        const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+        const __m256 v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)),
+                                                     _mm256_mul_ps(dz, qz)), inv);
+        const __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)),
+                                                     _mm256_mul_ps(e2z, qz)), inv);
+
+        __m256 mask = _mm256_and_ps(_mm256_cmp_ps(det, zero, _CMP_NEQ_OQ), _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, tMin, _CMP_GE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, tMax, _CMP_LT_OQ));
+        if (_mm256_movemask_ps(mask) == 0)
+            continue;
+
+        tMax = _mm256_blendv_ps(tMax, t, mask);
+        ht = _mm256_blendv_ps(ht, t, mask);
+        hu = _mm256_blendv_ps(hu, u, mask);
+        hv = _mm256_blendv_ps(hv, v, mask);
+        hp = _mm256_blendv_ps(hp, _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int32_t>(tri))), mask);
+    }
+
+    _mm256_store_ps(r.tMax, tMax);
+    _mm256_store_ps(hit.t, ht);
+    _mm256_store_ps(hit.u, hu);
+    _mm256_store_ps(hit.v, hv);
+    _mm256_store_ps(reinterpret_cast<float*>(hit.prim), hp);
+}
+
+#endif // VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Public API
+//**********************************************************************
+uint32_t IntersectAABB(const RayPacket& rays, const AABB3& box, float* tNear)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return aabb_avx2(rays, box, tNear);
+    case SimdLevel::SSE41: return aabb_sse41(rays, 0, box, tNear) | aabb_sse41(rays, 4, box, tNear) << 4;
+    default: break;
+    }
+#endif
+    uint32_t mask = 0;
+    for (int i = 0; i < RayPacket::Size; i++)
+    {
+        const Ray r = rays.Get(i);
+        float tn;
+        if (IntersectAABB(r, Vec3f(rays.idx[i], rays.idy[i], rays.idz[i]), box, tn))
+            mask |= 1u << i;
+        if (tNear)
+            tNear[i] = tn;
+    }
+    return mask;
+}
+
+void IntersectTriangles(RayPacket& rays, const Vec3f* vertices, const uint32_t* indices,
+                        size_t first, size_t last, RayPacketHit& hit)
+{
+    assert(last <= RayHit::None && "IntersectTriangles: triangle index does not fit in prim");
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:
+        triangles_avx2(rays, vertices, indices, first, last, hit);
+        return;
+    case SimdLevel::SSE41:
+        triangles_sse41(rays, 0, vertices, indices, first, last, hit);
+        triangles_sse41(rays, 4, vertices, indices, first, last, hit);
+        return;
+    default: break;
+    }
+#endif
+    for (int i = 0; i < RayPacket::Size; i++)
+    {
+        Ray r = rays.Get(i);
+        RayHit h = hit.Get(i);
+        if (IntersectTriangles(r, vertices, indices, first, last, h))
+        {
+            rays.tMax[i] = r.tMax;
+            hit.t[i] = h.t;
+            hit.u[i] = h.u;
+            hit.v[i] = h.v;
+            hit.prim[i] = h.prim;
+        }
+    }
+}
+
+bool IntersectTriangles(Ray& ray, const Vec3f* vertices, const uint32_t* indices,
+                        size_t first, size_t last, RayHit& hit)
+{
+    bool found = false;
+    for (size_t tri = first; tri < last; tri++)
+    {
+        float t, u, v;
+        if (IntersectTriangle(ray, vertices[indices[3*tri]], vertices[indices[3*tri + 1]],
+                              vertices[indices[3*tri + 2]], t, u, v))
+        {
+            ray.tMax = t;
+            hit = {t, u, v, static_cast<uint32_t>(tri)};
+            found = true;
+        }
+    }
+    return found;
+}
+
+void IntersectRays(const Ray* rays, RayHit* hits, size_t n,
+                   const Vec3f* vertices, const uint32_t* indices, size_t triCount)
+{
+    RayPacket packet;
+    RayPacketHit packetHit;
+    for (size_t i = 0; i < n; i += RayPacket::Size)
+    {
+        const int count = n - i < RayPacket::Size ? static_cast<int>(n - i) : RayPacket::Size;
+        packet.Load(rays + i, count);
+        packetHit.Reset();
+        IntersectTriangles(packet, vertices, indices, 0, triCount, packetHit);
+        for (int k = 0; k < count; k++)
+            hits[i + k] = packetHit.Get(k);
+    }
+}
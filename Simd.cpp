@@ -0,0 +1,79 @@
+/**
+ * @file: Simd.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Simd.h"
+#include <atomic>
+
+static SimdLevel detectHostLevel()
+{
+#ifdef VECTOR_X86_SIMD
+    __builtin_cpu_init();
+    const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")
+                   && __builtin_cpu_supports("f16c");
+    if (avx2 && __builtin_cpu_supports("avx512f"))
+        return SimdLevel::AVX512;
+    if (avx2)
+        return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse4.1"))
+        return SimdLevel::SSE41;
+#endif
+    return SimdLevel::Scalar;
+}
+
+static std::atomic<SimdLevel>& activeLevel()
+{
+    static std::atomic<SimdLevel> level(SimdHostLevel());
+    return level;
+}
+
+SimdLevel SimdHostLevel()
+{
+    static const SimdLevel level = detectHostLevel();
+    return level;
+}
+
+SimdLevel SimdActiveLevel()
+{
+    return activeLevel().load(std::memory_order_relaxed);
+}
+
+SimdLevel SimdSetLevel(SimdLevel level)
+{
+    if (level > SimdHostLevel())
+        level = SimdHostLevel();
+
+    activeLevel().store(level, std::memory_order_relaxed);
+    return level;
+}
+
+const char* SimdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::SSE41:  return "sse4.1";
+    case SimdLevel::AVX2:   return "avx2";
+    case SimdLevel::AVX512: return "avx512";
+    default:                return "scalar";
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * @file: SimdUtil.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Private helpers shared by the x86 kernels. Not part of the public headers.
+
+#ifndef SIMD_UTIL_H
+#define SIMD_UTIL_H
+
+#include "Simd.h"
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* SSE4.1
+//**********************************************************************
+/**
+ * @brief Split four packed Vec3f (12 floats) into x/y/z registers
+ */
+VECTOR_TARGET_SSE41 static inline void deinterleave3_sse41(const float* p, __m128& x, __m128& y, __m128& z)
+{
+    const __m128 m0 = _mm_loadu_ps(p);      // x0 y0 z0 x1
+    const __m128 m1 = _mm_loadu_ps(p + 4);  // y1 z1 x2 y2
+    const __m128 m2 = _mm_loadu_ps(p + 8);  // z2 x3 y3 z3
+
+    const __m128 xy = _mm_shuffle_ps(m1, m2, _MM_SHUFFLE(2, 1, 3, 2)); // x2 y2 x3 y3
+    const __m128 yz = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 0, 2, 1)); // y0 z0 y1 z1
+    x = _mm_shuffle_ps(m0, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm_shuffle_ps(yz, m2, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+/**
+ * @brief Merge x/y/z registers into four packed Vec3f (12 floats)
+ */
+VECTOR_TARGET_SSE41 static inline void interleave3_sse41(__m128 x, __m128 y, __m128 z, float* p)
+{
+    const __m128 rxy = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0)); // x0 x2 y0 y2
+    const __m128 ryz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1)); // y1 y3 z1 z3
+    const __m128 rzx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0)); // z0 z2 x1 x3
+    _mm_storeu_ps(p,     _mm_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(p + 4, _mm_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0)));
+    _mm_storeu_ps(p + 8, _mm_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+/**
+ * @brief Reciprocal estimate refined with one Newton-Raphson step (~22 bits)
+ */
+VECTOR_TARGET_SSE41 static inline __m128 rcpNewton_sse41(__m128 v)
+{
+    const __m128 r = _mm_rcp_ps(v);
+    return _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(v, r)));
+}
+
+//**********************************************************************
+//* AVX2 + FMA
+//**********************************************************************
+VECTOR_TARGET_AVX2 static inline __m256 load2x128_avx2(const float* lo, const float* hi)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+}
+
+VECTOR_TARGET_AVX2 static inline void store2x128_avx2(float* lo, float* hi, __m256 v)
+{
+    _mm_storeu_ps(lo, _mm256_castps256_ps128(v));
+    _mm_storeu_ps(hi, _mm256_extractf128_ps(v, 1));
+}
+
+/**
+ * @brief Split eight packed Vec3f (24 floats) into x/y/z registers.
+ *        Vectors 0-3 go through the low lane and 4-7 through the high lane.
+ */
+VECTOR_TARGET_AVX2 static inline void deinterleave3_avx2(const float* p, __m256& x, __m256& y, __m256& z)
+{
+    const __m256 m03 = load2x128_avx2(p,     p + 12);
+    const __m256 m14 = load2x128_avx2(p + 4, p + 16);
+    const __m256 m25 = load2x128_avx2(p + 8, p + 20);
+
+    const __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+    const __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+/**
+ * @brief Merge x/y/z registers into eight packed Vec3f (24 floats)
+ */
+VECTOR_TARGET_AVX2 static inline void interleave3_avx2(__m256 x, __m256 y, __m256 z, float* p)
+{
+    const __m256 rxy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m256 ryz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m256 rzx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+    store2x128_avx2(p,     p + 12, _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0)));
+    store2x128_avx2(p + 4, p + 16, _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0)));
+    store2x128_avx2(p + 8, p + 20, _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+/**
+ * @brief Transpose the 4x4 block held in each 128 bit lane of r0..r3
+ */
+VECTOR_TARGET_AVX2 static inline void transpose4_avx2(__m256& r0, __m256& r1, __m256& r2, __m256& r3)
+{
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+/**
+ * @brief Split eight packed Vec4f (32 floats) into x/y/z/w registers.
+ *        Vectors 0-3 go through the low lane and 4-7 through the high lane.
+ */
+VECTOR_TARGET_AVX2 static inline void deinterleave4_avx2(const float* p, __m256& x, __m256& y, __m256& z, __m256& w)
+{
+    x = load2x128_avx2(p,      p + 16);
+    y = load2x128_avx2(p + 4,  p + 20);
+    z = load2x128_avx2(p + 8,  p + 24);
+    w = load2x128_avx2(p + 12, p + 28);
+    transpose4_avx2(x, y, z, w);
+}
+
+/**
+ * @brief Merge x/y/z/w registers into eight packed Vec4f (32 floats)
+ */
+VECTOR_TARGET_AVX2 static inline void interleave4_avx2(__m256 x, __m256 y, __m256 z, __m256 w, float* p)
+{
+    transpose4_avx2(x, y, z, w);
+    store2x128_avx2(p,      p + 16, x);
+    store2x128_avx2(p + 4,  p + 20, y);
+    store2x128_avx2(p + 8,  p + 24, z);
+    store2x128_avx2(p + 12, p + 28, w);
+}
+
+/**
+ * @brief Reciprocal estimate refined with one Newton-Raphson step (~22 bits)
+ */
+VECTOR_TARGET_AVX2 static inline __m256 rcpNewton_avx2(__m256 v)
+{
+    const __m256 r = _mm256_rcp_ps(v);
+    return _mm256_mul_ps(r, _mm256_fnmadd_ps(v, r, _mm256_set1_ps(2.0f)));
+}
+
+#endif // VECTOR_X86_SIMD
+
+#endif // SIMD_UTIL_H
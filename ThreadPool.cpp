@@ -0,0 +1,204 @@
+/**
+ * @file: ThreadPool.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "ThreadPool.h"
+#include <assert.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+// Set on pool workers, and on the caller while it runs its share of a loop.
+// Nested loops run serially instead of waiting for a busy pool.
+static thread_local bool inLoop = false;
+
+// Claim the first chunk of a run
+static bool takeFront(std::atomic<uint64_t>& run, uint64_t& chunk)
+{
+    uint64_t r = run.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        const uint64_t begin = r & UINT32_MAX;
+        const uint64_t end = r >> 32;
+        if (begin >= end)
+            return false;
+        if (run.compare_exchange_weak(r, (begin + 1) | end << 32, std::memory_order_relaxed))
+        {
+            chunk = begin;
+            return true;
+        }
+    }
+}
+
+// Claim the last chunk of a run
+static bool takeBack(std::atomic<uint64_t>& run, uint64_t& chunk)
+{
+    uint64_t r = run.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        const uint64_t begin = r & UINT32_MAX;
+        const uint64_t end = r >> 32;
+        if (begin >= end)
+            return false;
+        if (run.compare_exchange_weak(r, begin | (end - 1) << 32, std::memory_order_relaxed))
+        {
+            chunk = end - 1;
+            return true;
+        }
+    }
+}
+
+ThreadPool::ThreadPool(unsigned n)
+{
+    if (n == 0)
+        n = std::thread::hardware_concurrency();
+    threads = n > 0 ? n : 1;
+    runs.reset(new Run[threads]);
+
+    workers.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; i++)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    std::lock_guard<std::mutex> serial(submit);
+    {
+        std::lock_guard<std::mutex> g(lock);
+        stop = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers)
+        t.join();
+}
+
+ThreadPool& ThreadPool::Default()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+size_t ThreadPool::CacheSize()
+{
+    static const size_t size = []() -> size_t {
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE)
+        const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        if (l2 > 0)
+            return l2;
+#endif
+        return 256 * 1024;
+    }();
+    return size;
+}
+
+void ThreadPool::run(size_t n, size_t chunkSize, Task t, void* c)
+{
+    if (n == 0)
+        return;
+    if (chunkSize == 0)
+        chunkSize = 1;
+
+    const uint64_t chunks = n / chunkSize + (n % chunkSize != 0);
+    assert(chunks <= UINT32_MAX && "ThreadPool: too many chunks");
+
+    if (threads == 1 || chunks == 1 || inLoop)
+    {
+        for (size_t begin = 0; begin < n; begin += chunkSize)
+            t(c, begin, n - begin > chunkSize ? begin + chunkSize : n);
+        return;
+    }
+
+    std::lock_guard<std::mutex> serial(submit);
+
+    // Contiguous runs of about the same number of chunks
+    const unsigned p = chunks < threads ? static_cast<unsigned>(chunks) : threads;
+    for (unsigned i = 0; i < p; i++)
+    {
+        const uint64_t begin = chunks * i / p;
+        const uint64_t end = chunks * (i + 1) / p;
+        runs[i].chunks.store(begin | end << 32, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> g(lock);
+        task = t;
+        ctx = c;
+        count = n;
+        chunk = chunkSize;
+        participants = p;
+        active = p - 1;
+        generation++;
+    }
+    wake.notify_all();
+
+    inLoop = true;
+    work(0);
+    inLoop = false;
+
+    std::unique_lock<std::mutex> g(lock);
+    done.wait(g, [this] { return active == 0; });
+}
+
+void ThreadPool::work(unsigned self)
+{
+    auto execute = [this](uint64_t c) {
+        const size_t begin = static_cast<size_t>(c) * chunk;
+        task(ctx, begin, count - begin > chunk ? begin + chunk : count);
+    };
+
+    // Own run first, in order, then steal from the back of the others
+    uint64_t c;
+    while (takeFront(runs[self].chunks, c))
+        execute(c);
+
+    for (unsigned i = 1; i < participants; i++)
+    {
+        std::atomic<uint64_t>& victim = runs[(self + i) % participants].chunks;
+        while (takeBack(victim, c))
+            execute(c);
+    }
+}
+
+void ThreadPool::workerLoop(unsigned self)
+{
+    inLoop = true;
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> g(lock);
+    for (;;)
+    {
+        wake.wait(g, [&] { return stop || generation != seen; });
+        if (stop)
+            return;
+        seen = generation;
+        if (self >= participants)
+            continue;
+
+        g.unlock();
+        work(self);
+        g.lock();
+        if (--active == 0)
+            done.notify_one();
+    }
+}
@@ -0,0 +1,76 @@
+/**
+ * @file: Transform.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Transform.h"
+#include <cmath>
+#include <cassert>
+
+Mat4 Transform::ToMat4() const
+{
+    // Rotation matrix rows scaled by the matching scale factor, translation
+    // in the last row. Same result as S * R * T with no products.
+    const float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+    const float xx = x * x, yy = y * y, zz = z * z;
+    const float xy = x * y, xz = x * z, yz = y * z;
+    const float wx = w * x, wy = w * y, wz = w * z;
+
+    const float sx = 2.0f * scale.x;
+    const float sy = 2.0f * scale.y;
+    const float sz = 2.0f * scale.z;
+
+    return {
+        scale.x - sx * (yy + zz), sx * (xy + wz),           sx * (xz - wy),           0.0f,
+        sy * (xy - wz),           scale.y - sy * (xx + zz), sy * (yz + wx),           0.0f,
+        sz * (xz + wy),           sz * (yz - wx),           scale.z - sz * (xx + yy), 0.0f,
+        translation.x,            translation.y,            translation.z,            1.0f,
+    };
+}
+
+Transform Transform::Decompose(const Mat4& m)
+{
+    const float (&d)[4][4] = m.data;
+
+    Vec3f s(sqrtf(d[0][0] * d[0][0] + d[0][1] * d[0][1] + d[0][2] * d[0][2]),
+            sqrtf(d[1][0] * d[1][0] + d[1][1] * d[1][1] + d[1][2] * d[1][2]),
+            sqrtf(d[2][0] * d[2][0] + d[2][1] * d[2][1] + d[2][2] * d[2][2]));
+    assert(s.x != 0 && s.y != 0 && s.z != 0 && "Transform: cannot decompose a matrix with zero scale");
+
+    // det < 0: the matrix mirrors, move the sign into the X scale
+    const float det = d[0][0] * (d[1][1] * d[2][2] - d[1][2] * d[2][1])
+                    - d[0][1] * (d[1][0] * d[2][2] - d[1][2] * d[2][0])
+                    + d[0][2] * (d[1][0] * d[2][1] - d[1][1] * d[2][0]);
+    if (det < 0.0f)
+        s.x = -s.x;
+
+    const float ix = 1.0f / s.x;
+    const float iy = 1.0f / s.y;
+    const float iz = 1.0f / s.z;
+    const Mat3 r(
+        d[0][0] * ix, d[0][1] * ix, d[0][2] * ix,
+        d[1][0] * iy, d[1][1] * iy, d[1][2] * iy,
+        d[2][0] * iz, d[2][1] * iz, d[2][2] * iz
+    );
+
+    return Transform(Vec3f(d[3][0], d[3][1], d[3][2]), Quat::FromMat3(r), s);
+}
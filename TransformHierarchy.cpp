@@ -0,0 +1,253 @@
+/**
+ * @file: TransformHierarchy.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TransformHierarchy.h"
+#include <algorithm>
+
+void TransformHierarchy::Reserve(size_t n)
+{
+    parent.reserve(n);
+    extent.reserve(n);
+    handle.reserve(n);
+    local.reserve(n);
+    world.reserve(n);
+    dirty.reserve(n);
+    slot.reserve(n);
+    changed.reserve(n);
+}
+
+void TransformHierarchy::Clear()
+{
+    parent.clear();
+    extent.clear();
+    handle.clear();
+    local.clear();
+    world.clear();
+    dirty.clear();
+    slot.clear();
+    changed.clear();
+    ordered = true;
+}
+
+TransformHierarchy::Node TransformHierarchy::Add(const Mat4& m, Node parentNode)
+{
+    assert(Size() < None && "TransformHierarchy: too many nodes");
+    const uint32_t i = Size();
+    const Node node = slot.size();
+
+    parent.push_back(parentNode == None ? None : slotOf(parentNode));
+    extent.push_back(1);
+    handle.push_back(node);
+    local.push_back(m);
+    world.push_back(m);
+    dirty.push_back(0);
+    slot.push_back(i);
+    markDirty(node, i);
+
+    // A root appended at the end keeps the depth first order
+    if (parentNode != None)
+        ordered = false;
+    return node;
+}
+
+void TransformHierarchy::relayout()
+{
+    const uint32_t n = Size();
+
+    // Children of each slot, in slot order
+    std::vector<uint32_t> first(n + 1, 0);
+    for (uint32_t i = 0; i < n; i++)
+        if (parent[i] != None)
+            first[parent[i] + 1]++;
+    for (uint32_t i = 0; i < n; i++)
+        first[i + 1] += first[i];
+
+    std::vector<uint32_t> children(n);
+    std::vector<uint32_t> fill(first.begin(), first.end() - 1);
+    for (uint32_t i = 0; i < n; i++)
+        if (parent[i] != None)
+            children[fill[parent[i]]++] = i;
+
+    // Depth first order: order[new slot] = old slot
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> stack;
+    order.reserve(n);
+    for (uint32_t r = n; r-- > 0;)
+        if (parent[r] == None)
+            stack.push_back(r);
+    while (!stack.empty())
+    {
+        const uint32_t i = stack.back();
+        stack.pop_back();
+        order.push_back(i);
+        for (uint32_t c = first[i + 1]; c-- > first[i];)
+            stack.push_back(children[c]);
+    }
+
+    std::vector<uint32_t> newSlot(n);
+    for (uint32_t i = 0; i < n; i++)
+        newSlot[order[i]] = i;
+
+    std::vector<uint32_t> newParent(n);
+    std::vector<uint32_t> newHandle(n);
+    std::vector<Mat4> newLocal(n);
+    std::vector<Mat4> newWorld(n);
+    std::vector<uint8_t> newDirty(n);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const uint32_t o = order[i];
+        newParent[i] = parent[o] == None ? None : newSlot[parent[o]];
+        newHandle[i] = handle[o];
+        newLocal[i] = local[o];
+        newWorld[i] = world[o];
+        newDirty[i] = dirty[o];
+        slot[handle[o]] = i;
+    }
+
+    // Parents come before their children, so a reverse pass sums subtree sizes
+    extent.assign(n, 1);
+    for (uint32_t i = n; i-- > 0;)
+        if (newParent[i] != None)
+            extent[newParent[i]] += extent[i];
+
+    parent.swap(newParent);
+    handle.swap(newHandle);
+    local.swap(newLocal);
+    world.swap(newWorld);
+    dirty.swap(newDirty);
+    ordered = true;
+}
+
+void TransformHierarchy::updateRange(uint32_t begin, uint32_t end)
+{
+    for (uint32_t i = begin; i < end; i++)
+    {
+        const uint32_t p = parent[i];
+        world[i] = p == None ? local[i] : local[i] * world[p];
+        dirty[i] = 0;
+    }
+}
+
+void TransformHierarchy::Update()
+{
+    update(nullptr);
+}
+
+void TransformHierarchy::Update(ThreadPool& pool)
+{
+    update(&pool);
+}
+
+void TransformHierarchy::update(ThreadPool* pool)
+{
+    if (!ordered)
+        relayout();
+
+    // Each changed node recomputes its whole subtree. Ranges start at a node
+    // whose parent is up to date, so they are independent of each other.
+    const uint32_t n = Size();
+    size_t total = 0;
+    work.clear();
+    if (changed.size() < n / 16)
+    {
+        // Few changes: sort them and skip the ones inside an earlier subtree
+        roots.clear();
+        for (Node node : changed)
+            roots.push_back(slot[node]);
+        std::sort(roots.begin(), roots.end());
+
+        uint32_t end = 0;
+        for (uint32_t i : roots)
+        {
+            if (i < end)
+                continue;
+            end = i + extent[i];
+            work.push_back({ i, end });
+            total += extent[i];
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < n;)
+        {
+            if (dirty[i])
+            {
+                work.push_back({ i, i + extent[i] });
+                total += extent[i];
+                i += extent[i];
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+    changed.clear();
+
+    const unsigned threads = pool ? pool->Size() : 1;
+    if (threads <= 1 || total < ParallelThreshold)
+    {
+        for (const Range& r : work)
+            updateRange(r.begin, r.end);
+        return;
+    }
+
+    // Split large subtrees: compute the root here and queue its children
+    // as separate ranges until every range is small enough to balance
+    const size_t grain = total / (threads * 4) > 64 ? total / (threads * 4) : 64;
+    for (size_t w = 0; w < work.size(); w++)
+    {
+        Range& r = work[w];
+        if (r.end - r.begin <= grain)
+            continue;
+
+        const uint32_t root = r.begin;
+        const uint32_t end = r.end;
+        updateRange(root, root + 1);
+        r.begin = r.end;
+        for (uint32_t c = root + 1; c < end; c += extent[c])
+            work.push_back({ c, c + extent[c] });
+    }
+
+    // Group consecutive ranges into batches of about grain nodes, one pool
+    // chunk each, so many small subtrees do not cost a chunk apiece
+    batches.clear();
+    size_t count = grain;
+    for (size_t w = 0; w < work.size(); w++)
+    {
+        if (count >= grain)
+        {
+            batches.push_back(uint32_t(w));
+            count = 0;
+        }
+        count += work[w].end - work[w].begin;
+    }
+    batches.push_back(uint32_t(work.size()));
+
+    pool->ParallelFor(batches.size() - 1, 1, [this](size_t first, size_t last) {
+        for (size_t b = first; b < last; b++)
+            for (uint32_t w = batches[b]; w < batches[b + 1]; w++)
+                updateRange(work[w].begin, work[w].end);
+    });
+}
@@ -0,0 +1,257 @@
+/**
+ * @file: VectorBatch.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "VectorBatch.h"
+#include "SimdUtil.h"
+#include <cstring>
+
+static_assert(sizeof(Vec3f) == 3*sizeof(float), "Vec3f must be tightly packed");
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Reciprocal square root per precision tier
+//**********************************************************************
+// Exact uses the same operation sequence as the scalar code (sqrt, divide)
+// so results are bit-identical. Fast refines the estimate with
+// y = y * (1.5 - 0.5 * x * y * y).
+
+template<Precision P>
+VECTOR_TARGET_SSE41 static inline __m128 invSqrt_sse41(__m128 x)
+{
+    if constexpr (P == Precision::Exact)
+        return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x));
+
+    const __m128 y = _mm_rsqrt_ps(x);
+    if constexpr (P == Precision::VeryFast)
+        return y;
+
+    const __m128 hxyy = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), y), y);
+    return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), hxyy));
+}
+
+template<Precision P>
+VECTOR_TARGET_AVX2 static inline __m256 invSqrt_avx2(__m256 x)
+{
+    if constexpr (P == Precision::Exact)
+        return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(x));
+
+    const __m256 y = _mm256_rsqrt_ps(x);
+    if constexpr (P == Precision::VeryFast)
+        return y;
+
+    const __m256 hxy = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), y);
+    return _mm256_mul_ps(y, _mm256_fnmadd_ps(hxy, y, _mm256_set1_ps(1.5f)));
+}
+
+//**********************************************************************
+//* Normalize / Length kernels
+//**********************************************************************
+// 4 (SSE4.1) or 8 (AVX2) vectors are deinterleaved per block. The last
+// partial block runs through the same code on a zero padded copy.
+
+template<Precision P>
+VECTOR_TARGET_SSE41 static void normalizeBlock_sse41(const float* src, float* dst)
+{
+    __m128 x, y, z;
+    deinterleave3_sse41(src, x, y, z);
+    const __m128 lsq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+    const __m128 inv = invSqrt_sse41<P>(lsq);
+    interleave3_sse41(_mm_mul_ps(x, inv), _mm_mul_ps(y, inv), _mm_mul_ps(z, inv), dst);
+}
+
+template<Precision P>
+VECTOR_TARGET_SSE41 static __m128 lengthBlock_sse41(const float* src)
+{
+    __m128 x, y, z;
+    deinterleave3_sse41(src, x, y, z);
+    const __m128 lsq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+    if constexpr (P == Precision::Exact)
+        return _mm_sqrt_ps(lsq);
+    else
+        return _mm_mul_ps(lsq, invSqrt_sse41<P>(_mm_max_ps(lsq, _mm_set1_ps(FLT_MIN))));
+}
+
+template<Precision P>
+VECTOR_TARGET_AVX2 static void normalizeBlock_avx2(const float* src, float* dst)
+{
+    __m256 x, y, z;
+    deinterleave3_avx2(src, x, y, z);
+    __m256 lsq;
+    if constexpr (P == Precision::Exact)
+        lsq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+    else
+        lsq = _mm256_fmadd_ps(x, x, _mm256_fmadd_ps(y, y, _mm256_mul_ps(z, z)));
+    const __m256 inv = invSqrt_avx2<P>(lsq);
+    interleave3_avx2(_mm256_mul_ps(x, inv), _mm256_mul_ps(y, inv), _mm256_mul_ps(z, inv), dst);
+}
+
+template<Precision P>
+VECTOR_TARGET_AVX2 static __m256 lengthBlock_avx2(const float* src)
+{
+    __m256 x, y, z;
+    deinterleave3_avx2(src, x, y, z);
+    if constexpr (P == Precision::Exact)
+    {
+        const __m256 lsq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+        return _mm256_sqrt_ps(lsq);
+    }
+    else
+    {
+        const __m256 lsq = _mm256_fmadd_ps(x, x, _mm256_fmadd_ps(y, y, _mm256_mul_ps(z, z)));
+        return _mm256_mul_ps(lsq, invSqrt_avx2<P>(_mm256_max_ps(lsq, _mm256_set1_ps(FLT_MIN))));
+    }
+}
+
+template<Precision P>
+VECTOR_TARGET_SSE41 static void normalize_sse41(const Vec3f* in, Vec3f* out, size_t n)
+{
+    const float* src = reinterpret_cast<const float*>(in);
+    float* dst = reinterpret_cast<float*>(out);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, src += 12, dst += 12)
+        normalizeBlock_sse41<P>(src, dst);
+
+    if (i < n)
+    {
+        // Pad with unit vectors to keep the spare lanes finite
+        float tmp[12] = {1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f};
+        memcpy(tmp, src, (n - i) * sizeof(Vec3f));
+        normalizeBlock_sse41<P>(tmp, tmp);
+        memcpy(dst, tmp, (n - i) * sizeof(Vec3f));
+    }
+}
+
+template<Precision P>
+VECTOR_TARGET_SSE41 static void length_sse41(const Vec3f* in, float* out, size_t n)
+{
+    const float* src = reinterpret_cast<const float*>(in);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, src += 12)
+        _mm_storeu_ps(out + i, lengthBlock_sse41<P>(src));
+
+    if (i < n)
+    {
+        float tmp[12] = {0};
+        float len[4];
+        memcpy(tmp, src, (n - i) * sizeof(Vec3f));
+        _mm_storeu_ps(len, lengthBlock_sse41<P>(tmp));
+        memcpy(out + i, len, (n - i) * sizeof(float));
+    }
+}
+
+template<Precision P>
+VECTOR_TARGET_AVX2 static void normalize_avx2(const Vec3f* in, Vec3f* out, size_t n)
+{
+    const float* src = reinterpret_cast<const float*>(in);
+    float* dst = reinterpret_cast<float*>(out);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, src += 24, dst += 24)
+        normalizeBlock_avx2<P>(src, dst);
+
+    if (i < n)
+    {
+        float tmp[24];
+        for (int k = 0; k < 8; k++)
+        {
+            tmp[3*k] = 1.0f;
+            tmp[3*k + 1] = 0.0f;
+            tmp[3*k + 2] = 0.0f;
+        }
+        memcpy(tmp, src, (n - i) * sizeof(Vec3f));
+        normalizeBlock_avx2<P>(tmp, tmp);
+        memcpy(dst, tmp, (n - i) * sizeof(Vec3f));
+    }
+}
+
+template<Precision P>
+VECTOR_TARGET_AVX2 static void length_avx2(const Vec3f* in, float* out, size_t n)
+{
+    const float* src = reinterpret_cast<const float*>(in);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, src += 24)
+        _mm256_storeu_ps(out + i, lengthBlock_avx2<P>(src));
+
+    if (i < n)
+    {
+        float tmp[24] = {0};
+        float len[8];
+        memcpy(tmp, src, (n - i) * sizeof(Vec3f));
+        _mm256_storeu_ps(len, lengthBlock_avx2<P>(tmp));
+        memcpy(out + i, len, (n - i) * sizeof(float));
+    }
+}
+
+#endif // VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Public API
+//**********************************************************************
+template<Precision P>
+void NormalizeBatch(const Vec3f* in, Vec3f* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return normalize_avx2<P>(in, out, n);
+    case SimdLevel::SSE41: return normalize_sse41<P>(in, out, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+    {
+        Vec3f v = in[i];
+        v.Normalize<P>();
+        out[i] = v;
+    }
+}
+
+template<Precision P>
+void LengthBatch(const Vec3f* in, float* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return length_avx2<P>(in, out, n);
+    case SimdLevel::SSE41: return length_sse41<P>(in, out, n);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        out[i] = in[i].Length<P>();
+}
+
+template void NormalizeBatch<Precision::Exact>(const Vec3f*, Vec3f*, size_t);
+template void NormalizeBatch<Precision::Fast>(const Vec3f*, Vec3f*, size_t);
+template void NormalizeBatch<Precision::VeryFast>(const Vec3f*, Vec3f*, size_t);
+
+template void LengthBatch<Precision::Exact>(const Vec3f*, float*, size_t);
+template void LengthBatch<Precision::Fast>(const Vec3f*, float*, size_t);
+template void LengthBatch<Precision::VeryFast>(const Vec3f*, float*, size_t);
@@ -0,0 +1,524 @@
+/**
+ * @file: VectorBatchInt16.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "VectorBatch.h"
+#include <cassert>
+
+static_assert(sizeof(Vec2h) == 2*sizeof(int16_t), "Vec2h must be tightly packed");
+static_assert(sizeof(Vec3h) == 3*sizeof(int16_t), "Vec3h must be tightly packed");
+static_assert(sizeof(Vec4h) == 4*sizeof(int16_t), "Vec4h must be tightly packed");
+
+//**********************************************************************
+//* Component wise operations
+//**********************************************************************
+// Every kernel runs over the flat int16 array of n * dimension components.
+// The scalar code is the reference: wrapping results keep the low 16 bits,
+// saturating ones are clamped, exactly like the instructions do.
+
+enum class Op16
+{
+    Add,
+    AddSat,
+    Sub,
+    SubSat,
+    Min,
+    Max
+};
+
+static inline int16_t saturate16(int32_t v)
+{
+    return v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : static_cast<int16_t>(v));
+}
+
+template<Op16 Op>
+static inline int16_t op16(int16_t a, int16_t b)
+{
+    if constexpr (Op == Op16::Add)    return static_cast<int16_t>(a + b);
+    if constexpr (Op == Op16::AddSat) return saturate16(a + b);
+    if constexpr (Op == Op16::Sub)    return static_cast<int16_t>(a - b);
+    if constexpr (Op == Op16::SubSat) return saturate16(a - b);
+    if constexpr (Op == Op16::Min)    return a < b ? a : b;
+    if constexpr (Op == Op16::Max)    return a > b ? a : b;
+}
+
+template<Overflow O>
+static inline int16_t scale16(int16_t v, int16_t s)
+{
+    if constexpr (O == Overflow::Saturate)
+        return saturate16(v * s);
+    else
+        return static_cast<int16_t>(v * s);
+}
+
+static inline int16_t clamp16(int16_t v, int16_t min, int16_t max)
+{
+    return v < min ? min : (v > max ? max : v);
+}
+
+#ifdef VECTOR_X86_SIMD
+
+template<Op16 Op>
+VECTOR_TARGET_SSE41 static inline __m128i op16_sse41(__m128i a, __m128i b)
+{
+    if constexpr (Op == Op16::Add)    return _mm_add_epi16(a, b);
+    if constexpr (Op == Op16::AddSat) return _mm_adds_epi16(a, b);
+    if constexpr (Op == Op16::Sub)    return _mm_sub_epi16(a, b);
+    if constexpr (Op == Op16::SubSat) return _mm_subs_epi16(a, b);
+    if constexpr (Op == Op16::Min)    return _mm_min_epi16(a, b);
+    if constexpr (Op == Op16::Max)    return _mm_max_epi16(a, b);
+}
+
+template<Op16 Op>
+VECTOR_TARGET_AVX2 static inline __m256i op16_avx2(__m256i a, __m256i b)
+{
+    if constexpr (Op == Op16::Add)    return _mm256_add_epi16(a, b);
+    if constexpr (Op == Op16::AddSat) return _mm256_adds_epi16(a, b);
+    if constexpr (Op == Op16::Sub)    return _mm256_sub_epi16(a, b);
+    if constexpr (Op == Op16::SubSat) return _mm256_subs_epi16(a, b);
+    if constexpr (Op == Op16::Min)    return _mm256_min_epi16(a, b);
+    if constexpr (Op == Op16::Max)    return _mm256_max_epi16(a, b);
+}
+
+// Saturating products: pmullw/pmulhw give the low and high halves of the
+// 32 bit products, packssdw clamps them back to int16
+template<Overflow O>
+VECTOR_TARGET_SSE41 static inline __m128i scale16_sse41(__m128i v, __m128i s)
+{
+    const __m128i lo = _mm_mullo_epi16(v, s);
+    if constexpr (O == Overflow::Wrap)
+        return lo;
+    const __m128i hi = _mm_mulhi_epi16(v, s);
+    return _mm_packs_epi32(_mm_unpacklo_epi16(lo, hi), _mm_unpackhi_epi16(lo, hi));
+}
+
+template<Overflow O>
+VECTOR_TARGET_AVX2 static inline __m256i scale16_avx2(__m256i v, __m256i s)
+{
+    const __m256i lo = _mm256_mullo_epi16(v, s);
+    if constexpr (O == Overflow::Wrap)
+        return lo;
+    // Unpack and pack both work within 128-bit lanes, so the order is kept
+    const __m256i hi = _mm256_mulhi_epi16(v, s);
+    return _mm256_packs_epi32(_mm256_unpacklo_epi16(lo, hi), _mm256_unpackhi_epi16(lo, hi));
+}
+
+template<Op16 Op>
+VECTOR_TARGET_SSE41 static void binary_sse41(const int16_t* a, const int16_t* b, int16_t* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), op16_sse41<Op>(va, vb));
+    }
+    for (; i < count; i++)
+        out[i] = op16<Op>(a[i], b[i]);
+}
+
+template<Op16 Op>
+VECTOR_TARGET_AVX2 static void binary_avx2(const int16_t* a, const int16_t* b, int16_t* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), op16_avx2<Op>(va, vb));
+    }
+    for (; i < count; i++)
+        out[i] = op16<Op>(a[i], b[i]);
+}
+
+template<Overflow O>
+VECTOR_TARGET_SSE41 static void scale_sse41(const int16_t* in, int16_t s, int16_t* out, size_t count)
+{
+    const __m128i vs = _mm_set1_epi16(s);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), scale16_sse41<O>(v, vs));
+    }
+    for (; i < count; i++)
+        out[i] = scale16<O>(in[i], s);
+}
+
+template<Overflow O>
+VECTOR_TARGET_AVX2 static void scale_avx2(const int16_t* in, int16_t s, int16_t* out, size_t count)
+{
+    const __m256i vs = _mm256_set1_epi16(s);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), scale16_avx2<O>(v, vs));
+    }
+    for (; i < count; i++)
+        out[i] = scale16<O>(in[i], s);
+}
+
+VECTOR_TARGET_SSE41 static void clamp_sse41(const int16_t* in, int16_t min, int16_t max, int16_t* out, size_t count)
+{
+    const __m128i lo = _mm_set1_epi16(min);
+    const __m128i hi = _mm_set1_epi16(max);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_max_epi16(_mm_min_epi16(v, hi), lo));
+    }
+    for (; i < count; i++)
+        out[i] = clamp16(in[i], min, max);
+}
+
+VECTOR_TARGET_AVX2 static void clamp_avx2(const int16_t* in, int16_t min, int16_t max, int16_t* out, size_t count)
+{
+    const __m256i lo = _mm256_set1_epi16(min);
+    const __m256i hi = _mm256_set1_epi16(max);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_max_epi16(_mm256_min_epi16(v, hi), lo));
+    }
+    for (; i < count; i++)
+        out[i] = clamp16(in[i], min, max);
+}
+
+#endif // VECTOR_X86_SIMD
+
+template<Op16 Op>
+static void binary(const int16_t* a, const int16_t* b, int16_t* out, size_t count)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return binary_avx2<Op>(a, b, out, count);
+    case SimdLevel::SSE41: return binary_sse41<Op>(a, b, out, count);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < count; i++)
+        out[i] = op16<Op>(a[i], b[i]);
+}
+
+template<Overflow O>
+static void scale(const int16_t* in, int16_t s, int16_t* out, size_t count)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return scale_avx2<O>(in, s, out, count);
+    case SimdLevel::SSE41: return scale_sse41<O>(in, s, out, count);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < count; i++)
+        out[i] = scale16<O>(in[i], s);
+}
+
+static void clamp(const int16_t* in, int16_t min, int16_t max, int16_t* out, size_t count)
+{
+    assert(min <= max && "ClampBatch: min must not be greater than max");
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return clamp_avx2(in, min, max, out, count);
+    case SimdLevel::SSE41: return clamp_sse41(in, min, max, out, count);
+    default: break;
+    }
+#endif
+    for (size_t i = 0; i < count; i++)
+        out[i] = clamp16(in[i], min, max);
+}
+
+//**********************************************************************
+//* Dot products
+//**********************************************************************
+// pmaddwd multiplies int16 pairs and adds adjacent products into int32, so
+// a Vec2h dot product is a single lane. Vec4h needs one more phaddd and
+// Vec3h is first widened to the Vec4h layout with w = 0. Sums wrap in
+// 32 bits in both the kernels and the scalar code.
+
+template<size_t N>
+static inline int32_t dot16(const int16_t* a, const int16_t* b)
+{
+    uint32_t sum = 0;
+    for (size_t k = 0; k < N; k++)
+        sum += static_cast<uint32_t>(a[k] * b[k]);
+    return static_cast<int32_t>(sum);
+}
+
+template<size_t N>
+static void dotScalar(const int16_t* a, const int16_t* b, int32_t* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++, a += N, b += N)
+        out[i] = dot16<N>(a, b);
+}
+
+#ifdef VECTOR_X86_SIMD
+
+// 8 Vec3h (48 bytes) to 4 registers of 2 vectors each in Vec4h layout
+VECTOR_TARGET_SSE41 static inline void widen3h_sse41(const int16_t* src, __m128i out[4])
+{
+    const __m128i* p = reinterpret_cast<const __m128i*>(src);
+    const __m128i a0 = _mm_loadu_si128(p);
+    const __m128i a1 = _mm_loadu_si128(p + 1);
+    const __m128i a2 = _mm_loadu_si128(p + 2);
+    const __m128i mask = _mm_setr_epi8(0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, 11, -1, -1);
+    out[0] = _mm_shuffle_epi8(a0, mask);
+    out[1] = _mm_shuffle_epi8(_mm_alignr_epi8(a1, a0, 12), mask);
+    out[2] = _mm_shuffle_epi8(_mm_alignr_epi8(a2, a1, 8), mask);
+    out[3] = _mm_shuffle_epi8(_mm_srli_si128(a2, 4), mask);
+}
+
+// 4 Vec4h per pair of registers
+VECTOR_TARGET_SSE41 static inline __m128i dot4h_sse41(__m128i a0, __m128i b0, __m128i a1, __m128i b1)
+{
+    return _mm_hadd_epi32(_mm_madd_epi16(a0, b0), _mm_madd_epi16(a1, b1));
+}
+
+// 8 Vec4h per pair of registers. phaddd works within 128-bit lanes, so the
+// results come out as 0 1 4 5 2 3 6 7 and a qword permute sorts them.
+VECTOR_TARGET_AVX2 static inline __m256i dot4h_avx2(__m256i a0, __m256i b0, __m256i a1, __m256i b1)
+{
+    const __m256i sum = _mm256_hadd_epi32(_mm256_madd_epi16(a0, b0), _mm256_madd_epi16(a1, b1));
+    return _mm256_permute4x64_epi64(sum, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+VECTOR_TARGET_SSE41 static void dot2_sse41(const int16_t* a, const int16_t* b, int32_t* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 2*i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 2*i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_madd_epi16(va, vb));
+    }
+    dotScalar<2>(a + 2*i, b + 2*i, out + i, n - i);
+}
+
+VECTOR_TARGET_AVX2 static void dot2_avx2(const int16_t* a, const int16_t* b, int32_t* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + 2*i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 2*i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_madd_epi16(va, vb));
+    }
+    dotScalar<2>(a + 2*i, b + 2*i, out + i, n - i);
+}
+
+VECTOR_TARGET_SSE41 static void dot3_sse41(const int16_t* a, const int16_t* b, int32_t* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i va[4], vb[4];
+        widen3h_sse41(a + 3*i, va);
+        widen3h_sse41(b + 3*i, vb);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),     dot4h_sse41(va[0], vb[0], va[1], vb[1]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), dot4h_sse41(va[2], vb[2], va[3], vb[3]));
+    }
+    dotScalar<3>(a + 3*i, b + 3*i, out + i, n - i);
+}
+
+VECTOR_TARGET_AVX2 static void dot3_avx2(const int16_t* a, const int16_t* b, int32_t* out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        // Widen 2 x 8 vectors, then pair the registers up like 256-bit
+        // loads of 4 Vec4h each
+        __m128i va[8], vb[8];
+        widen3h_sse41(a + 3*i,      va);
+        widen3h_sse41(a + 3*i + 24, va + 4);
+        widen3h_sse41(b + 3*i,      vb);
+        widen3h_sse41(b + 3*i + 24, vb + 4);
+        for (int k = 0; k < 2; k++)
+        {
+            const __m256i a0 = _mm256_set_m128i(va[4*k + 1], va[4*k]);
+            const __m256i a1 = _mm256_set_m128i(va[4*k + 3], va[4*k + 2]);
+            const __m256i b0 = _mm256_set_m128i(vb[4*k + 1], vb[4*k]);
+            const __m256i b1 = _mm256_set_m128i(vb[4*k + 3], vb[4*k + 2]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 8*k), dot4h_avx2(a0, b0, a1, b1));
+        }
+    }
+    dotScalar<3>(a + 3*i, b + 3*i, out + i, n - i);
+}
+
+VECTOR_TARGET_SSE41 static void dot4_sse41(const int16_t* a, const int16_t* b, int32_t* out, size_t n)
+{
+    const __m128i* pa = reinterpret_cast<const __m128i*>(a);
+    const __m128i* pb = reinterpret_cast<const __m128i*>(b);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, pa += 2, pb += 2)
+    {
+        const __m128i d = dot4h_sse41(_mm_loadu_si128(pa), _mm_loadu_si128(pb),
+                                      _mm_loadu_si128(pa + 1), _mm_loadu_si128(pb + 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), d);
+    }
+    dotScalar<4>(a + 4*i, b + 4*i, out + i, n - i);
+}
+
+VECTOR_TARGET_AVX2 static void dot4_avx2(const int16_t* a, const int16_t* b, int32_t* out, size_t n)
+{
+    const __m256i* pa = reinterpret_cast<const __m256i*>(a);
+    const __m256i* pb = reinterpret_cast<const __m256i*>(b);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, pa += 2, pb += 2)
+    {
+        const __m256i d = dot4h_avx2(_mm256_loadu_si256(pa), _mm256_loadu_si256(pb),
+                                     _mm256_loadu_si256(pa + 1), _mm256_loadu_si256(pb + 1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), d);
+    }
+    dotScalar<4>(a + 4*i, b + 4*i, out + i, n - i);
+}
+
+#endif // VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Public API
+//**********************************************************************
+static inline const int16_t* flat(const Vec2h* v) { return reinterpret_cast<const int16_t*>(v); }
+static inline const int16_t* flat(const Vec3h* v) { return reinterpret_cast<const int16_t*>(v); }
+static inline const int16_t* flat(const Vec4h* v) { return reinterpret_cast<const int16_t*>(v); }
+static inline int16_t* flat(Vec2h* v) { return reinterpret_cast<int16_t*>(v); }
+static inline int16_t* flat(Vec3h* v) { return reinterpret_cast<int16_t*>(v); }
+static inline int16_t* flat(Vec4h* v) { return reinterpret_cast<int16_t*>(v); }
+
+template<class V> struct Dim;
+template<> struct Dim<Vec2h> { static constexpr size_t value = 2; };
+template<> struct Dim<Vec3h> { static constexpr size_t value = 3; };
+template<> struct Dim<Vec4h> { static constexpr size_t value = 4; };
+
+template<Overflow O, class V>
+static void add(const V* a, const V* b, V* out, size_t n)
+{
+    if constexpr (O == Overflow::Saturate)
+        binary<Op16::AddSat>(flat(a), flat(b), flat(out), n * Dim<V>::value);
+    else
+        binary<Op16::Add>(flat(a), flat(b), flat(out), n * Dim<V>::value);
+}
+
+template<Overflow O, class V>
+static void sub(const V* a, const V* b, V* out, size_t n)
+{
+    if constexpr (O == Overflow::Saturate)
+        binary<Op16::SubSat>(flat(a), flat(b), flat(out), n * Dim<V>::value);
+    else
+        binary<Op16::Sub>(flat(a), flat(b), flat(out), n * Dim<V>::value);
+}
+
+template<Overflow O> void AddBatch(const Vec2h* a, const Vec2h* b, Vec2h* out, size_t n) { add<O>(a, b, out, n); }
+template<Overflow O> void AddBatch(const Vec3h* a, const Vec3h* b, Vec3h* out, size_t n) { add<O>(a, b, out, n); }
+template<Overflow O> void AddBatch(const Vec4h* a, const Vec4h* b, Vec4h* out, size_t n) { add<O>(a, b, out, n); }
+
+template<Overflow O> void SubBatch(const Vec2h* a, const Vec2h* b, Vec2h* out, size_t n) { sub<O>(a, b, out, n); }
+template<Overflow O> void SubBatch(const Vec3h* a, const Vec3h* b, Vec3h* out, size_t n) { sub<O>(a, b, out, n); }
+template<Overflow O> void SubBatch(const Vec4h* a, const Vec4h* b, Vec4h* out, size_t n) { sub<O>(a, b, out, n); }
+
+template<Overflow O> void ScaleBatch(const Vec2h* in, int16_t s, Vec2h* out, size_t n) { scale<O>(flat(in), s, flat(out), 2*n); }
+template<Overflow O> void ScaleBatch(const Vec3h* in, int16_t s, Vec3h* out, size_t n) { scale<O>(flat(in), s, flat(out), 3*n); }
+template<Overflow O> void ScaleBatch(const Vec4h* in, int16_t s, Vec4h* out, size_t n) { scale<O>(flat(in), s, flat(out), 4*n); }
+
+void ClampBatch(const Vec2h* in, int16_t min, int16_t max, Vec2h* out, size_t n) { clamp(flat(in), min, max, flat(out), 2*n); }
+void ClampBatch(const Vec3h* in, int16_t min, int16_t max, Vec3h* out, size_t n) { clamp(flat(in), min, max, flat(out), 3*n); }
+void ClampBatch(const Vec4h* in, int16_t min, int16_t max, Vec4h* out, size_t n) { clamp(flat(in), min, max, flat(out), 4*n); }
+
+void MinBatch(const Vec2h* a, const Vec2h* b, Vec2h* out, size_t n) { binary<Op16::Min>(flat(a), flat(b), flat(out), 2*n); }
+void MinBatch(const Vec3h* a, const Vec3h* b, Vec3h* out, size_t n) { binary<Op16::Min>(flat(a), flat(b), flat(out), 3*n); }
+void MinBatch(const Vec4h* a, const Vec4h* b, Vec4h* out, size_t n) { binary<Op16::Min>(flat(a), flat(b), flat(out), 4*n); }
+
+void MaxBatch(const Vec2h* a, const Vec2h* b, Vec2h* out, size_t n) { binary<Op16::Max>(flat(a), flat(b), flat(out), 2*n); }
+void MaxBatch(const Vec3h* a, const Vec3h* b, Vec3h* out, size_t n) { binary<Op16::Max>(flat(a), flat(b), flat(out), 3*n); }
+void MaxBatch(const Vec4h* a, const Vec4h* b, Vec4h* out, size_t n) { binary<Op16::Max>(flat(a), flat(b), flat(out), 4*n); }
+
+void DotBatch(const Vec2h* a, const Vec2h* b, int32_t* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return dot2_avx2(flat(a), flat(b), out, n);
+    case SimdLevel::SSE41: return dot2_sse41(flat(a), flat(b), out, n);
+    default: break;
+    }
+#endif
+    dotScalar<2>(flat(a), flat(b), out, n);
+}
+
+void DotBatch(const Vec3h* a, const Vec3h* b, int32_t* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return dot3_avx2(flat(a), flat(b), out, n);
+    case SimdLevel::SSE41: return dot3_sse41(flat(a), flat(b), out, n);
+    default: break;
+    }
+#endif
+    dotScalar<3>(flat(a), flat(b), out, n);
+}
+
+void DotBatch(const Vec4h* a, const Vec4h* b, int32_t* out, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    switch (SimdActiveLevel())
+    {
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:  return dot4_avx2(flat(a), flat(b), out, n);
+    case SimdLevel::SSE41: return dot4_sse41(flat(a), flat(b), out, n);
+    default: break;
+    }
+#endif
+    dotScalar<4>(flat(a), flat(b), out, n);
+}
+
+template void AddBatch<Overflow::Wrap>(const Vec2h*, const Vec2h*, Vec2h*, size_t);
+template void AddBatch<Overflow::Wrap>(const Vec3h*, const Vec3h*, Vec3h*, size_t);
+template void AddBatch<Overflow::Wrap>(const Vec4h*, const Vec4h*, Vec4h*, size_t);
+template void AddBatch<Overflow::Saturate>(const Vec2h*, const Vec2h*, Vec2h*, size_t);
+template void AddBatch<Overflow::Saturate>(const Vec3h*, const Vec3h*, Vec3h*, size_t);
+template void AddBatch<Overflow::Saturate>(const Vec4h*, const Vec4h*, Vec4h*, size_t);
+
+template void SubBatch<Overflow::Wrap>(const Vec2h*, const Vec2h*, Vec2h*, size_t);
+template void SubBatch<Overflow::Wrap>(const Vec3h*, const Vec3h*, Vec3h*, size_t);
+template void SubBatch<Overflow::Wrap>(const Vec4h*, const Vec4h*, Vec4h*, size_t);
+template void SubBatch<Overflow::Saturate>(const Vec2h*, const Vec2h*, Vec2h*, size_t);
+template void SubBatch<Overflow::Saturate>(const Vec3h*, const Vec3h*, Vec3h*, size_t);
+template void SubBatch<Overflow::Saturate>(const Vec4h*, const Vec4h*, Vec4h*, size_t);
+
+template void ScaleBatch<Overflow::Wrap>(const Vec2h*, int16_t, Vec2h*, size_t);
+template void ScaleBatch<Overflow::Wrap>(const Vec3h*, int16_t, Vec3h*, size_t);
+template void ScaleBatch<Overflow::Wrap>(const Vec4h*, int16_t, Vec4h*, size_t);
+template void ScaleBatch<Overflow::Saturate>(const Vec2h*, int16_t, Vec2h*, size_t);
+template void ScaleBatch<Overflow::Saturate>(const Vec3h*, int16_t, Vec3h*, size_t);
+template void ScaleBatch<Overflow::Saturate>(const Vec4h*, int16_t, Vec4h*, size_t);
@@ -0,0 +1,862 @@
+/**
+ * @file: VectorSoA.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "VectorSoA.h"
+#include "SimdUtil.h"
+#include <cstring>
+#include <new>
+
+static_assert(sizeof(Vec4f) == 4*sizeof(float), "Vec4f must be tightly packed");
+static_assert(sizeof(Vec3f) == 3*sizeof(float), "Vec3f must be tightly packed");
+
+//**********************************************************************
+//* Lane storage
+//**********************************************************************
+static size_t paddedSize(size_t n)
+{
+    return (n + 15) & ~static_cast<size_t>(15);
+}
+
+static float* allocLanes(size_t lanes, size_t capacity)
+{
+    if (capacity == 0)
+        return nullptr;
+
+    const size_t bytes = lanes * capacity * sizeof(float);
+    float* buffer = static_cast<float*>(::operator new(bytes, std::align_val_t(Vec3fSoA::Alignment)));
+    // Padding takes part in the SIMD kernels, so keep it finite
+    memset(buffer, 0, bytes);
+    return buffer;
+}
+
+static void freeLanes(float* buffer)
+{
+    if (buffer)
+        ::operator delete(buffer, std::align_val_t(Vec3fSoA::Alignment));
+}
+
+//**********************************************************************
+//* Vec3fSoA
+//**********************************************************************
+Vec3fSoA::Vec3fSoA(const Vec3fSoA& other)
+{
+    *this = other;
+}
+
+Vec3fSoA::Vec3fSoA(Vec3fSoA&& other) noexcept
+{
+    *this = static_cast<Vec3fSoA&&>(other);
+}
+
+Vec3fSoA& Vec3fSoA::operator=(const Vec3fSoA& other)
+{
+    if (this == &other)
+        return *this;
+
+    Resize(other.size);
+    if (size)
+    {
+        memcpy(x, other.x, size * sizeof(float));
+        memcpy(y, other.y, size * sizeof(float));
+        memcpy(z, other.z, size * sizeof(float));
+    }
+    return *this;
+}
+
+Vec3fSoA& Vec3fSoA::operator=(Vec3fSoA&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    freeLanes(x);
+    x = other.x;
+    y = other.y;
+    z = other.z;
+    size = other.size;
+    capacity = other.capacity;
+
+    other.x = other.y = other.z = nullptr;
+    other.size = other.capacity = 0;
+    return *this;
+}
+
+Vec3fSoA::~Vec3fSoA()
+{
+    freeLanes(x);
+}
+
+void Vec3fSoA::Resize(size_t n)
+{
+    if (n <= capacity)
+    {
+        size = n;
+        return;
+    }
+
+    const size_t newCapacity = paddedSize(n);
+    float* buffer = allocLanes(3, newCapacity);
+    if (size)
+    {
+        memcpy(buffer,                 x, size * sizeof(float));
+        memcpy(buffer + newCapacity,   y, size * sizeof(float));
+        memcpy(buffer + 2*newCapacity, z, size * sizeof(float));
+    }
+    freeLanes(x);
+
+    x = buffer;
+    y = buffer + newCapacity;
+    z = buffer + 2*newCapacity;
+    size = n;
+    capacity = newCapacity;
+}
+
+void Vec3fSoA::Load(const Vec3f* v, size_t n)
+{
+    Resize(n);
+    RepackToSoA(v, x, y, z, n);
+}
+
+void Vec3fSoA::Store(Vec3f* v) const
+{
+    RepackToAoS(x, y, z, v, size);
+}
+
+//**********************************************************************
+//* Vec4fSoA
+//**********************************************************************
+Vec4fSoA::Vec4fSoA(const Vec4fSoA& other)
+{
+    *this = other;
+}
+
+Vec4fSoA::Vec4fSoA(Vec4fSoA&& other) noexcept
+{
+    *this = static_cast<Vec4fSoA&&>(other);
+}
+
+Vec4fSoA& Vec4fSoA::operator=(const Vec4fSoA& other)
+{
+    if (this == &other)
+        return *this;
+
+    Resize(other.size);
+    if (size)
+    {
+        memcpy(x, other.x, size * sizeof(float));
+        memcpy(y, other.y, size * sizeof(float));
+        memcpy(z, other.z, size * sizeof(float));
+        memcpy(w, other.w, size * sizeof(float));
+    }
+    return *this;
+}
+
+Vec4fSoA& Vec4fSoA::operator=(Vec4fSoA&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    freeLanes(x);
+    x = other.x;
+    y = other.y;
+    z = other.z;
+    w = other.w;
+    size = other.size;
+    capacity = other.capacity;
+
+    other.x = other.y = other.z = other.w = nullptr;
+    other.size = other.capacity = 0;
+    return *this;
+}
+
+Vec4fSoA::~Vec4fSoA()
+{
+    freeLanes(x);
+}
+
+void Vec4fSoA::Resize(size_t n)
+{
+    if (n <= capacity)
+    {
+        size = n;
+        return;
+    }
+
+    const size_t newCapacity = paddedSize(n);
+    float* buffer = allocLanes(4, newCapacity);
+    if (size)
+    {
+        memcpy(buffer,                 x, size * sizeof(float));
+        memcpy(buffer + newCapacity,   y, size * sizeof(float));
+        memcpy(buffer + 2*newCapacity, z, size * sizeof(float));
+        memcpy(buffer + 3*newCapacity, w, size * sizeof(float));
+    }
+    freeLanes(x);
+
+    x = buffer;
+    y = buffer + newCapacity;
+    z = buffer + 2*newCapacity;
+    w = buffer + 3*newCapacity;
+    size = n;
+    capacity = newCapacity;
+}
+
+void Vec4fSoA::Load(const Vec4f* v, size_t n)
+{
+    Resize(n);
+    RepackToSoA(v, x, y, z, w, n);
+}
+
+void Vec4fSoA::Store(Vec4f* v) const
+{
+    RepackToAoS(x, y, z, w, v, size);
+}
+
+#ifdef VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Repacking kernels
+//**********************************************************************
+// Vec3f: three registers hold four (SSE) or eight (AVX2) packed vectors.
+// Vec4f: plain 4x4 transposes, two at a time on AVX2.
+
+VECTOR_TARGET_SSE41 static size_t repackToSoA3_sse41(const float* p, float* x, float* y, float* z, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, p += 12)
+    {
+        __m128 vx, vy, vz;
+        deinterleave3_sse41(p, vx, vy, vz);
+        _mm_storeu_ps(x + i, vx);
+        _mm_storeu_ps(y + i, vy);
+        _mm_storeu_ps(z + i, vz);
+    }
+    return i;
+}
+
+VECTOR_TARGET_SSE41 static size_t repackToAoS3_sse41(const float* x, const float* y, const float* z, float* p, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, p += 12)
+        interleave3_sse41(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i), _mm_loadu_ps(z + i), p);
+    return i;
+}
+
+VECTOR_TARGET_SSE41 static size_t repackToSoA4_sse41(const float* p, float* x, float* y, float* z, float* w, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, p += 16)
+    {
+        __m128 r0 = _mm_loadu_ps(p);
+        __m128 r1 = _mm_loadu_ps(p + 4);
+        __m128 r2 = _mm_loadu_ps(p + 8);
+        __m128 r3 = _mm_loadu_ps(p + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(x + i, r0);
+        _mm_storeu_ps(y + i, r1);
+        _mm_storeu_ps(z + i, r2);
+        _mm_storeu_ps(w + i, r3);
+    }
+    return i;
+}
+
+VECTOR_TARGET_SSE41 static size_t repackToAoS4_sse41(const float* x, const float* y, const float* z, const float* w, float* p, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, p += 16)
+    {
+        __m128 r0 = _mm_loadu_ps(x + i);
+        __m128 r1 = _mm_loadu_ps(y + i);
+        __m128 r2 = _mm_loadu_ps(z + i);
+        __m128 r3 = _mm_loadu_ps(w + i);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(p,      r0);
+        _mm_storeu_ps(p + 4,  r1);
+        _mm_storeu_ps(p + 8,  r2);
+        _mm_storeu_ps(p + 12, r3);
+    }
+    return i;
+}
+
+VECTOR_TARGET_AVX2 static size_t repackToSoA3_avx2(const float* p, float* x, float* y, float* z, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, p += 24)
+    {
+        __m256 vx, vy, vz;
+        deinterleave3_avx2(p, vx, vy, vz);
+        _mm256_storeu_ps(x + i, vx);
+        _mm256_storeu_ps(y + i, vy);
+        _mm256_storeu_ps(z + i, vz);
+    }
+    return i;
+}
+
+VECTOR_TARGET_AVX2 static size_t repackToAoS3_avx2(const float* x, const float* y, const float* z, float* p, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, p += 24)
+        interleave3_avx2(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), _mm256_loadu_ps(z + i), p);
+    return i;
+}
+
+VECTOR_TARGET_AVX2 static size_t repackToSoA4_avx2(const float* p, float* x, float* y, float* z, float* w, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, p += 32)
+    {
+        // Transpose two 4x4 blocks at once: vectors 0-3 low lane, 4-7 high lane
+        const __m256 r0 = load2x128_avx2(p,      p + 16);
+        const __m256 r1 = load2x128_avx2(p + 4,  p + 20);
+        const __m256 r2 = load2x128_avx2(p + 8,  p + 24);
+        const __m256 r3 = load2x128_avx2(p + 12, p + 28);
+
+        const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+        const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+        const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+        const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+        _mm256_storeu_ps(x + i, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+        _mm256_storeu_ps(y + i, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+        _mm256_storeu_ps(z + i, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+        _mm256_storeu_ps(w + i, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+    }
+    return i;
+}
+
+VECTOR_TARGET_AVX2 static size_t repackToAoS4_avx2(const float* x, const float* y, const float* z, const float* w, float* p, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, p += 32)
+    {
+        const __m256 vx = _mm256_loadu_ps(x + i);
+        const __m256 vy = _mm256_loadu_ps(y + i);
+        const __m256 vz = _mm256_loadu_ps(z + i);
+        const __m256 vw = _mm256_loadu_ps(w + i);
+
+        const __m256 t0 = _mm256_unpacklo_ps(vx, vy);
+        const __m256 t1 = _mm256_unpackhi_ps(vx, vy);
+        const __m256 t2 = _mm256_unpacklo_ps(vz, vw);
+        const __m256 t3 = _mm256_unpackhi_ps(vz, vw);
+        store2x128_avx2(p,      p + 16, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+        store2x128_avx2(p + 4,  p + 20, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+        store2x128_avx2(p + 8,  p + 24, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+        store2x128_avx2(p + 12, p + 28, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+    }
+    return i;
+}
+
+//**********************************************************************
+//* Lane kernels
+//**********************************************************************
+// Lanes are aligned and padded, so n is always a multiple of 16 here. No
+// FMA on any level, so SSE4.1, AVX2 and the scalar loops give the same bits.
+
+VECTOR_TARGET_SSE41 static void laneAdd_sse41(const float* a, const float* b, float* o, size_t n)
+{
+    for (size_t i = 0; i < n; i += 4)
+        _mm_store_ps(o + i, _mm_add_ps(_mm_load_ps(a + i), _mm_load_ps(b + i)));
+}
+
+VECTOR_TARGET_SSE41 static void laneSub_sse41(const float* a, const float* b, float* o, size_t n)
+{
+    for (size_t i = 0; i < n; i += 4)
+        _mm_store_ps(o + i, _mm_sub_ps(_mm_load_ps(a + i), _mm_load_ps(b + i)));
+}
+
+VECTOR_TARGET_SSE41 static void laneMin_sse41(const float* a, const float* b, float* o, size_t n)
+{
+    for (size_t i = 0; i < n; i += 4)
+        _mm_store_ps(o + i, _mm_min_ps(_mm_load_ps(a + i), _mm_load_ps(b + i)));
+}
+
+VECTOR_TARGET_SSE41 static void laneMax_sse41(const float* a, const float* b, float* o, size_t n)
+{
+    for (size_t i = 0; i < n; i += 4)
+        _mm_store_ps(o + i, _mm_max_ps(_mm_load_ps(a + i), _mm_load_ps(b + i)));
+}
+
+VECTOR_TARGET_SSE41 static void laneScale_sse41(const float* a, float s, float* o, size_t n)
+{
+    const __m128 vs = _mm_set1_ps(s);
+    for (size_t i = 0; i < n; i += 4)
+        _mm_store_ps(o + i, _mm_mul_ps(_mm_load_ps(a + i), vs));
+}
+
+VECTOR_TARGET_SSE41 static void laneLerp_sse41(const float* a, const float* b, float t, float* o, size_t n)
+{
+    const __m128 vt = _mm_set1_ps(t);
+    for (size_t i = 0; i < n; i += 4)
+    {
+        const __m128 va = _mm_load_ps(a + i);
+        _mm_store_ps(o + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(b + i), va), vt)));
+    }
+}
+
+VECTOR_TARGET_AVX2 static void laneAdd_avx2(const float* a, const float* b, float* o, size_t n)
+{
+    for (size_t i = 0; i < n; i += 8)
+        _mm256_store_ps(o + i, _mm256_add_ps(_mm256_load_ps(a + i), _mm256_load_ps(b + i)));
+}
+
+VECTOR_TARGET_AVX2 static void laneSub_avx2(const float* a, const float* b, float* o, size_t n)
+{
+    for (size_t i = 0; i < n; i += 8)
+        _mm256_store_ps(o + i, _mm256_sub_ps(_mm256_load_ps(a + i), _mm256_load_ps(b + i)));
+}
+
+VECTOR_TARGET_AVX2 static void laneMin_avx2(const float* a, const float* b, float* o, size_t n)
+{
+    for (size_t i = 0; i < n; i += 8)
+        _mm256_store_ps(o + i, _mm256_min_ps(_mm256_load_ps(a + i), _mm256_load_ps(b + i)));
+}
+
+VECTOR_TARGET_AVX2 static void laneMax_avx2(const float* a, const float* b, float* o, size_t n)
+{
+    for (size_t i = 0; i < n; i += 8)
+        _mm256_store_ps(o + i, _mm256_max_ps(_mm256_load_ps(a + i), _mm256_load_ps(b + i)));
+}
+
+VECTOR_TARGET_AVX2 static void laneScale_avx2(const float* a, float s, float* o, size_t n)
+{
+    const __m256 vs = _mm256_set1_ps(s);
+    for (size_t i = 0; i < n; i += 8)
+        _mm256_store_ps(o + i, _mm256_mul_ps(_mm256_load_ps(a + i), vs));
+}
+
+VECTOR_TARGET_AVX2 static void laneLerp_avx2(const float* a, const float* b, float t, float* o, size_t n)
+{
+    const __m256 vt = _mm256_set1_ps(t);
+    for (size_t i = 0; i < n; i += 8)
+    {
+        const __m256 va = _mm256_load_ps(a + i);
+        _mm256_store_ps(o + i, _mm256_add_ps(va, _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(b + i), va), vt)));
+    }
+}
+
+//**********************************************************************
+//* Multi-lane kernels
+//**********************************************************************
+// Dot products write to a caller provided array, so they process the exact
+// count and return how many elements were done.
+
+VECTOR_TARGET_SSE41 static size_t dot3_sse41(const Vec3fSoA& a, const Vec3fSoA& b, float* o, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 r = _mm_mul_ps(_mm_load_ps(a.x + i), _mm_load_ps(b.x + i));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(a.y + i), _mm_load_ps(b.y + i)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(a.z + i), _mm_load_ps(b.z + i)));
+        _mm_storeu_ps(o + i, r);
+    }
+    return i;
+}
+
+VECTOR_TARGET_SSE41 static size_t dot4_sse41(const Vec4fSoA& a, const Vec4fSoA& b, float* o, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 r = _mm_mul_ps(_mm_load_ps(a.x + i), _mm_load_ps(b.x + i));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(a.y + i), _mm_load_ps(b.y + i)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(a.z + i), _mm_load_ps(b.z + i)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(a.w + i), _mm_load_ps(b.w + i)));
+        _mm_storeu_ps(o + i, r);
+    }
+    return i;
+}
+
+VECTOR_TARGET_SSE41 static void cross_sse41(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& o, size_t n)
+{
+    for (size_t i = 0; i < n; i += 4)
+    {
+        const __m128 ax = _mm_load_ps(a.x + i), ay = _mm_load_ps(a.y + i), az = _mm_load_ps(a.z + i);
+        const __m128 bx = _mm_load_ps(b.x + i), by = _mm_load_ps(b.y + i), bz = _mm_load_ps(b.z + i);
+        _mm_store_ps(o.x + i, _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+        _mm_store_ps(o.y + i, _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+        _mm_store_ps(o.z + i, _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+    }
+}
+
+VECTOR_TARGET_AVX2 static size_t dot3_avx2(const Vec3fSoA& a, const Vec3fSoA& b, float* o, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 r = _mm256_mul_ps(_mm256_load_ps(a.x + i), _mm256_load_ps(b.x + i));
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_load_ps(a.y + i), _mm256_load_ps(b.y + i)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_load_ps(a.z + i), _mm256_load_ps(b.z + i)));
+        _mm256_storeu_ps(o + i, r);
+    }
+    return i;
+}
+
+VECTOR_TARGET_AVX2 static size_t dot4_avx2(const Vec4fSoA& a, const Vec4fSoA& b, float* o, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 r = _mm256_mul_ps(_mm256_load_ps(a.x + i), _mm256_load_ps(b.x + i));
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_load_ps(a.y + i), _mm256_load_ps(b.y + i)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_load_ps(a.z + i), _mm256_load_ps(b.z + i)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_load_ps(a.w + i), _mm256_load_ps(b.w + i)));
+        _mm256_storeu_ps(o + i, r);
+    }
+    return i;
+}
+
+VECTOR_TARGET_AVX2 static void cross_avx2(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& o, size_t n)
+{
+    for (size_t i = 0; i < n; i += 8)
+    {
+        const __m256 ax = _mm256_load_ps(a.x + i), ay = _mm256_load_ps(a.y + i), az = _mm256_load_ps(a.z + i);
+        const __m256 bx = _mm256_load_ps(b.x + i), by = _mm256_load_ps(b.y + i), bz = _mm256_load_ps(b.z + i);
+        _mm256_store_ps(o.x + i, _mm256_sub_ps(_mm256_mul_ps(ay, bz), _mm256_mul_ps(az, by)));
+        _mm256_store_ps(o.y + i, _mm256_sub_ps(_mm256_mul_ps(az, bx), _mm256_mul_ps(ax, bz)));
+        _mm256_store_ps(o.z + i, _mm256_sub_ps(_mm256_mul_ps(ax, by), _mm256_mul_ps(ay, bx)));
+    }
+}
+
+#endif // VECTOR_X86_SIMD
+
+//**********************************************************************
+//* Dispatch helpers
+//**********************************************************************
+enum class LaneOp { Add, Sub, Min, Max };
+
+static void laneBinary(LaneOp op, const float* a, const float* b, float* o, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+    {
+        switch (op)
+        {
+        case LaneOp::Add: return laneAdd_avx2(a, b, o, n);
+        case LaneOp::Sub: return laneSub_avx2(a, b, o, n);
+        case LaneOp::Min: return laneMin_avx2(a, b, o, n);
+        case LaneOp::Max: return laneMax_avx2(a, b, o, n);
+        }
+    }
+    else if (level == SimdLevel::SSE41)
+    {
+        switch (op)
+        {
+        case LaneOp::Add: return laneAdd_sse41(a, b, o, n);
+        case LaneOp::Sub: return laneSub_sse41(a, b, o, n);
+        case LaneOp::Min: return laneMin_sse41(a, b, o, n);
+        case LaneOp::Max: return laneMax_sse41(a, b, o, n);
+        }
+    }
+#endif
+    switch (op)
+    {
+    case LaneOp::Add: for (size_t i = 0; i < n; i++) o[i] = a[i] + b[i]; break;
+    case LaneOp::Sub: for (size_t i = 0; i < n; i++) o[i] = a[i] - b[i]; break;
+    case LaneOp::Min: for (size_t i = 0; i < n; i++) o[i] = a[i] < b[i] ? a[i] : b[i]; break;
+    case LaneOp::Max: for (size_t i = 0; i < n; i++) o[i] = a[i] > b[i] ? a[i] : b[i]; break;
+    }
+}
+
+static void laneScale(const float* a, float s, float* o, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+        return laneScale_avx2(a, s, o, n);
+    if (level == SimdLevel::SSE41)
+        return laneScale_sse41(a, s, o, n);
+#endif
+    for (size_t i = 0; i < n; i++)
+        o[i] = a[i] * s;
+}
+
+static void laneLerp(const float* a, const float* b, float t, float* o, size_t n)
+{
+#ifdef VECTOR_X86_SIMD
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+        return laneLerp_avx2(a, b, t, o, n);
+    if (level == SimdLevel::SSE41)
+        return laneLerp_sse41(a, b, t, o, n);
+#endif
+    for (size_t i = 0; i < n; i++)
+        o[i] = a[i] + (b[i] - a[i]) * t;
+}
+
+//**********************************************************************
+//* Repacking
+//**********************************************************************
+void RepackToSoA(const Vec3f* in, float* x, float* y, float* z, size_t n)
+{
+    size_t i = 0;
+#ifdef VECTOR_X86_SIMD
+    const float* p = reinterpret_cast<const float*>(in);
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+        i = repackToSoA3_avx2(p, x, y, z, n);
+    else if (level == SimdLevel::SSE41)
+        i = repackToSoA3_sse41(p, x, y, z, n);
+#endif
+    for (; i < n; i++)
+    {
+        x[i] = in[i].x;
+        y[i] = in[i].y;
+        z[i] = in[i].z;
+    }
+}
+
+void RepackToAoS(const float* x, const float* y, const float* z, Vec3f* out, size_t n)
+{
+    size_t i = 0;
+#ifdef VECTOR_X86_SIMD
+    float* p = reinterpret_cast<float*>(out);
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+        i = repackToAoS3_avx2(x, y, z, p, n);
+    else if (level == SimdLevel::SSE41)
+        i = repackToAoS3_sse41(x, y, z, p, n);
+#endif
+    for (; i < n; i++)
+        out[i] = Vec3f(x[i], y[i], z[i]);
+}
+
+void RepackToSoA(const Vec4f* in, float* x, float* y, float* z, float* w, size_t n)
+{
+    size_t i = 0;
+#ifdef VECTOR_X86_SIMD
+    const float* p = reinterpret_cast<const float*>(in);
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+        i = repackToSoA4_avx2(p, x, y, z, w, n);
+    else if (level == SimdLevel::SSE41)
+        i = repackToSoA4_sse41(p, x, y, z, w, n);
+#endif
+    for (; i < n; i++)
+    {
+        x[i] = in[i].x;
+        y[i] = in[i].y;
+        z[i] = in[i].z;
+        w[i] = in[i].w;
+    }
+}
+
+void RepackToAoS(const float* x, const float* y, const float* z, const float* w, Vec4f* out, size_t n)
+{
+    size_t i = 0;
+#ifdef VECTOR_X86_SIMD
+    float* p = reinterpret_cast<float*>(out);
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+        i = repackToAoS4_avx2(x, y, z, w, p, n);
+    else if (level == SimdLevel::SSE41)
+        i = repackToAoS4_sse41(x, y, z, w, p, n);
+#endif
+    for (; i < n; i++)
+        out[i] = Vec4f(x[i], y[i], z[i], w[i]);
+}
+
+//**********************************************************************
+//* Vec3fSoA arithmetic
+//**********************************************************************
+void Add(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec3fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneBinary(LaneOp::Add, a.x, b.x, out.x, n);
+    laneBinary(LaneOp::Add, a.y, b.y, out.y, n);
+    laneBinary(LaneOp::Add, a.z, b.z, out.z, n);
+}
+
+void Sub(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec3fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneBinary(LaneOp::Sub, a.x, b.x, out.x, n);
+    laneBinary(LaneOp::Sub, a.y, b.y, out.y, n);
+    laneBinary(LaneOp::Sub, a.z, b.z, out.z, n);
+}
+
+void Scale(const Vec3fSoA& a, float s, Vec3fSoA& out)
+{
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneScale(a.x, s, out.x, n);
+    laneScale(a.y, s, out.y, n);
+    laneScale(a.z, s, out.z, n);
+}
+
+void Dot(const Vec3fSoA& a, const Vec3fSoA& b, float* out)
+{
+    assert(a.Size() == b.Size() && "Vec3fSoA: size mismatch");
+    const size_t n = a.Size();
+    size_t i = 0;
+#ifdef VECTOR_X86_SIMD
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+        i = dot3_avx2(a, b, out, n);
+    else if (level == SimdLevel::SSE41)
+        i = dot3_sse41(a, b, out, n);
+#endif
+    for (; i < n; i++)
+        out[i] = a.x[i]*b.x[i] + a.y[i]*b.y[i] + a.z[i]*b.z[i];
+}
+
+void CrossProduct(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec3fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+#ifdef VECTOR_X86_SIMD
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+        return cross_avx2(a, b, out, n);
+    if (level == SimdLevel::SSE41)
+        return cross_sse41(a, b, out, n);
+#endif
+    for (size_t i = 0; i < n; i++)
+    {
+        const float cx = a.y[i]*b.z[i] - a.z[i]*b.y[i];
+        const float cy = a.z[i]*b.x[i] - a.x[i]*b.z[i];
+        const float cz = a.x[i]*b.y[i] - a.y[i]*b.x[i];
+        out.x[i] = cx;
+        out.y[i] = cy;
+        out.z[i] = cz;
+    }
+}
+
+void Lerp(const Vec3fSoA& a, const Vec3fSoA& b, float t, Vec3fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec3fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneLerp(a.x, b.x, t, out.x, n);
+    laneLerp(a.y, b.y, t, out.y, n);
+    laneLerp(a.z, b.z, t, out.z, n);
+}
+
+void min(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec3fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneBinary(LaneOp::Min, a.x, b.x, out.x, n);
+    laneBinary(LaneOp::Min, a.y, b.y, out.y, n);
+    laneBinary(LaneOp::Min, a.z, b.z, out.z, n);
+}
+
+void max(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec3fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneBinary(LaneOp::Max, a.x, b.x, out.x, n);
+    laneBinary(LaneOp::Max, a.y, b.y, out.y, n);
+    laneBinary(LaneOp::Max, a.z, b.z, out.z, n);
+}
+
+//**********************************************************************
+//* Vec4fSoA arithmetic
+//**********************************************************************
+void Add(const Vec4fSoA& a, const Vec4fSoA& b, Vec4fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec4fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneBinary(LaneOp::Add, a.x, b.x, out.x, n);
+    laneBinary(LaneOp::Add, a.y, b.y, out.y, n);
+    laneBinary(LaneOp::Add, a.z, b.z, out.z, n);
+    laneBinary(LaneOp::Add, a.w, b.w, out.w, n);
+}
+
+void Sub(const Vec4fSoA& a, const Vec4fSoA& b, Vec4fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec4fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneBinary(LaneOp::Sub, a.x, b.x, out.x, n);
+    laneBinary(LaneOp::Sub, a.y, b.y, out.y, n);
+    laneBinary(LaneOp::Sub, a.z, b.z, out.z, n);
+    laneBinary(LaneOp::Sub, a.w, b.w, out.w, n);
+}
+
+void Scale(const Vec4fSoA& a, float s, Vec4fSoA& out)
+{
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneScale(a.x, s, out.x, n);
+    laneScale(a.y, s, out.y, n);
+    laneScale(a.z, s, out.z, n);
+    laneScale(a.w, s, out.w, n);
+}
+
+void Dot(const Vec4fSoA& a, const Vec4fSoA& b, float* out)
+{
+    assert(a.Size() == b.Size() && "Vec4fSoA: size mismatch");
+    const size_t n = a.Size();
+    size_t i = 0;
+#ifdef VECTOR_X86_SIMD
+    const SimdLevel level = SimdActiveLevel();
+    if (level >= SimdLevel::AVX2)
+        i = dot4_avx2(a, b, out, n);
+    else if (level == SimdLevel::SSE41)
+        i = dot4_sse41(a, b, out, n);
+#endif
+    for (; i < n; i++)
+        out[i] = a.x[i]*b.x[i] + a.y[i]*b.y[i] + a.z[i]*b.z[i] + a.w[i]*b.w[i];
+}
+
+void Lerp(const Vec4fSoA& a, const Vec4fSoA& b, float t, Vec4fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec4fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneLerp(a.x, b.x, t, out.x, n);
+    laneLerp(a.y, b.y, t, out.y, n);
+    laneLerp(a.z, b.z, t, out.z, n);
+    laneLerp(a.w, b.w, t, out.w, n);
+}
+
+void min(const Vec4fSoA& a, const Vec4fSoA& b, Vec4fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec4fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneBinary(LaneOp::Min, a.x, b.x, out.x, n);
+    laneBinary(LaneOp::Min, a.y, b.y, out.y, n);
+    laneBinary(LaneOp::Min, a.z, b.z, out.z, n);
+    laneBinary(LaneOp::Min, a.w, b.w, out.w, n);
+}
+
+void max(const Vec4fSoA& a, const Vec4fSoA& b, Vec4fSoA& out)
+{
+    assert(a.Size() == b.Size() && "Vec4fSoA: size mismatch");
+    out.Resize(a.Size());
+    const size_t n = paddedSize(a.Size());
+    laneBinary(LaneOp::Max, a.x, b.x, out.x, n);
+    laneBinary(LaneOp::Max, a.y, b.y, out.y, n);
+    laneBinary(LaneOp::Max, a.z, b.z, out.z, n);
+    laneBinary(LaneOp::Max, a.w, b.w, out.w, n);
+}
@@ -0,0 +1,169 @@
+/**
+ * @file: BenchUtil.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+#include "Simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define VECTOR_BENCH_TSC
+#endif
+
+#ifndef VECTOR_BENCH_BUILD_TYPE
+#define VECTOR_BENCH_BUILD_TYPE ""
+#endif
+
+//**********************************************************************
+//* Helpers shared by the benchmark programs
+//**********************************************************************
+
+/**
+ * @brief xorshift32, reproducible across runs and platforms
+ */
+inline uint32_t& RandState()
+{
+    static uint32_t state = 0x12345678;
+    return state;
+}
+
+inline uint32_t Rand()
+{
+    uint32_t& s = RandState();
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+/** @brief Uniform float in [-1, 1). */
+inline float RandFloat()
+{
+    return static_cast<int32_t>(Rand()) * (1.0f / 2147483648.0f);
+}
+
+/** @brief Time stamp counter, 0 where there is none. */
+inline uint64_t Ticks()
+{
+#ifdef VECTOR_BENCH_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Median of several timed samples
+ */
+struct Timing
+{
+    double ns;      // Duration of the median sample
+    uint64_t ticks; // TSC ticks of the same sample
+    size_t reps;    // Calls per sample
+};
+
+/**
+ * @brief Time repeated calls of run. The number of calls per sample is
+ *        calibrated so each sample takes a few milliseconds.
+ *
+ * @param run   Operation to time
+ * @param quick Shorter and fewer samples
+ * @return Timing Median sample
+ */
+template <class F>
+Timing TimeRuns(F&& run, bool quick)
+{
+    typedef std::chrono::steady_clock Clock;
+    const double target = quick ? 1e6 : 5e6; // ns per sample
+    const int samples = quick ? 3 : 7;
+
+    // Warm up, then find how many repetitions fill a sample
+    run();
+    size_t reps = 1;
+    for (;;)
+    {
+        const Clock::time_point t0 = Clock::now();
+        for (size_t r = 0; r < reps; r++)
+            run();
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+        if (ns >= target || reps >= (size_t(1) << 30))
+            break;
+        reps = ns < target / 64 ? reps * 16 : reps * 2;
+    }
+
+    std::vector<std::pair<double, uint64_t>> t(samples);
+    for (int s = 0; s < samples; s++)
+    {
+        const uint64_t c0 = Ticks();
+        const Clock::time_point t0 = Clock::now();
+        for (size_t r = 0; r < reps; r++)
+            run();
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+        t[s] = {ns, Ticks() - c0};
+    }
+    std::sort(t.begin(), t.end());
+    return {t[samples / 2].first, t[samples / 2].second, reps};
+}
+
+inline const char* CompilerName()
+{
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+/** @brief Build and host description fields of the JSON reports. */
+inline void WriteBuildInfo(FILE* f)
+{
+    fprintf(f, "  \"build_type\": \"%s\",\n", VECTOR_BENCH_BUILD_TYPE);
+#ifdef __OPTIMIZE__
+    fprintf(f, "  \"optimized\": true,\n");
+#else
+    fprintf(f, "  \"optimized\": false,\n");
+#endif
+    fprintf(f, "  \"compiler\": \"%s\",\n", CompilerName());
+    fprintf(f, "  \"host_simd\": \"%s\",\n", SimdLevelName(SimdHostLevel()));
+}
+
+/** @brief JSON number, or null for negative values (not applicable). */
+inline void PrintNumber(FILE* f, double v)
+{
+    if (v < 0)
+        fputs("null", f);
+    else
+        fprintf(f, "%.6g", v);
+}
+
+#endif // BENCH_UTIL_H
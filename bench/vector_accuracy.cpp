@@ -0,0 +1,915 @@
+/**
+ * @file: vector_accuracy.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+//**********************************************************************
+//* vector_accuracy
+//**********************************************************************
+// Error of every fast path against a long double reference, next to its
+// throughput. Each case runs at every SIMD level for the kernels that follow
+// SimdSetLevel(), and once as the "inline" backend for code fixed at compile
+// time. The reference is computed from the same float inputs, so it measures
+// the error of the kernel alone.
+//
+// Input sets:
+//  - random:        uniform in [-1, 1)
+//  - wide:          random signs and significands, exponents spread over
+//                   the range where the kernel cannot overflow
+//  - huge / tiny:   every input at the largest / smallest power of two for
+//                   which the kernel's intermediate products stay normal
+//  - near_singular: matrices whose third row is almost a combination of the
+//                   first two (matrix inverse and determinant only)
+//
+// Reported for each case, backend and input set:
+//  - max_ulp / mean_ulp: error of each output component in ulp of the
+//                        reference component. Large on components that
+//                        cancel to near zero, for every kernel alike
+//  - max_normwise_ulp:   error in ulp of the largest reference component of
+//                        the same vector or matrix row. This is the number
+//                        to compare kernels with
+//  - nonfinite:          outputs that are inf or NaN with a finite reference
+//  - mismatches:         for inline operators with a plain float version
+//                        of the same arithmetic, elements whose bits differ
+//                        from it. Checked at every level; any mismatch makes
+//                        the program exit with status 1
+//  - ns_per_op:          time per element, measured on the random set
+//
+// With --tolerance=ULP, the fastest case of each operation whose
+// max_normwise_ulp over every input set is within ULP is listed as
+// "selection" (JSON) and printed to stderr.
+//
+// Usage: vector_accuracy [--format=json|csv] [--out=FILE] [--filter=TEXT]
+//                        [--tolerance=ULP] [--count=N] [--quick]
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Vector.h"
+#include "Mat3.h"
+#include "Mat4.h"
+#include "Mat3x4.h"
+#include "Quat.h"
+#include "BatchTransform.h"
+#include "VectorBatch.h"
+#include "Simd.h"
+#include "BenchUtil.h"
+
+//**********************************************************************
+//* Inputs
+//**********************************************************************
+enum InputSet
+{
+    Random,
+    Wide,
+    Huge,
+    Tiny,
+    NearSingular,
+    InputSetCount
+};
+
+static const char* const inputSetNames[InputSetCount] = {
+    "random", "wide", "huge", "tiny", "near_singular"
+};
+
+/**
+ * @brief Largest exponent e such that products of degree inputs of
+ *        magnitude 2^e (and sums of a few of them) stay finite
+ */
+static int EdgeExponent(int degree)
+{
+    return 126 / degree - 3;
+}
+
+/** @brief Random sign and significand in [1, 2) times 2^e. */
+static float RandScaled(int e)
+{
+    const uint32_t r = Rand();
+    const float m = 1.0f + (r >> 9) * (1.0f / 8388608.0f);
+    return ldexpf(r & 1 ? -m : m, e);
+}
+
+/**
+ * @brief Input value for a set
+ *
+ * @param set    Input set
+ * @param degree Polynomial degree of the kernel in its inputs
+ */
+static float Generate(InputSet set, int degree)
+{
+    const int edge = EdgeExponent(degree);
+    switch (set)
+    {
+    case Wide:
+        return RandScaled(static_cast<int>(Rand() % (edge + 1)) - edge / 2);
+    case Huge:
+        return RandScaled(edge);
+    case Tiny:
+        return RandScaled(-edge);
+    default:
+        return RandFloat();
+    }
+}
+
+/**
+ * @brief Make the third row of each dim x dim matrix almost a linear
+ *        combination of the first two
+ */
+static void MakeNearSingular(float* m, size_t count, int dim)
+{
+    for (size_t i = 0; i < count; i++, m += dim * dim)
+    {
+        const float a = RandFloat();
+        const float b = RandFloat();
+        for (int c = 0; c < dim; c++)
+            m[2 * dim + c] = a * m[c] + b * m[dim + c] + 1e-4f * RandFloat();
+    }
+}
+
+//**********************************************************************
+//* Long double reference
+//**********************************************************************
+typedef long double Real;
+
+/** @brief C = A * B for row-major dim x dim matrices. */
+static void RefMultiply(const Real* A, const Real* B, Real* C, int dim)
+{
+    for (int r = 0; r < dim; r++)
+        for (int c = 0; c < dim; c++)
+        {
+            Real s = 0;
+            for (int k = 0; k < dim; k++)
+                s += A[r * dim + k] * B[k * dim + c];
+            C[r * dim + c] = s;
+        }
+}
+
+/**
+ * @brief Gauss-Jordan elimination with partial pivoting
+ *
+ * @param m   Row-major dim x dim matrix
+ * @param inv Output inverse. Zero matrix if m is singular. May be nullptr
+ * @return Real Determinant
+ */
+static Real RefInverse(const float* m, int dim, Real* inv)
+{
+    Real a[4][8];
+    for (int r = 0; r < dim; r++)
+        for (int c = 0; c < dim; c++)
+        {
+            a[r][c] = m[r * dim + c];
+            a[r][dim + c] = r == c ? 1 : 0;
+        }
+
+    Real det = 1;
+    for (int c = 0; c < dim; c++)
+    {
+        int p = c;
+        for (int r = c + 1; r < dim; r++)
+            if (fabsl(a[r][c]) > fabsl(a[p][c]))
+                p = r;
+        if (a[p][c] == 0)
+        {
+            if (inv)
+                for (int i = 0; i < dim * dim; i++)
+                    inv[i] = 0;
+            return 0;
+        }
+        if (p != c)
+        {
+            for (int k = 0; k < 2 * dim; k++)
+                std::swap(a[p][k], a[c][k]);
+            det = -det;
+        }
+        det *= a[c][c];
+        const Real pivot = a[c][c];
+        for (int k = 0; k < 2 * dim; k++)
+            a[c][k] /= pivot;
+        for (int r = 0; r < dim; r++)
+        {
+            if (r == c)
+                continue;
+            const Real f = a[r][c];
+            for (int k = 0; k < 2 * dim; k++)
+                a[r][k] -= f * a[c][k];
+        }
+    }
+    if (inv)
+        for (int r = 0; r < dim; r++)
+            for (int c = 0; c < dim; c++)
+                inv[r * dim + c] = a[r][dim + c];
+    return det;
+}
+
+/** @brief out = (v, w) * m for a row-major 4x4 matrix. */
+static void RefTransform(const float* v, Real w, const float* m, Real* out, int outCount)
+{
+    for (int c = 0; c < outCount; c++)
+        out[c] = static_cast<Real>(v[0]) * m[c] + static_cast<Real>(v[1]) * m[4 + c]
+               + static_cast<Real>(v[2]) * m[8 + c] + w * m[12 + c];
+}
+
+/** @brief Mat3x4 storage expanded to a row-major 4x4 matrix. */
+static void Expand3x4(const float* s, Real* m)
+{
+    // Stored row i is column i of the equivalent Mat4
+    for (int r = 0; r < 4; r++)
+        for (int c = 0; c < 4; c++)
+            m[r * 4 + c] = c < 3 ? s[c * 4 + r] : (r == 3 ? 1 : 0);
+}
+
+static void RefNlerp(const float* a, const float* b, Real t, Real* out)
+{
+    Real d = 0;
+    for (int k = 0; k < 4; k++)
+        d += static_cast<Real>(a[k]) * b[k];
+    const Real wb = d < 0 ? -t : t;
+    Real len = 0;
+    for (int k = 0; k < 4; k++)
+    {
+        out[k] = a[k] * (1 - t) + b[k] * wb;
+        len += out[k] * out[k];
+    }
+    len = sqrtl(len);
+    for (int k = 0; k < 4; k++)
+        out[k] /= len;
+}
+
+static void RefSlerp(const float* a, const float* b, Real t, Real* out)
+{
+    Real d = 0;
+    for (int k = 0; k < 4; k++)
+        d += static_cast<Real>(a[k]) * b[k];
+    const Real sign = d < 0 ? -1 : 1;
+    d = fminl(d * sign, 1);
+    const Real theta = acosl(d);
+    if (theta < 1e-9L)
+        return RefNlerp(a, b, t, out);
+    const Real wa = sinl((1 - t) * theta) / sinl(theta);
+    const Real wb = sinl(t * theta) / sinl(theta) * sign;
+    for (int k = 0; k < 4; k++)
+        out[k] = a[k] * wa + b[k] * wb;
+}
+
+//**********************************************************************
+//* Cases
+//**********************************************************************
+static const Real lerpT = 0.3L;
+
+/**
+ * @brief One kernel checked against the reference. Inputs and outputs are
+ *        flat float arrays reinterpreted as the kernel's types.
+ */
+struct AccuracyCase
+{
+    const char* name;
+    const char* op;     // Cases with the same op compute the same thing
+    bool dispatched;    // Follows SimdSetLevel(), checked at every level
+    int degree;         // Polynomial degree in the inputs. 0 for the random set only
+    int matrixDim;      // Dimension of square matrix inputs for the near singular set, else 0
+    size_t aFloats;     // Floats per element of input a
+    size_t bFloats;     // Floats per element of input b, 0 if unused
+    bool bBroadcast;    // b is a single operand for all the elements
+    size_t outFloats;   // Floats per output element
+    size_t group;       // Consecutive output components sharing one scale
+    bool splitLast;     // Last output component of every element stored after all the others
+    void (*prepare)(float* a, float* b, size_t n); // Input fixups. May be nullptr
+    void (*run)(const float* a, const float* b, float* out, size_t n);
+    void (*ref)(const float* a, const float* b, Real* out); // One element
+    void (*exact)(const float* a, const float* b, float* out) = nullptr; // Bit exact version of run, one element. May be nullptr
+};
+
+template <class T>
+static const T* As(const float* p) { return reinterpret_cast<const T*>(p); }
+
+template <class T>
+static T* As(float* p) { return reinterpret_cast<T*>(p); }
+
+static void RefMat4Multiply(const float* a, const float* b, Real* out)
+{
+    Real A[16], B[16];
+    for (int i = 0; i < 16; i++)
+    {
+        A[i] = a[i];
+        B[i] = b[i];
+    }
+    RefMultiply(A, B, out, 4);
+}
+
+static void RefMat3x4Multiply(const float* a, const float* b, Real* out)
+{
+    Real A[16], B[16], C[16];
+    Expand3x4(a, A);
+    Expand3x4(b, B);
+    RefMultiply(A, B, C, 4);
+    for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 4; c++)
+            out[r * 4 + c] = C[c * 4 + r];
+}
+
+// Scalar code of the operators, in the order of their SIMD kernels
+static void ExactMat4Multiply(const float* a, const float* b, float* out)
+{
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            out[i * 4 + j] = (a[i * 4] * b[j] + a[i * 4 + 1] * b[4 + j]) + (a[i * 4 + 2] * b[8 + j] + a[i * 4 + 3] * b[12 + j]);
+}
+
+static void ExactMat3x4Multiply(const float* a, const float* b, float* out)
+{
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 4; j++)
+            out[i * 4 + j] = (b[i * 4] * a[j] + b[i * 4 + 1] * a[4 + j]) + (b[i * 4 + 2] * a[8 + j] + (j == 3 ? b[i * 4 + 3] : 0.0f));
+}
+
+static void ExactVec4fMultiplyMat4(const float* a, const float* b, float* out)
+{
+    for (int j = 0; j < 4; j++)
+        out[j] = (a[0] * b[j] + a[1] * b[4 + j]) + (a[2] * b[8 + j] + a[3] * b[12 + j]);
+}
+
+static void RefNormalize(const float* a, const float*, Real* out)
+{
+    const Real len = sqrtl(static_cast<Real>(a[0]) * a[0] + static_cast<Real>(a[1]) * a[1] + static_cast<Real>(a[2]) * a[2]);
+    for (int k = 0; k < 3; k++)
+        out[k] = a[k] / len;
+}
+
+static void RefLength(const float* a, const float*, Real* out)
+{
+    out[0] = sqrtl(static_cast<Real>(a[0]) * a[0] + static_cast<Real>(a[1]) * a[1] + static_cast<Real>(a[2]) * a[2]);
+}
+
+static void PrepareAffine(float* a, float*, size_t n)
+{
+    for (size_t i = 0; i < n; i++, a += 16)
+    {
+        a[3] = a[7] = a[11] = 0.0f;
+        a[15] = 1.0f;
+    }
+}
+
+static void PrepareAffineOperand(float*, float* b, size_t)
+{
+    PrepareAffine(b, nullptr, 1);
+}
+
+static void PrepareQuats(float* a, float* b, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        As<Quat>(a)[i].Normalize();
+        As<Quat>(b)[i].Normalize();
+    }
+}
+
+static const Mat4 projection = Mat4::Projection(640.0f, 480.0f, 500.0f);
+static const Viewport screen(0.0f, 0.0f, 640.0f, 480.0f);
+
+static void PrepareProject(float* a, float* b, size_t n)
+{
+    // Points in front of the camera, w = z in [1, 10]
+    for (size_t i = 0; i < n; i++)
+        a[3 * i + 2] = 5.5f + 4.5f * RandFloat();
+    memcpy(b, &projection, sizeof(Mat4));
+}
+
+static void RefProject(const float* a, const float* b, Real* out)
+{
+    Real clip[4];
+    RefTransform(a, 1, b, clip, 4);
+    out[0] = clip[0] / clip[3] * screen.scaleX + screen.offsetX;
+    out[1] = clip[1] / clip[3] * screen.scaleY + screen.offsetY;
+    out[2] = 1 / clip[3];
+}
+
+static std::vector<AccuracyCase> BuildCases()
+{
+    return {
+        //* Matrix products
+        {"Mat4.Multiply", "Mat4*Mat4", false, 2, 0, 16, 16, false, 16, 4, false, nullptr,
+            [](const float* a, const float* b, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    As<Mat4>(out)[i] = As<Mat4>(a)[i] * As<Mat4>(b)[i];
+            }, RefMat4Multiply, ExactMat4Multiply},
+        {"MultiplyBatch.Mat4", "Mat4*Mat4", true, 2, 0, 16, 16, false, 16, 4, false, nullptr,
+            [](const float* a, const float* b, float* out, size_t n) { MultiplyBatch(As<Mat4>(a), As<Mat4>(b), As<Mat4>(out), n); },
+            RefMat4Multiply},
+        {"Mat3x4.Multiply", "Mat3x4*Mat3x4", false, 2, 0, 12, 12, false, 12, 4, false, nullptr,
+            [](const float* a, const float* b, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    As<Mat3x4>(out)[i] = As<Mat3x4>(a)[i] * As<Mat3x4>(b)[i];
+            }, RefMat3x4Multiply, ExactMat3x4Multiply},
+        {"MultiplyBatch.Mat3x4", "Mat3x4*Mat3x4", true, 2, 0, 12, 12, false, 12, 4, false, nullptr,
+            [](const float* a, const float* b, float* out, size_t n) { MultiplyBatch(As<Mat3x4>(a), As<Mat3x4>(b), As<Mat3x4>(out), n); },
+            RefMat3x4Multiply},
+
+        //* Inverse and determinant
+        {"Mat4.Inverse", "Mat4.Inverse", true, 4, 4, 16, 0, false, 16, 16, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    As<Mat4>(out)[i] = As<Mat4>(a)[i].Inverse();
+            },
+            [](const float* a, const float*, Real* out) { RefInverse(a, 4, out); }},
+        {"Mat4.Inverse.Affine", "Mat4.InverseAffine", true, 4, 4, 16, 0, false, 16, 16, false, PrepareAffine,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    As<Mat4>(out)[i] = As<Mat4>(a)[i].Inverse();
+            },
+            [](const float* a, const float*, Real* out) { RefInverse(a, 4, out); }},
+        {"Mat4.InverseAffine", "Mat4.InverseAffine", false, 4, 4, 16, 0, false, 16, 16, false, PrepareAffine,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    As<Mat4>(out)[i] = As<Mat4>(a)[i].InverseAffine();
+            },
+            [](const float* a, const float*, Real* out) { RefInverse(a, 4, out); }},
+        {"Mat4.Determinant", "Mat4.Determinant", false, 4, 4, 16, 0, false, 1, 1, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = As<Mat4>(a)[i].Determinant();
+            },
+            [](const float* a, const float*, Real* out) { out[0] = RefInverse(a, 4, nullptr); }},
+        {"Mat4.Inverse.Determinant", "Mat4.Determinant", true, 4, 4, 16, 0, false, 1, 1, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    As<Mat4>(a)[i].Inverse(&out[i]);
+            },
+            [](const float* a, const float*, Real* out) { out[0] = RefInverse(a, 4, nullptr); }},
+        {"Mat3.Inverse", "Mat3.Inverse", false, 3, 3, 9, 0, false, 9, 9, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    As<Mat3>(out)[i] = As<Mat3>(a)[i].Inverse();
+            },
+            [](const float* a, const float*, Real* out) { RefInverse(a, 3, out); }},
+        {"Mat3.Determinant", "Mat3.Determinant", false, 3, 3, 9, 0, false, 1, 1, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = As<Mat3>(a)[i].Determinant();
+            },
+            [](const float* a, const float*, Real* out) { out[0] = RefInverse(a, 3, nullptr); }},
+
+        //* Normalize and length
+        {"Vec3f.Normalize.Exact", "Normalize", false, 2, 0, 3, 0, false, 3, 3, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    (As<Vec3f>(out)[i] = As<Vec3f>(a)[i]).Normalize<Precision::Exact>();
+            }, RefNormalize},
+        {"Vec3f.Normalize.Fast", "Normalize", false, 2, 0, 3, 0, false, 3, 3, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    (As<Vec3f>(out)[i] = As<Vec3f>(a)[i]).Normalize<Precision::Fast>();
+            }, RefNormalize},
+        {"Vec3f.Normalize.VeryFast", "Normalize", false, 2, 0, 3, 0, false, 3, 3, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    (As<Vec3f>(out)[i] = As<Vec3f>(a)[i]).Normalize<Precision::VeryFast>();
+            }, RefNormalize},
+        {"NormalizeBatch.Exact", "Normalize", true, 2, 0, 3, 0, false, 3, 3, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) { NormalizeBatch<Precision::Exact>(As<Vec3f>(a), As<Vec3f>(out), n); },
+            RefNormalize},
+        {"NormalizeBatch.Fast", "Normalize", true, 2, 0, 3, 0, false, 3, 3, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) { NormalizeBatch<Precision::Fast>(As<Vec3f>(a), As<Vec3f>(out), n); },
+            RefNormalize},
+        {"NormalizeBatch.VeryFast", "Normalize", true, 2, 0, 3, 0, false, 3, 3, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) { NormalizeBatch<Precision::VeryFast>(As<Vec3f>(a), As<Vec3f>(out), n); },
+            RefNormalize},
+        {"Vec3f.Length", "Length", false, 2, 0, 3, 0, false, 1, 1, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = As<Vec3f>(a)[i].Length();
+            }, RefLength},
+        {"LengthBatch.Exact", "Length", true, 2, 0, 3, 0, false, 1, 1, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) { LengthBatch<Precision::Exact>(As<Vec3f>(a), out, n); },
+            RefLength},
+        {"LengthBatch.Fast", "Length", true, 2, 0, 3, 0, false, 1, 1, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) { LengthBatch<Precision::Fast>(As<Vec3f>(a), out, n); },
+            RefLength},
+        {"LengthBatch.VeryFast", "Length", true, 2, 0, 3, 0, false, 1, 1, false, nullptr,
+            [](const float* a, const float*, float* out, size_t n) { LengthBatch<Precision::VeryFast>(As<Vec3f>(a), out, n); },
+            RefLength},
+
+        //* Transforms. b holds the Mat4
+        {"Vec4f.MultiplyMat4", "Transform.Vec4f", false, 2, 0, 4, 16, true, 4, 4, false, nullptr,
+            [](const float* a, const float* b, float* out, size_t n) {
+                const Mat4& m = *As<Mat4>(b);
+                for (size_t i = 0; i < n; i++)
+                    As<Vec4f>(out)[i] = As<Vec4f>(a)[i] * m;
+            },
+            [](const float* a, const float* b, Real* out) { RefTransform(a, a[3], b, out, 4); }, ExactVec4fMultiplyMat4},
+        {"TransformBatch.Vec4f", "Transform.Vec4f", true, 2, 0, 4, 16, true, 4, 4, false, nullptr,
+            [](const float* a, const float* b, float* out, size_t n) { TransformBatch(*As<Mat4>(b), As<Vec4f>(a), As<Vec4f>(out), n); },
+            [](const float* a, const float* b, Real* out) { RefTransform(a, a[3], b, out, 4); }},
+        {"TransformPointBatch.Vec3f", "TransformPoint", true, 2, 0, 3, 16, true, 3, 3, false, PrepareAffineOperand,
+            [](const float* a, const float* b, float* out, size_t n) { TransformPointBatch(*As<Mat4>(b), As<Vec3f>(a), As<Vec3f>(out), n); },
+            [](const float* a, const float* b, Real* out) { RefTransform(a, 1, b, out, 3); }},
+        {"TransformPointBatch.Mat3x4", "TransformPoint", true, 2, 0, 3, 16, true, 3, 3, false, PrepareAffineOperand,
+            [](const float* a, const float* b, float* out, size_t n) { TransformPointBatch(Mat3x4(*As<Mat4>(b)), As<Vec3f>(a), As<Vec3f>(out), n); },
+            [](const float* a, const float* b, Real* out) { RefTransform(a, 1, b, out, 3); }},
+        {"TransformDirectionBatch.Vec3f", "TransformDirection", true, 2, 0, 3, 16, true, 3, 3, false, nullptr,
+            [](const float* a, const float* b, float* out, size_t n) { TransformDirectionBatch(*As<Mat4>(b), As<Vec3f>(a), As<Vec3f>(out), n); },
+            [](const float* a, const float* b, Real* out) { RefTransform(a, 0, b, out, 3); }},
+        {"TransformDirectionBatch.Mat3x4", "TransformDirection", true, 2, 0, 3, 16, true, 3, 3, false, PrepareAffineOperand,
+            [](const float* a, const float* b, float* out, size_t n) { TransformDirectionBatch(Mat3x4(*As<Mat4>(b)), As<Vec3f>(a), As<Vec3f>(out), n); },
+            [](const float* a, const float* b, Real* out) { RefTransform(a, 0, b, out, 3); }},
+        {"ProjectBatch.Vec2f", "Project", true, 0, 0, 3, 16, true, 3, 1, true, PrepareProject,
+            [](const float* a, const float* b, float* out, size_t n) {
+                // Screen coordinates in the first 2n floats, invW after them
+                ProjectBatch(*As<Mat4>(b), screen, As<Vec3f>(a), As<Vec2f>(out), out + 2 * n, n);
+            }, RefProject},
+
+        //* Quaternion interpolation. a and b hold unit quaternions
+        {"Quat.Nlerp", "Nlerp", false, 0, 0, 4, 4, false, 4, 4, false, PrepareQuats,
+            [](const float* a, const float* b, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    As<Quat>(out)[i] = Nlerp(As<Quat>(a)[i], As<Quat>(b)[i], static_cast<float>(lerpT));
+            },
+            [](const float* a, const float* b, Real* out) { RefNlerp(a, b, lerpT, out); }},
+        {"NlerpBatch", "Nlerp", true, 0, 0, 4, 4, false, 4, 4, false, PrepareQuats,
+            [](const float* a, const float* b, float* out, size_t n) { NlerpBatch(As<Quat>(a), As<Quat>(b), static_cast<float>(lerpT), As<Quat>(out), n); },
+            [](const float* a, const float* b, Real* out) { RefNlerp(a, b, lerpT, out); }},
+        {"Quat.Slerp", "Slerp", false, 0, 0, 4, 4, false, 4, 4, false, PrepareQuats,
+            [](const float* a, const float* b, float* out, size_t n) {
+                for (size_t i = 0; i < n; i++)
+                    As<Quat>(out)[i] = Slerp(As<Quat>(a)[i], As<Quat>(b)[i], static_cast<float>(lerpT));
+            },
+            [](const float* a, const float* b, Real* out) { RefSlerp(a, b, lerpT, out); }},
+        {"SlerpBatch", "Slerp", true, 0, 0, 4, 4, false, 4, 4, false, PrepareQuats,
+            [](const float* a, const float* b, float* out, size_t n) { SlerpBatch(As<Quat>(a), As<Quat>(b), static_cast<float>(lerpT), As<Quat>(out), n); },
+            [](const float* a, const float* b, Real* out) { RefSlerp(a, b, lerpT, out); }},
+    };
+}
+
+//**********************************************************************
+//* Error measurement
+//**********************************************************************
+/** @brief Spacing of the floats around x. */
+static Real Ulp(Real x)
+{
+    x = fabsl(x);
+    if (x < FLT_MIN)
+        return ldexpl(1, -149);
+    if (x > FLT_MAX)
+        x = FLT_MAX;
+    int e;
+    frexpl(x, &e);
+    return ldexpl(1, e - 24);
+}
+
+struct Result
+{
+    const AccuracyCase* c;
+    const char* backend;
+    InputSet set;
+    size_t n;
+    double maxUlp;
+    double meanUlp;
+    double maxNormwiseUlp;
+    size_t nonfinite;
+    size_t mismatches;
+    double nsPerOp;
+};
+
+/**
+ * @brief Float buffer with room for the 16 byte aligned types
+ */
+struct Buffer
+{
+    explicit Buffer(size_t count) : data(static_cast<float*>(aligned_alloc(64, ((count * sizeof(float)) | 63) + 1))) {}
+    ~Buffer() { free(data); }
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    float* data;
+};
+
+/**
+ * @brief Compare the output of a case against the reference
+ */
+static void Compare(const AccuracyCase& c, const float* a, const float* b, const float* out, size_t n, Result& r)
+{
+    Real ref[16];
+    double sum = 0.0;
+    size_t count = 0;
+    r.maxUlp = 0.0;
+    r.maxNormwiseUlp = 0.0;
+    r.nonfinite = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        const float* bi = c.bBroadcast ? b : b + i * c.bFloats;
+        c.ref(a + i * c.aFloats, bi, ref);
+        for (size_t g = 0; g < c.outFloats; g += c.group)
+        {
+            Real scale = 0;
+            for (size_t k = g; k < g + c.group; k++)
+                scale = fmaxl(scale, fabsl(ref[k]));
+            const Real normUlp = Ulp(scale);
+
+            for (size_t k = g; k < g + c.group; k++)
+            {
+                const size_t packed = c.splitLast ? c.outFloats - 1 : c.outFloats;
+                const float got = k < packed ? out[i * packed + k] : out[packed * n + i];
+                if (!isfinite(got))
+                {
+                    if (!isinfl(ref[k]) || got != static_cast<float>(ref[k]))
+                        r.nonfinite++;
+                    continue;
+                }
+                const Real err = fabsl(static_cast<Real>(got) - ref[k]);
+                const double ulp = static_cast<double>(err / Ulp(ref[k]));
+                const double normwise = static_cast<double>(err / normUlp);
+                r.maxUlp = fmax(r.maxUlp, ulp);
+                r.maxNormwiseUlp = fmax(r.maxNormwiseUlp, normwise);
+                sum += ulp;
+                count++;
+            }
+        }
+    }
+    r.meanUlp = count ? sum / count : 0.0;
+
+    r.mismatches = 0;
+    if (c.exact)
+    {
+        float expected[16];
+        for (size_t i = 0; i < n; i++)
+        {
+            c.exact(a + i * c.aFloats, c.bBroadcast ? b : b + i * c.bFloats, expected);
+            if (memcmp(expected, out + i * c.outFloats, c.outFloats * sizeof(float)))
+                r.mismatches++;
+        }
+    }
+}
+
+//**********************************************************************
+//* Output
+//**********************************************************************
+struct Options
+{
+    bool csv = false;
+    bool quick = false;
+    size_t count = 4096;
+    double tolerance = -1.0;
+    const char* filter = nullptr;
+    const char* out = nullptr;
+};
+
+/** @brief Fastest result of an operation within the tolerance. */
+struct Selection
+{
+    const AccuracyCase* c;
+    const char* backend;
+    double maxNormwiseUlp;
+    double nsPerOp;
+};
+
+/**
+ * @brief Pick, for each operation, the fastest case and backend whose error
+ *        is within the tolerance on every input set
+ */
+static std::vector<Selection> Select(const std::vector<Result>& results, double tolerance)
+{
+    // Worst error over the input sets of each case and backend
+    std::map<std::pair<std::string, std::string>, Selection> worst;
+    for (const Result& r : results)
+    {
+        Selection& s = worst.emplace(std::make_pair(std::string(r.c->name), std::string(r.backend)),
+                                     Selection{r.c, r.backend, 0.0, r.nsPerOp}).first->second;
+        s.maxNormwiseUlp = fmax(s.maxNormwiseUlp, r.nonfinite ? INFINITY : r.maxNormwiseUlp);
+    }
+
+    std::map<std::string, Selection> best;
+    for (const auto& w : worst)
+    {
+        const Selection& s = w.second;
+        if (!(s.maxNormwiseUlp <= tolerance))
+            continue;
+        auto it = best.find(s.c->op);
+        if (it == best.end() || s.nsPerOp < it->second.nsPerOp)
+            best[s.c->op] = s;
+    }
+
+    std::vector<Selection> out;
+    for (const auto& b : best)
+        out.push_back(b.second);
+    return out;
+}
+
+static void WriteJson(FILE* f, const std::vector<Result>& results, const std::vector<Selection>& selection, const Options& opt)
+{
+    fprintf(f, "{\n");
+    WriteBuildInfo(f);
+    fprintf(f, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Result& r = results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"op\": \"%s\", \"backend\": \"%s\", \"inputs\": \"%s\", \"n\": %zu, \"max_ulp\": ",
+                r.c->name, r.c->op, r.backend, inputSetNames[r.set], r.n);
+        PrintNumber(f, r.maxUlp);
+        fputs(", \"mean_ulp\": ", f);
+        PrintNumber(f, r.meanUlp);
+        fputs(", \"max_normwise_ulp\": ", f);
+        PrintNumber(f, r.maxNormwiseUlp);
+        fprintf(f, ", \"nonfinite\": %zu, \"mismatches\": %zu, \"ns_per_op\": ", r.nonfinite, r.mismatches);
+        PrintNumber(f, r.nsPerOp);
+        fputs(i + 1 < results.size() ? "},\n" : "}\n", f);
+    }
+    fprintf(f, "  ]");
+    if (opt.tolerance >= 0)
+    {
+        fprintf(f, ",\n  \"tolerance_ulp\": %.6g,\n  \"selection\": [\n", opt.tolerance);
+        for (size_t i = 0; i < selection.size(); i++)
+        {
+            const Selection& s = selection[i];
+            fprintf(f, "    {\"op\": \"%s\", \"name\": \"%s\", \"backend\": \"%s\", \"max_normwise_ulp\": %.6g, \"ns_per_op\": %.6g}%s\n",
+                    s.c->op, s.c->name, s.backend, s.maxNormwiseUlp, s.nsPerOp, i + 1 < selection.size() ? "," : "");
+        }
+        fprintf(f, "  ]");
+    }
+    fprintf(f, "\n}\n");
+}
+
+static void WriteCsv(FILE* f, const std::vector<Result>& results)
+{
+    fprintf(f, "name,op,backend,inputs,n,max_ulp,mean_ulp,max_normwise_ulp,nonfinite,mismatches,ns_per_op\n");
+    for (const Result& r : results)
+        fprintf(f, "%s,%s,%s,%s,%zu,%.6g,%.6g,%.6g,%zu,%zu,%.6g\n", r.c->name, r.c->op, r.backend, inputSetNames[r.set],
+                r.n, r.maxUlp, r.meanUlp, r.maxNormwiseUlp, r.nonfinite, r.mismatches, r.nsPerOp);
+}
+
+//**********************************************************************
+//* Main
+//**********************************************************************
+static bool ParseOptions(int argc, char** argv, Options& opt)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        if (!strcmp(arg, "--format=json"))
+            opt.csv = false;
+        else if (!strcmp(arg, "--format=csv"))
+            opt.csv = true;
+        else if (!strcmp(arg, "--quick"))
+            opt.quick = true;
+        else if (!strncmp(arg, "--filter=", 9))
+            opt.filter = arg + 9;
+        else if (!strncmp(arg, "--out=", 6))
+            opt.out = arg + 6;
+        else if (!strncmp(arg, "--tolerance=", 12))
+            opt.tolerance = atof(arg + 12);
+        else if (!strncmp(arg, "--count=", 8) && atol(arg + 8) > 0)
+            opt.count = static_cast<size_t>(atol(arg + 8));
+        else
+        {
+            fprintf(stderr,
+                    "usage: %s [--format=json|csv] [--out=FILE] [--filter=TEXT] [--tolerance=ULP] [--count=N] [--quick]\n"
+                    "  --format     Output format, json by default\n"
+                    "  --out        Write the results to FILE instead of stdout\n"
+                    "  --filter     Only run the cases whose name contains TEXT\n"
+                    "  --tolerance  Select the fastest case of each operation within ULP\n"
+                    "  --count      Elements per input set, 4096 by default\n"
+                    "  --quick      Shorter timing samples\n",
+                    argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseOptions(argc, argv, opt))
+        return 2;
+
+#ifndef __OPTIMIZE__
+    fprintf(stderr, "vector_accuracy: built without optimization, the timings are not representative\n");
+#endif
+
+    const std::vector<AccuracyCase> cases = BuildCases();
+    const SimdLevel host = SimdHostLevel();
+    const size_t n = opt.count;
+    std::vector<Result> results;
+
+    for (const AccuracyCase& c : cases)
+    {
+        if (opt.filter && !strstr(c.name, opt.filter))
+            continue;
+        fprintf(stderr, "%s\n", c.name);
+
+        // Inputs of every set, generated once so all the backends see the same values
+        const size_t bCount = c.bBroadcast ? 1 : n;
+        std::vector<std::unique_ptr<Buffer>> a, b;
+        std::vector<InputSet> sets;
+        for (int s = 0; s < InputSetCount; s++)
+        {
+            const InputSet set = static_cast<InputSet>(s);
+            if ((set != Random && c.degree == 0) || (set == NearSingular && c.matrixDim == 0))
+                continue;
+            std::unique_ptr<Buffer> ab(new Buffer(n * c.aFloats));
+            std::unique_ptr<Buffer> bb(new Buffer(bCount * c.bFloats + 16));
+            const int degree = c.degree ? c.degree : 1;
+            for (size_t i = 0; i < n * c.aFloats; i++)
+                ab->data[i] = Generate(set == NearSingular ? Random : set, degree);
+            for (size_t i = 0; i < bCount * c.bFloats; i++)
+                bb->data[i] = Generate(set == NearSingular ? Random : set, degree);
+            if (set == NearSingular)
+                MakeNearSingular(ab->data, n, c.matrixDim);
+            if (c.prepare)
+                c.prepare(ab->data, bb->data, n);
+            a.push_back(std::move(ab));
+            b.push_back(std::move(bb));
+            sets.push_back(set);
+        }
+        Buffer out(n * c.outFloats);
+
+        // Inline operators with an exact version are checked at every level too
+        const bool everyLevel = c.dispatched || c.exact;
+        const int first = everyLevel ? 0 : static_cast<int>(host);
+        for (int l = first; l <= static_cast<int>(host); l++)
+        {
+            const SimdLevel level = SimdSetLevel(static_cast<SimdLevel>(l));
+            const char* backend = everyLevel ? SimdLevelName(level) : "inline";
+
+            // Throughput on the random set
+            const Timing t = TimeRuns([&] { c.run(a[0]->data, b[0]->data, out.data, n); }, opt.quick);
+            const double nsPerOp = t.ns / (static_cast<double>(n) * t.reps);
+
+            for (size_t s = 0; s < sets.size(); s++)
+            {
+                c.run(a[s]->data, b[s]->data, out.data, n);
+                Result r;
+                r.c = &c;
+                r.backend = backend;
+                r.set = sets[s];
+                r.n = n;
+                r.nsPerOp = nsPerOp;
+                Compare(c, a[s]->data, b[s]->data, out.data, n, r);
+                results.push_back(r);
+            }
+        }
+        SimdSetLevel(host);
+    }
+
+    std::vector<Selection> selection;
+    if (opt.tolerance >= 0)
+    {
+        selection = Select(results, opt.tolerance);
+        fprintf(stderr, "\nFastest within %g ulp (normwise):\n", opt.tolerance);
+        for (const Selection& s : selection)
+            fprintf(stderr, "  %-20s %-32s %-8s %10.4g ulp %10.4g ns\n",
+                    s.c->op, s.c->name, s.backend, s.maxNormwiseUlp, s.nsPerOp);
+    }
+
+    FILE* f = stdout;
+    if (opt.out)
+    {
+        f = fopen(opt.out, "w");
+        if (!f)
+        {
+            fprintf(stderr, "vector_accuracy: cannot open %s\n", opt.out);
+            return 1;
+        }
+    }
+    if (opt.csv)
+        WriteCsv(f, results);
+    else
+        WriteJson(f, results, selection, opt);
+    if (f != stdout)
+        fclose(f);
+
+    size_t mismatches = 0;
+    for (const Result& r : results)
+    {
+        if (r.mismatches)
+            fprintf(stderr, "vector_accuracy: %s (%s, %s inputs) differs from its scalar code in %zu of %zu elements\n",
+                    r.c->name, r.backend, inputSetNames[r.set], r.mismatches, r.n);
+        mismatches += r.mismatches;
+    }
+    return mismatches ? 1 : 0;
+}
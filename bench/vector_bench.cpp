@@ -0,0 +1,818 @@
+/**
+ * @file: vector_bench.cpp
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+//**********************************************************************
+//* vector_bench
+//**********************************************************************
+// Throughput of every matrix, vector and batch operation of the library.
+// Each case processes an array of n elements (one matrix product, one
+// vertex, one triangle...) and is measured for working sets from L1 to
+// DRAM resident, at every SIMD level the host supports for the kernels that
+// follow SimdSetLevel(). Inline code that is fixed at compile time is
+// measured once, as the "inline" backend.
+//
+// Usage: vector_bench [--format=json|csv] [--out=FILE] [--filter=TEXT]
+//                     [--quick] [--list]
+//
+// Reported for each case, working set and backend:
+//  - ns_per_op:       median time per element
+//  - gflops:          nominal arithmetic operations of the scalar reference
+//                     code per second. Integer kernels count integer
+//                     operations and conversions count none (null)
+//  - bytes_per_cycle: bytes read and written per TSC tick. The TSC runs at
+//                     the nominal clock, not the actual core clock. Null on
+//                     non-x86 hosts
+//
+// Build in Release for meaningful numbers. The output records the build
+// type so results from debug builds are easy to spot.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "Vector.h"
+#include "Mat3.h"
+#include "Mat4.h"
+#include "Mat3x4.h"
+#include "Vec3A.h"
+#include "Mat3A.h"
+#include "Quat.h"
+#include "BatchTransform.h"
+#include "Clipping.h"
+#include "VectorBatch.h"
+#include "VectorSoA.h"
+#include "VectorExpr.h"
+#include "Fixed.h"
+#include "FixedMatrix.h"
+#include "Half.h"
+#include "TransformHierarchy.h"
+#include "ParallelBatch.h"
+#include "Bounds.h"
+#include "Ray.h"
+#include "Bvh.h"
+#include "Simd.h"
+#include "BenchUtil.h"
+
+//**********************************************************************
+//* Working memory
+//**********************************************************************
+/**
+ * @brief Buffers shared by all the cases. Arrays are 64 byte aligned and
+ *        only grow, so each size is allocated once.
+ */
+struct Arena
+{
+    static constexpr int Arrays = 4;
+
+    ~Arena()
+    {
+        for (int i = 0; i < Arrays; i++)
+            free(ptr[i]);
+    }
+
+    /** @brief Make array i hold at least bytes bytes. The contents are lost. */
+    void Reserve(int i, size_t bytes)
+    {
+        bytes = (bytes + 127) & ~static_cast<size_t>(63); // Room for short overreads
+        if (bytes <= cap[i])
+            return;
+        free(ptr[i]);
+        ptr[i] = aligned_alloc(64, bytes);
+        if (!ptr[i])
+        {
+            fprintf(stderr, "vector_bench: out of memory\n");
+            exit(1);
+        }
+        cap[i] = bytes;
+    }
+
+    template <class T>
+    T* Get(int i) { return static_cast<T*>(ptr[i]); }
+
+    void* ptr[Arrays] = {};
+    size_t cap[Arrays] = {};
+
+    // Operands that own their memory
+    Vec3fSoA soa[3];
+    TransformHierarchy tree;
+    Bvh bvh;
+};
+
+static void FillFloats(void* p, size_t count)
+{
+    float* f = static_cast<float*>(p);
+    for (size_t i = 0; i < count; i++)
+        f[i] = RandFloat();
+}
+
+static void FillHalves(Half* p, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        p[i] = Half(RandFloat());
+}
+
+static void FillQ16(Q16* p, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        p[i] = Q16(RandFloat() * 16.0f);
+}
+
+static void FillUnitQuats(Quat* q, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        q[i] = Quat(RandFloat(), RandFloat(), RandFloat(), RandFloat() + 2.0f);
+        q[i].Normalize();
+    }
+}
+
+static void FillSoA(Vec3fSoA& v, size_t n)
+{
+    v.Resize(n);
+    FillFloats(v.x, n);
+    FillFloats(v.y, n);
+    FillFloats(v.z, n);
+}
+
+// Constant operands
+static const Mat3 Rotation = Mat3::RotationY(0.3f) * Mat3::RotationX(0.2f);
+static const Mat4 Model = Mat4::RotationY(0.3f) * Mat4::RotationX(0.2f) * Mat4::Translation(1.0f, 2.0f, -3.0f);
+static const Mat4 ModelViewProj = Model * Mat4::Projection(640.0f, 480.0f, 1.0f);
+static const Mat3x4 Model34(Model);
+static const Mat4q Model4q(Model);
+static const Viewport Screen(0.0f, 0.0f, 640.0f, 480.0f);
+
+//**********************************************************************
+//* Cases
+//**********************************************************************
+/**
+ * @brief One benchmarked operation over an array of n elements
+ */
+struct Case
+{
+    const char* name;
+    bool dispatched;                // Follows SimdSetLevel(), measured at every level
+    double ops;                     // Nominal arithmetic operations per element
+    size_t arrays[Arena::Arrays];   // Bytes per element of each array operand
+    size_t external;                // Bytes per element kept outside the arena arrays
+    void (*init)(Arena&, size_t n); // Extra setup after the arrays are filled. May be nullptr
+    void (*run)(Arena&, size_t n);
+
+    /** @brief Bytes read and written per element. */
+    size_t Traffic() const
+    {
+        size_t t = external;
+        for (int i = 0; i < Arena::Arrays; i++)
+            t += arrays[i];
+        return t;
+    }
+};
+
+/** @brief Keep the result of a reduction so the call is not optimized away. */
+static volatile float Sunk;
+static inline void Sink(float v)
+{
+    Sunk = v;
+}
+
+/** @brief out[i] = f(in[i]) with array 0 as input and array 1 as output. */
+template <class In, class Out, class F>
+static inline void Map(Arena& a, size_t n, F f)
+{
+    const In* in = a.Get<In>(0);
+    Out* out = a.Get<Out>(1);
+    for (size_t i = 0; i < n; i++)
+        out[i] = f(in[i]);
+}
+
+/** @brief out[i] = f(a[i], b[i]) with arrays 0 and 1 as inputs and array 2 as output. */
+template <class In, class Out, class F>
+static inline void Zip(Arena& a, size_t n, F f)
+{
+    const In* x = a.Get<In>(0);
+    const In* y = a.Get<In>(1);
+    Out* out = a.Get<Out>(2);
+    for (size_t i = 0; i < n; i++)
+        out[i] = f(x[i], y[i]);
+}
+
+static void InitHalfIn(Arena& a, size_t n)
+{
+    // Covers the widest input, Vec4f16, without passing the allocation
+    FillHalves(a.Get<Half>(0), std::min(a.cap[0], n * sizeof(Vec4f16)) / sizeof(Half));
+}
+
+static void InitQuats(Arena& a, size_t n)
+{
+    FillUnitQuats(a.Get<Quat>(0), n);
+    FillUnitQuats(a.Get<Quat>(1), n);
+}
+
+static void InitSoA(Arena& a, size_t n)
+{
+    for (Vec3fSoA& v : a.soa)
+        FillSoA(v, n);
+}
+
+static void InitTriangles(Arena& a, size_t n)
+{
+    // n triangles over n vertices with random indices and outcodes
+    uint32_t* idx = a.Get<uint32_t>(0);
+    uint8_t* codes = a.Get<uint8_t>(1);
+    for (size_t i = 0; i < 3 * n; i++)
+        idx[i] = Rand() % n;
+    for (size_t i = 0; i < n; i++)
+        codes[i] = (Rand() & 0x3F) & (Rand() & 0x3F);
+}
+
+static void InitTree(Arena& a, size_t n)
+{
+    // Balanced tree with four children per node
+    a.tree.Clear();
+    a.tree.Reserve(n);
+    std::vector<TransformHierarchy::Node> nodes(n);
+    for (size_t i = 0; i < n; i++)
+        nodes[i] = a.tree.Add(Mat4::RotationZ(0.01f * i) * Mat4::Translation(0.0f, 1.0f, 0.0f),
+                              i ? nodes[(i - 1) / 4] : TransformHierarchy::None);
+    a.tree.Update();
+}
+
+// Random mesh for the brute force ray cases, rebuilt by InitRays
+static constexpr size_t MeshTriangles = 64;
+static Vec3f MeshVertices[3 * MeshTriangles];
+static uint32_t MeshIndices[3 * MeshTriangles];
+
+/** @brief Ray from a shell around the [-1, 1] cube towards a point inside it. */
+static Ray RandRay()
+{
+    const Vec3f o(4.0f * RandFloat(), 4.0f * RandFloat(), 4.0f * RandFloat());
+    const Vec3f t(RandFloat(), RandFloat(), RandFloat());
+    return Ray(o, t - o);
+}
+
+static void InitRays(Arena& a, size_t n)
+{
+    for (size_t i = 0; i < 3 * MeshTriangles; i++)
+    {
+        MeshVertices[i] = Vec3f(RandFloat(), RandFloat(), RandFloat());
+        MeshIndices[i] = i;
+    }
+    Ray* rays = a.Get<Ray>(0);
+    for (size_t i = 0; i < n; i++)
+        rays[i] = RandRay();
+}
+
+static void InitRayPackets(Arena& a, size_t n)
+{
+    RayPacket* p = a.Get<RayPacket>(0);
+    for (size_t i = 0; i < n; i++)
+        for (int k = 0; k < RayPacket::Size; k++)
+            p[i].Set(k, RandRay());
+}
+
+/** @brief n small random triangles, vertices in array 0 and indices in array 1. */
+static void FillMesh(Vec3f* vertices, uint32_t* indices, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const Vec3f c(RandFloat(), RandFloat(), RandFloat());
+        for (int k = 0; k < 3; k++)
+        {
+            vertices[3*i + k] = c + Vec3f(RandFloat(), RandFloat(), RandFloat()) * 0.05f;
+            indices[3*i + k] = static_cast<uint32_t>(3*i + k);
+        }
+    }
+}
+
+static void InitMesh(Arena& a, size_t n)
+{
+    FillMesh(a.Get<Vec3f>(0), a.Get<uint32_t>(1), n);
+}
+
+static void InitMeshBvh(Arena& a, size_t n)
+{
+    InitMesh(a, n);
+    a.bvh.Build(a.Get<Vec3f>(0), a.Get<uint32_t>(1), n);
+}
+
+// Fixed mesh traced by the Bvh query cases, built by InitBvhRays
+static constexpr size_t BvhTriangles = 65536;
+static std::vector<Vec3f> BvhVertices;
+
+static void InitBvhRays(Arena& a, size_t n)
+{
+    std::vector<uint32_t> indices(3 * BvhTriangles);
+    BvhVertices.resize(3 * BvhTriangles);
+    FillMesh(BvhVertices.data(), indices.data(), BvhTriangles);
+    a.bvh.Build(BvhVertices.data(), indices.data(), BvhTriangles);
+    Ray* rays = a.Get<Ray>(0);
+    for (size_t i = 0; i < n; i++)
+        rays[i] = RandRay();
+}
+
+static std::vector<Case> BuildCases()
+{
+    const size_t M = sizeof(Mat4), F = sizeof(float);
+    const size_t V3 = sizeof(Vec3f), V4 = sizeof(Vec4f), V2 = sizeof(Vec2f);
+    const size_t M3 = sizeof(Mat3), MA = sizeof(Mat3A), VA = sizeof(Vec3A);
+    const size_t M34s = sizeof(Mat3x4), Q = sizeof(Quat);
+    const size_t H3 = sizeof(Vec3f16), H4 = sizeof(Vec4f16);
+    const size_t S3 = sizeof(Vec3h), S4 = sizeof(Vec4h), S2 = sizeof(Vec2h);
+
+    return {
+        //* Mat4
+        {"Mat4.Multiply", true, 112, {M, M, M}, 0, nullptr,
+            [](Arena& a, size_t n) { Zip<Mat4, Mat4>(a, n, [](const Mat4& x, const Mat4& y) { return x * y; }); }},
+        {"Mat4.Inverse", true, 144, {M, M}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat4, Mat4>(a, n, [](const Mat4& m) { return m.Inverse(); }); }},
+        {"Mat4.InverseAffine", false, 60, {M, M}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat4, Mat4>(a, n, [](const Mat4& m) { return m.InverseAffine(); }); }},
+        {"Mat4.InverseRigid", false, 15, {M, M}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat4, Mat4>(a, n, [](const Mat4& m) { return m.InverseRigid(); }); }},
+        {"Mat4.Determinant", false, 95, {M, F}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat4, float>(a, n, [](const Mat4& m) { return m.Determinant(); }); }},
+        {"Mat4.Scale", false, 16, {M, M}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat4, Mat4>(a, n, [](const Mat4& m) { return m * 1.5f; }); }},
+        {"Mat4.Transpose", false, 0, {M, M}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat4, Mat4>(a, n, [](const Mat4& m) { return !m; }); }},
+        {"Vec4f.MultiplyMat4", false, 28, {V4, V4}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Vec4f, Vec4f>(a, n, [](const Vec4f& v) { return v * Model; }); }},
+
+        //* Mat3x4
+        {"Mat3x4.Multiply", true, 63, {M34s, M34s, M34s}, 0, nullptr,
+            [](Arena& a, size_t n) { Zip<Mat3x4, Mat3x4>(a, n, [](const Mat3x4& x, const Mat3x4& y) { return x * y; }); }},
+        {"Mat3x4.Inverse", false, 60, {M34s, M34s}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat3x4, Mat3x4>(a, n, [](const Mat3x4& m) { return m.Inverse(); }); }},
+        {"Vec3f.MultiplyMat3x4", false, 18, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Vec3f, Vec3f>(a, n, [](const Vec3f& v) { return v * Model34; }); }},
+
+        //* Mat3 / Mat3A
+        {"Mat3.Multiply", false, 45, {M3, M3, M3}, 0, nullptr,
+            [](Arena& a, size_t n) { Zip<Mat3, Mat3>(a, n, [](const Mat3& x, const Mat3& y) { return x * y; }); }},
+        {"Mat3.Inverse", false, 42, {M3, M3}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat3, Mat3>(a, n, [](const Mat3& m) { return m.Inverse(); }); }},
+        {"Mat3.Determinant", false, 14, {M3, F}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat3, float>(a, n, [](const Mat3& m) { return m.Determinant(); }); }},
+        {"Mat3.Transpose", false, 0, {M3, M3}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat3, Mat3>(a, n, [](const Mat3& m) { return !m; }); }},
+        {"Vec3f.MultiplyMat3", false, 15, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Vec3f, Vec3f>(a, n, [](const Vec3f& v) { return v * Rotation; }); }},
+        {"Mat3A.Multiply", false, 45, {MA, MA, MA}, 0, nullptr,
+            [](Arena& a, size_t n) { Zip<Mat3A, Mat3A>(a, n, [](const Mat3A& x, const Mat3A& y) { return x * y; }); }},
+        {"Mat3A.Inverse", false, 42, {MA, MA}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat3A, Mat3A>(a, n, [](const Mat3A& m) { return m.Inverse(); }); }},
+        {"Mat3A.Determinant", false, 14, {MA, F}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Mat3A, float>(a, n, [](const Mat3A& m) { return m.Determinant(); }); }},
+        {"Vec3A.MultiplyMat3A", false, 15, {VA, VA}, 0, nullptr,
+            [](Arena& a, size_t n) { const Mat3A m(Rotation); Map<Vec3A, Vec3A>(a, n, [&](const Vec3A& v) { return v * m; }); }},
+
+        //* Vectors
+        {"Vec3f.CrossProduct", false, 9, {V3, V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Zip<Vec3f, Vec3f>(a, n, [](const Vec3f& x, const Vec3f& y) { return CrossProduct(x, y); }); }},
+        {"Vec3f.Dot", false, 5, {V3, V3, F}, 0, nullptr,
+            [](Arena& a, size_t n) { Zip<Vec3f, float>(a, n, [](const Vec3f& x, const Vec3f& y) { return x * y; }); }},
+        {"Vec3f.Normalize", false, 10, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Vec3f, Vec3f>(a, n, [](Vec3f v) { v.Normalize(); return v; }); }},
+        {"Vec3f.Normalize.Fast", false, 10, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Vec3f, Vec3f>(a, n, [](Vec3f v) { v.Normalize<Precision::Fast>(); return v; }); }},
+        {"Vec4f.Normalize", false, 13, {V4, V4}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Vec4f, Vec4f>(a, n, [](Vec4f v) { v.Normalize(); return v; }); }},
+        {"Vec3A.CrossProduct", false, 9, {VA, VA, VA}, 0, nullptr,
+            [](Arena& a, size_t n) { Zip<Vec3A, Vec3A>(a, n, [](const Vec3A& x, const Vec3A& y) { return CrossProduct(x, y); }); }},
+        {"Vec3A.Dot", false, 5, {VA, VA, F}, 0, nullptr,
+            [](Arena& a, size_t n) { Zip<Vec3A, float>(a, n, [](const Vec3A& x, const Vec3A& y) { return x * y; }); }},
+        {"Vec3A.Normalize", false, 10, {VA, VA}, 0, nullptr,
+            [](Arena& a, size_t n) { Map<Vec3A, Vec3A>(a, n, [](Vec3A v) { v.Normalize(); return v; }); }},
+        {"VectorExpr.Operators.Vec3f", false, 6, {V3, V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Zip<Vec3f, Vec3f>(a, n, [](const Vec3f& x, const Vec3f& y) { return x + y * 0.5f; }); }},
+        {"VectorExpr.Loop.Vec3f", false, 6, {V3, V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) {
+                const Vec3f* x = a.Get<Vec3f>(0);
+                const Vec3f* y = a.Get<Vec3f>(1);
+                Vec3f* out = a.Get<Vec3f>(2);
+                for (size_t i = 0; i < n; i++)
+                {
+                    out[i].x = x[i].x + y[i].x * 0.5f;
+                    out[i].y = x[i].y + y[i].y * 0.5f;
+                    out[i].z = x[i].z + y[i].z * 0.5f;
+                }
+            }},
+        {"VectorExpr.Evaluate.Vec3f", false, 6, {V3, V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Evaluate(a.Get<Vec3f>(2), n, Lazy(a.Get<Vec3f>(0)) + Lazy(a.Get<Vec3f>(1)) * 0.5f); }},
+        {"VectorExpr.Operators.Vec3h", false, 6, {S3, S3, S3}, 0, nullptr,
+            [](Arena& a, size_t n) { Zip<Vec3h, Vec3h>(a, n, [](const Vec3h& x, const Vec3h& y) { return x + y * 3; }); }},
+        {"VectorExpr.Evaluate.Vec3h", false, 6, {S3, S3, S3}, 0, nullptr,
+            [](Arena& a, size_t n) { Evaluate(a.Get<Vec3h>(2), n, Lazy(a.Get<Vec3h>(0)) + Lazy(a.Get<Vec3h>(1)) * 3); }},
+
+        //* Quat
+        {"Quat.Multiply", false, 28, {Q, Q, Q}, 0, InitQuats,
+            [](Arena& a, size_t n) { Zip<Quat, Quat>(a, n, [](const Quat& x, const Quat& y) { return x * y; }); }},
+        {"Quat.Rotate", false, 30, {Q, V3}, 0,
+            [](Arena& a, size_t n) { FillUnitQuats(a.Get<Quat>(0), n); },
+            [](Arena& a, size_t n) { Map<Quat, Vec3f>(a, n, [](const Quat& q) { return Vec3f(1.0f, 2.0f, 3.0f) * q; }); }},
+        {"Quat.NlerpBatch", true, 31, {Q, Q, Q}, 0, InitQuats,
+            [](Arena& a, size_t n) { NlerpBatch(a.Get<Quat>(0), a.Get<Quat>(1), 0.3f, a.Get<Quat>(2), n); }},
+        {"Quat.SlerpBatch", true, 28, {Q, Q, Q}, 0, InitQuats,
+            [](Arena& a, size_t n) { SlerpBatch(a.Get<Quat>(0), a.Get<Quat>(1), 0.3f, a.Get<Quat>(2), n); }},
+
+        //* BatchTransform
+        {"TransformBatch.Vec4f", true, 28, {V4, V4}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformBatch(Model, a.Get<Vec4f>(0), a.Get<Vec4f>(1), n); }},
+        {"TransformPointBatch.Vec3f>Vec4f", true, 24, {V3, V4}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformPointBatch(Model, a.Get<Vec3f>(0), a.Get<Vec4f>(1), n); }},
+        {"TransformPointBatch.Vec3f", true, 18, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformPointBatch(Model, a.Get<Vec3f>(0), a.Get<Vec3f>(1), n); }},
+        {"TransformDirectionBatch.Vec3f", true, 15, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformDirectionBatch(Model, a.Get<Vec3f>(0), a.Get<Vec3f>(1), n); }},
+        {"TransformBatch.Vec4f16", true, 28, {H4, H4}, 0, InitHalfIn,
+            [](Arena& a, size_t n) { TransformBatch(Model, a.Get<Vec4f16>(0), a.Get<Vec4f16>(1), n); }},
+        {"TransformPointBatch.Vec3f16>Vec4f", true, 24, {H3, V4}, 0, InitHalfIn,
+            [](Arena& a, size_t n) { TransformPointBatch(Model, a.Get<Vec3f16>(0), a.Get<Vec4f>(1), n); }},
+        {"TransformPointBatch.Vec3f16", true, 18, {H3, H3}, 0, InitHalfIn,
+            [](Arena& a, size_t n) { TransformPointBatch(Model, a.Get<Vec3f16>(0), a.Get<Vec3f16>(1), n); }},
+        {"TransformDirectionBatch.Vec3f16", true, 15, {H3, H3}, 0, InitHalfIn,
+            [](Arena& a, size_t n) { TransformDirectionBatch(Model, a.Get<Vec3f16>(0), a.Get<Vec3f16>(1), n); }},
+        {"TransformPointBatch.Mat3x4", true, 18, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformPointBatch(Model34, a.Get<Vec3f>(0), a.Get<Vec3f>(1), n); }},
+        {"TransformDirectionBatch.Mat3x4", true, 15, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformDirectionBatch(Model34, a.Get<Vec3f>(0), a.Get<Vec3f>(1), n); }},
+        {"ProjectBatch.Vec2f", true, 32, {V3, V2, F}, 0, nullptr,
+            [](Arena& a, size_t n) { ProjectBatch(ModelViewProj, Screen, a.Get<Vec3f>(0), a.Get<Vec2f>(1), a.Get<float>(2), n); }},
+        {"ProjectBatch.Vec2h", true, 32, {V3, S2, F}, 0, nullptr,
+            [](Arena& a, size_t n) { ProjectBatch(ModelViewProj, Screen, a.Get<Vec3f>(0), a.Get<Vec2h>(1), a.Get<float>(2), n); }},
+        {"MultiplyBatch.Mat4", true, 112, {M, M, M}, 0, nullptr,
+            [](Arena& a, size_t n) { MultiplyBatch(a.Get<Mat4>(0), a.Get<Mat4>(1), a.Get<Mat4>(2), n); }},
+        {"MultiplyBatch.Mat4xArray", true, 112, {0, M, M}, 0, nullptr,
+            [](Arena& a, size_t n) { MultiplyBatch(Model, a.Get<Mat4>(1), a.Get<Mat4>(2), n); }},
+        {"MultiplyBatch.Mat3x4", true, 63, {M34s, M34s, M34s}, 0, nullptr,
+            [](Arena& a, size_t n) { MultiplyBatch(a.Get<Mat3x4>(0), a.Get<Mat3x4>(1), a.Get<Mat3x4>(2), n); }},
+
+        //* Clipping
+        {"ComputeOutcodes", true, 6, {V4, 1}, 0, nullptr,
+            [](Arena& a, size_t n) { ComputeOutcodes(a.Get<Vec4f>(0), a.Get<uint8_t>(1), n); }},
+        {"ClassifyTriangles", true, 8, {12, 1, 1}, 0, InitTriangles,
+            [](Arena& a, size_t n) {
+                // One bit per triangle in each of the three masks
+                uint32_t* masks = a.Get<uint32_t>(2);
+                const size_t words = TriangleMaskWords(n);
+                ClassifyTriangles(a.Get<uint8_t>(1), a.Get<uint32_t>(0), n, masks, masks + words, masks + 2 * words);
+            }},
+
+        //* VectorBatch
+        {"NormalizeBatch.Exact", true, 10, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { NormalizeBatch<Precision::Exact>(a.Get<Vec3f>(0), a.Get<Vec3f>(1), n); }},
+        {"NormalizeBatch.Fast", true, 10, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { NormalizeBatch<Precision::Fast>(a.Get<Vec3f>(0), a.Get<Vec3f>(1), n); }},
+        {"NormalizeBatch.VeryFast", true, 10, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { NormalizeBatch<Precision::VeryFast>(a.Get<Vec3f>(0), a.Get<Vec3f>(1), n); }},
+        {"LengthBatch.Exact", true, 6, {V3, F}, 0, nullptr,
+            [](Arena& a, size_t n) { LengthBatch<Precision::Exact>(a.Get<Vec3f>(0), a.Get<float>(1), n); }},
+        {"LengthBatch.Fast", true, 6, {V3, F}, 0, nullptr,
+            [](Arena& a, size_t n) { LengthBatch<Precision::Fast>(a.Get<Vec3f>(0), a.Get<float>(1), n); }},
+        {"AddBatch.Vec3h", true, 3, {S3, S3, S3}, 0, nullptr,
+            [](Arena& a, size_t n) { AddBatch(a.Get<Vec3h>(0), a.Get<Vec3h>(1), a.Get<Vec3h>(2), n); }},
+        {"AddBatch.Vec4h", true, 4, {S4, S4, S4}, 0, nullptr,
+            [](Arena& a, size_t n) { AddBatch(a.Get<Vec4h>(0), a.Get<Vec4h>(1), a.Get<Vec4h>(2), n); }},
+        {"SubBatch.Vec3h", true, 3, {S3, S3, S3}, 0, nullptr,
+            [](Arena& a, size_t n) { SubBatch(a.Get<Vec3h>(0), a.Get<Vec3h>(1), a.Get<Vec3h>(2), n); }},
+        {"ScaleBatch.Vec3h", true, 3, {S3, S3}, 0, nullptr,
+            [](Arena& a, size_t n) { ScaleBatch(a.Get<Vec3h>(0), 3, a.Get<Vec3h>(1), n); }},
+        {"ScaleBatch.Vec3h.Saturate", true, 3, {S3, S3}, 0, nullptr,
+            [](Arena& a, size_t n) { ScaleBatch<Overflow::Saturate>(a.Get<Vec3h>(0), 3, a.Get<Vec3h>(1), n); }},
+        {"ClampBatch.Vec3h", true, 6, {S3, S3}, 0, nullptr,
+            [](Arena& a, size_t n) { ClampBatch(a.Get<Vec3h>(0), -1000, 1000, a.Get<Vec3h>(1), n); }},
+        {"MinBatch.Vec3h", true, 3, {S3, S3, S3}, 0, nullptr,
+            [](Arena& a, size_t n) { MinBatch(a.Get<Vec3h>(0), a.Get<Vec3h>(1), a.Get<Vec3h>(2), n); }},
+        {"MaxBatch.Vec3h", true, 3, {S3, S3, S3}, 0, nullptr,
+            [](Arena& a, size_t n) { MaxBatch(a.Get<Vec3h>(0), a.Get<Vec3h>(1), a.Get<Vec3h>(2), n); }},
+        {"DotBatch.Vec3h", true, 5, {S3, S3, 4}, 0, nullptr,
+            [](Arena& a, size_t n) { DotBatch(a.Get<Vec3h>(0), a.Get<Vec3h>(1), a.Get<int32_t>(2), n); }},
+        {"DotBatch.Vec4h", true, 7, {S4, S4, 4}, 0, nullptr,
+            [](Arena& a, size_t n) { DotBatch(a.Get<Vec4h>(0), a.Get<Vec4h>(1), a.Get<int32_t>(2), n); }},
+
+        //* VectorSoA
+        {"Vec3fSoA.Add", true, 3, {}, 3 * V3, InitSoA,
+            [](Arena& a, size_t) { Add(a.soa[0], a.soa[1], a.soa[2]); }},
+        {"Vec3fSoA.Scale", true, 3, {}, 2 * V3, InitSoA,
+            [](Arena& a, size_t) { Scale(a.soa[0], 1.5f, a.soa[2]); }},
+        {"Vec3fSoA.Dot", true, 5, {0, 0, F}, 2 * V3, InitSoA,
+            [](Arena& a, size_t) { Dot(a.soa[0], a.soa[1], a.Get<float>(2)); }},
+        {"Vec3fSoA.CrossProduct", true, 9, {}, 3 * V3, InitSoA,
+            [](Arena& a, size_t) { CrossProduct(a.soa[0], a.soa[1], a.soa[2]); }},
+        {"Vec3fSoA.Lerp", true, 9, {}, 3 * V3, InitSoA,
+            [](Arena& a, size_t) { Lerp(a.soa[0], a.soa[1], 0.3f, a.soa[2]); }},
+        {"Vec3fSoA.Min", true, 3, {}, 3 * V3, InitSoA,
+            [](Arena& a, size_t) { min(a.soa[0], a.soa[1], a.soa[2]); }},
+        {"RepackToSoA.Vec3f", true, 0, {V3}, V3, InitSoA,
+            [](Arena& a, size_t n) { RepackToSoA(a.Get<Vec3f>(0), a.soa[0].x, a.soa[0].y, a.soa[0].z, n); }},
+        {"RepackToAoS.Vec3f", true, 0, {V3}, V3, InitSoA,
+            [](Arena& a, size_t n) { RepackToAoS(a.soa[0].x, a.soa[0].y, a.soa[0].z, a.Get<Vec3f>(0), n); }},
+
+        //* Fixed point
+        {"Q15.MultiplyBatch", true, 1, {2, 2, 2}, 0, nullptr,
+            [](Arena& a, size_t n) { MultiplyBatch(a.Get<Q15>(0), a.Get<Q15>(1), a.Get<Q15>(2), n); }},
+        {"Q15.ScaleBatch", true, 1, {2, 2}, 0, nullptr,
+            [](Arena& a, size_t n) { ScaleBatch(a.Get<Q15>(0), Q15(0.75f), a.Get<Q15>(1), n); }},
+        {"Q15.DotBatch.Vec4q15", true, 7, {8, 8, 2}, 0, nullptr,
+            [](Arena& a, size_t n) { DotBatch(a.Get<Vec4q15>(0), a.Get<Vec4q15>(1), a.Get<Q15>(2), n); }},
+        {"Mat4q.TransformBatch", true, 28, {sizeof(Vec4q), sizeof(Vec4q)}, 0,
+            [](Arena& a, size_t n) { FillQ16(a.Get<Q16>(0), n * 4); },
+            [](Arena& a, size_t n) { TransformBatch(Model4q, a.Get<Vec4q>(0), a.Get<Vec4q>(1), n); }},
+        {"Mat4q.Multiply", true, 112, {sizeof(Mat4q), sizeof(Mat4q)}, 0,
+            [](Arena& a, size_t n) { FillQ16(a.Get<Q16>(0), n * 16); },
+            [](Arena& a, size_t n) { Map<Mat4q, Mat4q>(a, n, [](const Mat4q& m) { return m * Model4q; }); }},
+
+        //* Half precision
+        {"HalfToFloatBatch", true, 0, {2, F}, 0, InitHalfIn,
+            [](Arena& a, size_t n) { HalfToFloatBatch(a.Get<Half>(0), a.Get<float>(1), n); }},
+        {"FloatToHalfBatch", true, 0, {F, 2}, 0, nullptr,
+            [](Arena& a, size_t n) { FloatToHalfBatch(a.Get<float>(0), a.Get<Half>(1), n); }},
+
+        //* TransformHierarchy
+        {"TransformHierarchy.Update", true, 112, {}, 2 * M + 8, InitTree,
+            [](Arena& a, size_t) { a.tree.SetLocal(0, Model); a.tree.Update(); }},
+
+        //* Parallel batches on ThreadPool::Default()
+        {"Parallel.TransformPointBatch.Vec3f>Vec4f", true, 24, {V3, V4}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformPointBatch(ThreadPool::Default(), Model, a.Get<Vec3f>(0), a.Get<Vec4f>(1), n); }},
+        {"Parallel.NormalizeBatch.Exact", true, 10, {V3, V3}, 0, nullptr,
+            [](Arena& a, size_t n) { NormalizeBatch(ThreadPool::Default(), a.Get<Vec3f>(0), a.Get<Vec3f>(1), n); }},
+        {"Parallel.ProjectBatch.Vec2f", true, 32, {V3, V2, F}, 0, nullptr,
+            [](Arena& a, size_t n) { ProjectBatch(ThreadPool::Default(), ModelViewProj, Screen, a.Get<Vec3f>(0), a.Get<Vec2f>(1), a.Get<float>(2), n); }},
+
+        //* Bounds
+        {"ComputeBounds", true, 6, {V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Sink(ComputeBounds(a.Get<Vec3f>(0), n).max.x); }},
+        {"ComputeCentroid", true, 3, {V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Sink(ComputeCentroid(a.Get<Vec3f>(0), n).x); }},
+        {"RitterSphere", true, 0, {V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Sink(RitterSphere(a.Get<Vec3f>(0), n).radius); }},
+        {"EposSphere", true, 0, {V3}, 0, nullptr,
+            [](Arena& a, size_t n) { Sink(EposSphere(a.Get<Vec3f>(0), n).radius); }},
+        {"TransformAABB", true, 39, {sizeof(AABB3), sizeof(AABB3)}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformAABB(Model, a.Get<AABB3>(0), a.Get<AABB3>(1), n); }},
+        {"TransformAABB.PerMatrix", true, 39, {sizeof(AABB3), sizeof(AABB3), M}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformAABB(a.Get<Mat4>(2), a.Get<AABB3>(0), a.Get<AABB3>(1), n); }},
+        {"TransformSphere", true, 19, {sizeof(BoundingSphere), sizeof(BoundingSphere)}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformSphere(Model, a.Get<BoundingSphere>(0), a.Get<BoundingSphere>(1), n); }},
+        {"TransformSphere.PerMatrix", true, 50, {sizeof(BoundingSphere), sizeof(BoundingSphere), M}, 0, nullptr,
+            [](Arena& a, size_t n) { TransformSphere(a.Get<Mat4>(2), a.Get<BoundingSphere>(0), a.Get<BoundingSphere>(1), n); }},
+
+        //* Rays
+        {"IntersectRays.64Tris", true, 0, {sizeof(Ray), sizeof(RayHit)}, 0, InitRays,
+            [](Arena& a, size_t n) { IntersectRays(a.Get<Ray>(0), a.Get<RayHit>(1), n, MeshVertices, MeshIndices, MeshTriangles); }},
+        {"IntersectAABB.Packet", true, 0, {sizeof(RayPacket)}, 0, InitRayPackets,
+            [](Arena& a, size_t n) {
+                const RayPacket* p = a.Get<RayPacket>(0);
+                const AABB3 box(Vec3f(-0.5f), Vec3f(0.5f));
+                uint32_t hits = 0;
+                for (size_t i = 0; i < n; i++)
+                    hits ^= IntersectAABB(p[i], box, nullptr);
+                Sink(static_cast<float>(hits));
+            }},
+
+        //* Bvh
+        {"Bvh.Build", false, 0, {3 * V3, 12}, 0, InitMesh,
+            [](Arena& a, size_t n) { a.bvh.Build(a.Get<Vec3f>(0), a.Get<uint32_t>(1), n); }},
+        {"Parallel.Bvh.Build", false, 0, {3 * V3, 12}, 0, InitMesh,
+            [](Arena& a, size_t n) { a.bvh.Build(ThreadPool::Default(), a.Get<Vec3f>(0), a.Get<uint32_t>(1), n); }},
+        {"Bvh.Refit", false, 0, {3 * V3}, 76, InitMeshBvh,
+            [](Arena& a, size_t) { a.bvh.Refit(a.Get<Vec3f>(0)); }},
+        {"Bvh.Intersect.64KTris", true, 0, {sizeof(Ray), sizeof(RayHit)}, 0, InitBvhRays,
+            [](Arena& a, size_t n) { a.bvh.Intersect(a.Get<Ray>(0), a.Get<RayHit>(1), n, BvhVertices.data()); }},
+        {"Bvh.Occluded.64KTris", true, 0, {sizeof(Ray)}, 0, InitBvhRays,
+            [](Arena& a, size_t n) {
+                const Ray* rays = a.Get<Ray>(0);
+                uint32_t hits = 0;
+                for (size_t i = 0; i < n; i++)
+                    hits += a.bvh.Occluded(rays[i], BvhVertices.data());
+                Sink(static_cast<float>(hits));
+            }},
+    };
+}
+
+//**********************************************************************
+//* Measurement
+//**********************************************************************
+struct Result
+{
+    const Case* c;
+    const char* backend;
+    size_t n;
+    size_t workingSet;
+    double nsPerOp;
+    double gflops;        // < 0 when not applicable
+    double bytesPerCycle; // < 0 when not available
+};
+
+struct Options
+{
+    bool csv = false;
+    bool quick = false;
+    bool list = false;
+    const char* filter = nullptr;
+    const char* out = nullptr;
+};
+
+/**
+ * @brief Time n elements of a case at the active SIMD level
+ */
+static Result Measure(const Case& c, Arena& a, size_t n, const Options& opt)
+{
+    const Timing t = TimeRuns([&] { c.run(a, n); }, opt.quick);
+    const double ops = static_cast<double>(n) * t.reps;
+    Result r;
+    r.c = &c;
+    r.backend = nullptr;
+    r.n = n;
+    r.workingSet = n * c.Traffic();
+    r.nsPerOp = t.ns / ops;
+    r.gflops = c.ops > 0 ? c.ops * ops / t.ns : -1.0;
+#ifdef VECTOR_BENCH_TSC
+    r.bytesPerCycle = t.ticks ? static_cast<double>(c.Traffic()) * ops / t.ticks : -1.0;
+#else
+    r.bytesPerCycle = -1.0;
+#endif
+    return r;
+}
+
+//**********************************************************************
+//* Output
+//**********************************************************************
+static void WriteJson(FILE* f, const std::vector<Result>& results)
+{
+    fprintf(f, "{\n");
+    WriteBuildInfo(f);
+    fprintf(f, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Result& r = results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"backend\": \"%s\", \"n\": %zu, \"working_set_bytes\": %zu, \"ns_per_op\": ",
+                r.c->name, r.backend, r.n, r.workingSet);
+        PrintNumber(f, r.nsPerOp);
+        fputs(", \"gflops\": ", f);
+        PrintNumber(f, r.gflops);
+        fputs(", \"bytes_per_cycle\": ", f);
+        PrintNumber(f, r.bytesPerCycle);
+        fputs(i + 1 < results.size() ? "},\n" : "}\n", f);
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+static void WriteCsv(FILE* f, const std::vector<Result>& results)
+{
+    fprintf(f, "name,backend,n,working_set_bytes,ns_per_op,gflops,bytes_per_cycle\n");
+    for (const Result& r : results)
+    {
+        fprintf(f, "%s,%s,%zu,%zu,%.6g,", r.c->name, r.backend, r.n, r.workingSet, r.nsPerOp);
+        if (r.gflops >= 0)
+            fprintf(f, "%.6g", r.gflops);
+        fputc(',', f);
+        if (r.bytesPerCycle >= 0)
+            fprintf(f, "%.6g", r.bytesPerCycle);
+        fputc('\n', f);
+    }
+}
+
+//**********************************************************************
+//* Main
+//**********************************************************************
+static bool ParseOptions(int argc, char** argv, Options& opt)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        if (!strcmp(arg, "--format=json"))
+            opt.csv = false;
+        else if (!strcmp(arg, "--format=csv"))
+            opt.csv = true;
+        else if (!strcmp(arg, "--quick"))
+            opt.quick = true;
+        else if (!strcmp(arg, "--list"))
+            opt.list = true;
+        else if (!strncmp(arg, "--filter=", 9))
+            opt.filter = arg + 9;
+        else if (!strncmp(arg, "--out=", 6))
+            opt.out = arg + 6;
+        else
+        {
+            fprintf(stderr,
+                    "usage: %s [--format=json|csv] [--out=FILE] [--filter=TEXT] [--quick] [--list]\n"
+                    "  --format  Output format, json by default\n"
+                    "  --out     Write the results to FILE instead of stdout\n"
+                    "  --filter  Only run the cases whose name contains TEXT\n"
+                    "  --quick   L1 and L2 sized working sets and shorter samples\n"
+                    "  --list    Print the case names and exit\n",
+                    argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseOptions(argc, argv, opt))
+        return 2;
+
+    const std::vector<Case> cases = BuildCases();
+    if (opt.list)
+    {
+        for (const Case& c : cases)
+            printf("%s\n", c.name);
+        return 0;
+    }
+
+#ifndef __OPTIMIZE__
+    fprintf(stderr, "vector_bench: built without optimization, the numbers are not representative\n");
+#endif
+
+    // L1, L2, last level cache and DRAM resident working sets
+    static const size_t fullSizes[] = {16 << 10, 256 << 10, 4 << 20, 64 << 20};
+    static const size_t quickSizes[] = {16 << 10, 256 << 10};
+    const size_t* sizes = opt.quick ? quickSizes : fullSizes;
+    const size_t sizeCount = opt.quick ? 2 : 4;
+
+    const SimdLevel host = SimdHostLevel();
+    Arena arena;
+    std::vector<Result> results;
+
+    for (const Case& c : cases)
+    {
+        if (opt.filter && !strstr(c.name, opt.filter))
+            continue;
+        fprintf(stderr, "%s\n", c.name);
+
+        for (size_t s = 0; s < sizeCount; s++)
+        {
+            const size_t n = std::max<size_t>(sizes[s] / c.Traffic(), 32);
+            for (int i = 0; i < Arena::Arrays; i++)
+            {
+                if (!c.arrays[i])
+                    continue;
+                arena.Reserve(i, n * c.arrays[i]);
+                FillFloats(arena.ptr[i], n * c.arrays[i] / sizeof(float));
+            }
+            if (c.init)
+                c.init(arena, n);
+
+            if (!c.dispatched)
+            {
+                Result r = Measure(c, arena, n, opt);
+                r.backend = "inline";
+                results.push_back(r);
+                continue;
+            }
+            for (int l = 0; l <= static_cast<int>(host); l++)
+            {
+                const SimdLevel level = SimdSetLevel(static_cast<SimdLevel>(l));
+                Result r = Measure(c, arena, n, opt);
+                r.backend = SimdLevelName(level);
+                results.push_back(r);
+            }
+            SimdSetLevel(host);
+        }
+    }
+
+    FILE* f = stdout;
+    if (opt.out)
+    {
+        f = fopen(opt.out, "w");
+        if (!f)
+        {
+            fprintf(stderr, "vector_bench: cannot open %s\n", opt.out);
+            return 1;
+        }
+    }
+    if (opt.csv)
+        WriteCsv(f, results);
+    else
+        WriteJson(f, results);
+    if (f != stdout)
+        fclose(f);
+    return 0;
+}
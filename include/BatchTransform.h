@@ -0,0 +1,286 @@
+/**
+ * @file: BatchTransform.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BATCH_TRANSFORM_H
+#define BATCH_TRANSFORM_H
+
+#include <stddef.h>
+#include "Vector.h"
+#include "Mat4.h"
+#include "Mat3x4.h"
+#include "Half.h"
+#include "Simd.h"
+
+// Array versions of "v * m", using the widest SIMD kernel available on the
+// host. The scalar and SSE4.1 levels give the same bits as v * m, which sums
+// (x*r0 + y*r1) + (z*r2 + w*r3) on every level (see Mat4.h), as long as the
+// caller is built without FP contraction (see Simd.h). AVX2 and up fuse
+// the x and z products into FMAs and can differ in the last bits. Either way,
+// component j is within 2 * FLT_EPSILON * (|x*m0j| + |y*m1j| + |z*m2j| +
+// |w*m3j|) of the exact value.
+// Input and output arrays may be the same array, but must not partially overlap.
+
+/**
+ * @brief Transform an array of homogeneous vectors
+ *
+ * @param m   Transformation matrix
+ * @param in  Input vectors
+ * @param out Output vectors. out[i] = in[i] * m
+ * @param n   Number of vectors
+ */
+void TransformBatch(const Mat4& m, const Vec4f* in, Vec4f* out, size_t n);
+
+/**
+ * @brief Transform an array of points (implicit w = 1) to homogeneous coordinates
+ *
+ * @param m   Transformation matrix
+ * @param in  Input points
+ * @param out Output vectors. out[i] = Vec4f(in[i], 1) * m
+ * @param n   Number of points
+ */
+void TransformPointBatch(const Mat4& m, const Vec3f* in, Vec4f* out, size_t n);
+
+/**
+ * @brief Transform an array of points (implicit w = 1).
+ *        The resulting w is discarded, so this is only meant for affine matrices.
+ *
+ * @param m   Transformation matrix
+ * @param in  Input points
+ * @param out Output points. x/y/z of Vec4f(in[i], 1) * m
+ * @param n   Number of points
+ */
+void TransformPointBatch(const Mat4& m, const Vec3f* in, Vec3f* out, size_t n);
+
+/**
+ * @brief Transform an array of directions (implicit w = 0). Translation is ignored.
+ *
+ * @param m   Transformation matrix
+ * @param in  Input directions
+ * @param out Output directions. x/y/z of Vec4f(in[i], 0) * m
+ * @param n   Number of directions
+ */
+void TransformDirectionBatch(const Mat4& m, const Vec3f* in, Vec3f* out, size_t n);
+
+//**********************************************************************
+//* Half precision vertices
+//**********************************************************************
+// Vertices stored as Vec3f16/Vec4f16 (see Half.h) are widened to float on
+// load and half outputs are narrowed, rounding to nearest even, on store.
+// out[i] is exactly what converting in[i] to float, calling the float
+// overload above and converting the result back would give. AVX2 does the
+// conversions in registers with F16C, the other levels convert in blocks.
+
+/**
+ * @brief Transform an array of half precision homogeneous vectors
+ *
+ * @param m   Transformation matrix
+ * @param in  Input vectors
+ * @param out Output vectors. out[i] = FloatToHalf(HalfToFloat(in[i]) * m)
+ * @param n   Number of vectors
+ */
+void TransformBatch(const Mat4& m, const Vec4f16* in, Vec4f16* out, size_t n);
+
+/**
+ * @brief Transform an array of half precision points (implicit w = 1)
+ *        to float homogeneous coordinates, e.g. ahead of clipping
+ *
+ * @param m   Transformation matrix
+ * @param in  Input points
+ * @param out Output vectors. out[i] = Vec4f(HalfToFloat(in[i]), 1) * m
+ * @param n   Number of points
+ */
+void TransformPointBatch(const Mat4& m, const Vec3f16* in, Vec4f* out, size_t n);
+
+/**
+ * @brief Transform an array of half precision points (implicit w = 1).
+ *        The resulting w is discarded, so this is only meant for affine matrices.
+ *
+ * @param m   Transformation matrix
+ * @param in  Input points
+ * @param out Output points. x/y/z of Vec4f(HalfToFloat(in[i]), 1) * m
+ * @param n   Number of points
+ */
+void TransformPointBatch(const Mat4& m, const Vec3f16* in, Vec3f16* out, size_t n);
+
+/**
+ * @brief Transform an array of half precision directions (implicit w = 0)
+ *
+ * @param m   Transformation matrix
+ * @param in  Input directions
+ * @param out Output directions. x/y/z of Vec4f(HalfToFloat(in[i]), 0) * m
+ * @param n   Number of directions
+ */
+void TransformDirectionBatch(const Mat4& m, const Vec3f16* in, Vec3f16* out, size_t n);
+
+//**********************************************************************
+//* Projection to screen space
+//**********************************************************************
+/**
+ * @brief Mapping from normalized device coordinates ([-1, 1] on both axes,
+ *        Y up) to screen pixels (Y down).
+ */
+struct Viewport
+{
+    /**
+     * @brief Build the mapping for a screen rectangle
+     *
+     * @param x      Left edge in pixels
+     * @param y      Top edge in pixels
+     * @param width  Width in pixels
+     * @param height Height in pixels
+     */
+    constexpr Viewport(float x, float y, float width, float height) :
+        scaleX(width * 0.5f), scaleY(-height * 0.5f),
+        offsetX(x + width * 0.5f), offsetY(y + height * 0.5f)
+    {}
+
+    // screen = ndc * scale + offset
+    float scaleX;
+    float scaleY;
+    float offsetX;
+    float offsetY;
+};
+
+// Fused "v * mvp", Homogenize() and viewport mapping in a single pass.
+// The w divide uses a reciprocal estimate refined with one Newton step
+// (relative error below 2^-22) on x86. Vertices with w <= 0 are not
+// handled in any special way, cull them beforehand.
+
+/**
+ * @brief Project model space points to screen coordinates
+ *
+ * @param mvp    Model-view-projection matrix (e.g. ending with Mat4::Projection)
+ * @param vp     Viewport mapping
+ * @param in     Model space points (implicit w = 1)
+ * @param screen Output screen coordinates
+ * @param invW   Output reciprocal clip w (1 / view depth for Mat4::Projection),
+ *               suitable for depth buffering. May be nullptr
+ * @param n      Number of points
+ */
+void ProjectBatch(const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2f* screen, float* invW, size_t n);
+
+/**
+ * @brief Project model space points to integer pixel coordinates.
+ *        Coordinates are rounded to the nearest integer.
+ */
+void ProjectBatch(const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2* screen, float* invW, size_t n);
+
+/**
+ * @brief Project model space points to 16 bit pixel coordinates.
+ *        Coordinates are rounded to the nearest integer and saturated to the int16_t range.
+ */
+void ProjectBatch(const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2h* screen, float* invW, size_t n);
+
+//**********************************************************************
+//* Matrix products
+//**********************************************************************
+// Array versions of "a * b". The scalar and SSE4.1 levels give the same bits
+// as operator* on each element under the same condition as TransformBatch(),
+// AVX2 and up fuse half of the products into FMAs.
+// C may be the same array as an input array, but must not partially overlap it.
+
+/**
+ * @brief Multiply two arrays of matrices element by element
+ *
+ * @param A Left matrices
+ * @param B Right matrices
+ * @param C Output matrices. C[i] = A[i] * B[i]
+ * @param n Number of matrices
+ */
+void MultiplyBatch(const Mat4* A, const Mat4* B, Mat4* C, size_t n);
+
+/**
+ * @brief Multiply one matrix by an array of matrices (e.g. parent * locals)
+ *
+ * @param A Shared left matrix. May be an element of C
+ * @param B Right matrices
+ * @param C Output matrices. C[i] = A * B[i]
+ * @param n Number of matrices
+ */
+void MultiplyBatch(const Mat4& A, const Mat4* B, Mat4* C, size_t n);
+
+/**
+ * @brief Multiply an array of matrices by one matrix (e.g. instances * view)
+ *
+ * @param A Left matrices
+ * @param B Shared right matrix. May be an element of C
+ * @param C Output matrices. C[i] = A[i] * B
+ * @param n Number of matrices
+ */
+void MultiplyBatch(const Mat4* A, const Mat4& B, Mat4* C, size_t n);
+
+/**
+ * @brief Compose two arrays of affine transforms element by element
+ *
+ * @param A Transforms applied first
+ * @param B Transforms applied second
+ * @param C Output transforms. C[i] = A[i] * B[i]
+ * @param n Number of transforms
+ */
+void MultiplyBatch(const Mat3x4* A, const Mat3x4* B, Mat3x4* C, size_t n);
+
+/**
+ * @brief Compose one affine transform with an array of transforms
+ *
+ * @param A Shared transform applied first. May be an element of C
+ * @param B Transforms applied second
+ * @param C Output transforms. C[i] = A * B[i]
+ * @param n Number of transforms
+ */
+void MultiplyBatch(const Mat3x4& A, const Mat3x4* B, Mat3x4* C, size_t n);
+
+/**
+ * @brief Compose an array of affine transforms with one transform
+ *
+ * @param A Transforms applied first
+ * @param B Shared transform applied second. May be an element of C
+ * @param C Output transforms. C[i] = A[i] * B
+ * @param n Number of transforms
+ */
+void MultiplyBatch(const Mat3x4* A, const Mat3x4& B, Mat3x4* C, size_t n);
+
+/**
+ * @brief Transform an array of points by an affine transform. Within the
+ *        error bound of the Mat4 overloads, but not bit-identical to
+ *        TransformPoint(), which sums left to right.
+ *
+ * @param m   Affine transform
+ * @param in  Input points
+ * @param out Output points. out[i] = m.TransformPoint(in[i])
+ * @param n   Number of points
+ */
+void TransformPointBatch(const Mat3x4& m, const Vec3f* in, Vec3f* out, size_t n);
+
+/**
+ * @brief Transform an array of directions by an affine transform. Translation is ignored.
+ *        Same accuracy as TransformPointBatch().
+ *
+ * @param m   Affine transform
+ * @param in  Input directions
+ * @param out Output directions. out[i] = m.TransformDirection(in[i])
+ * @param n   Number of directions
+ */
+void TransformDirectionBatch(const Mat3x4& m, const Vec3f* in, Vec3f* out, size_t n);
+
+#endif // BATCH_TRANSFORM_H
@@ -0,0 +1,452 @@
+/**
+ * @file: Bounds.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <stddef.h>
+#include <assert.h>
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include "Vector.h"
+#include "Mat4.h"
+#include "ThreadPool.h"
+
+//**********************************************************************
+//* Axis aligned bounding box
+//**********************************************************************
+/**
+ * @brief Axis aligned box given by its minimum and maximum corners.
+ *        A box with min > max on any axis is empty.
+ */
+class AABB3
+{
+public:
+    //******************************************************************
+    //* Constructors
+    //******************************************************************
+    /** @brief Default constructor. Corners are left uninitialized. */
+    AABB3() = default;
+
+    /** @brief Construct from the minimum and maximum corners. */
+    constexpr AABB3(const Vec3f& min, const Vec3f& max) : min(min), max(max) {}
+
+    /** @brief Empty box, the identity of Expand() and Merge(). */
+    static constexpr AABB3 Empty()
+    {
+        return AABB3(Vec3f(std::numeric_limits<float>::infinity()),
+                     Vec3f(-std::numeric_limits<float>::infinity()));
+    }
+
+    /** @brief Box from its center and half size. */
+    static AABB3 FromCenterExtent(const Vec3f& center, const Vec3f& extent)
+    {
+        return AABB3(center - extent, center + extent);
+    }
+    //******************************************************************
+
+    //******************************************************************
+    //* Methods
+    //******************************************************************
+    /** @brief True if the box contains no point. */
+    bool IsEmpty() const
+    {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    /** @brief Center of a non empty box. */
+    Vec3f Center() const { return (min + max) * 0.5f; }
+
+    /** @brief Half size of a non empty box. */
+    Vec3f Extent() const { return (max - min) * 0.5f; }
+
+    /** @brief Edge lengths of a non empty box. */
+    Vec3f Size() const { return max - min; }
+
+    /** @brief Surface area of a non empty box. */
+    float SurfaceArea() const
+    {
+        const Vec3f s = Size();
+        return 2.0f * (s.x*s.y + s.y*s.z + s.z*s.x);
+    }
+
+    /** @brief Volume of a non empty box. */
+    float Volume() const
+    {
+        const Vec3f s = Size();
+        return s.x * s.y * s.z;
+    }
+
+    /** @brief Grow the box to contain a point. */
+    void Expand(const Vec3f& p)
+    {
+        min = ::min(min, p);
+        max = ::max(max, p);
+    }
+
+    /** @brief Grow the box to contain another box. */
+    void Expand(const AABB3& b)
+    {
+        min = ::min(min, b.min);
+        max = ::max(max, b.max);
+    }
+
+    /** @brief True if the point is inside or on the boundary. */
+    bool Contains(const Vec3f& p) const
+    {
+        return p.x >= min.x && p.y >= min.y && p.z >= min.z &&
+               p.x <= max.x && p.y <= max.y && p.z <= max.z;
+    }
+
+    /** @brief True if b is completely inside. Empty boxes are inside any box. */
+    bool Contains(const AABB3& b) const
+    {
+        return b.IsEmpty() || (b.min.x >= min.x && b.min.y >= min.y && b.min.z >= min.z &&
+                               b.max.x <= max.x && b.max.y <= max.y && b.max.z <= max.z);
+    }
+
+    /** @brief True if the boxes share at least one point. */
+    bool Overlaps(const AABB3& b) const
+    {
+        return min.x <= b.max.x && min.y <= b.max.y && min.z <= b.max.z &&
+               b.min.x <= max.x && b.min.y <= max.y && b.min.z <= max.z;
+    }
+
+    /** @brief Squared distance from a point to the box, 0 inside. */
+    float DistanceSquared(const Vec3f& p) const
+    {
+        const Vec3f d = ::max(::max(min - p, p - max), Vec3f(0.0f));
+        return d * d;
+    }
+    //******************************************************************
+
+    Vec3f min;
+    Vec3f max;
+};
+
+/** @brief Smallest box containing both boxes. */
+inline AABB3 Merge(const AABB3& a, const AABB3& b)
+{
+    return AABB3(min(a.min, b.min), max(a.max, b.max));
+}
+
+/** @brief Common part of both boxes, empty if they do not overlap. */
+inline AABB3 Intersect(const AABB3& a, const AABB3& b)
+{
+    return AABB3(max(a.min, b.min), min(a.max, b.max));
+}
+
+//**********************************************************************
+//* Bounding sphere
+//**********************************************************************
+/**
+ * @brief Sphere given by its center and radius.
+ *
+ * Expand() and Merge() pad the radius by the rounding error of the new
+ * center, so the result always contains the old sphere and the new point.
+ */
+class BoundingSphere
+{
+public:
+    //******************************************************************
+    //* Constructors
+    //******************************************************************
+    /** @brief Default constructor. Members are left uninitialized. */
+    BoundingSphere() = default;
+
+    /** @brief Construct from center and radius. */
+    constexpr BoundingSphere(const Vec3f& center, float radius) : center(center), radius(radius) {}
+    //******************************************************************
+
+    //******************************************************************
+    //* Methods
+    //******************************************************************
+    /** @brief True if the point is inside or on the surface. */
+    bool Contains(const Vec3f& p) const
+    {
+        return DistanceBetweenSquared(center, p) <= radius * radius;
+    }
+
+    /** @brief True if s is completely inside. */
+    bool Contains(const BoundingSphere& s) const
+    {
+        const float room = radius - s.radius;
+        return room >= 0 && DistanceBetweenSquared(center, s.center) <= room * room;
+    }
+
+    /** @brief True if the spheres share at least one point. */
+    bool Overlaps(const BoundingSphere& s) const
+    {
+        const float r = radius + s.radius;
+        return DistanceBetweenSquared(center, s.center) <= r * r;
+    }
+
+    /** @brief True if the sphere and the box share at least one point. */
+    bool Overlaps(const AABB3& b) const
+    {
+        return b.DistanceSquared(center) <= radius * radius;
+    }
+
+    /** @brief Box around the sphere. */
+    AABB3 Bounds() const
+    {
+        return AABB3::FromCenterExtent(center, Vec3f(radius));
+    }
+
+    /**
+     * @brief Grow the sphere to contain a point (Ritter's update). The
+     *        far side of the sphere stays in place and the center moves
+     *        towards the point.
+     */
+    void Expand(const Vec3f& p)
+    {
+        const Vec3f d = p - center;
+        const float dist2 = d * d;
+        if (dist2 <= radius * radius)
+            return;
+
+        const float dist = std::sqrt(dist2);
+        const float grown = (radius + dist) * 0.5f;
+        center += d * ((grown - radius) / dist);
+        radius = grown + slack(grown);
+    }
+
+    /** @brief Grow the sphere to contain another sphere. */
+    void Expand(const BoundingSphere& s)
+    {
+        const Vec3f d = s.center - center;
+        const float dist = std::sqrt(d * d);
+        if (dist + s.radius <= radius)
+            return;
+        if (dist + radius <= s.radius)
+        {
+            *this = s;
+            return;
+        }
+
+        const float grown = (dist + radius + s.radius) * 0.5f;
+        center += d * ((grown - radius) / dist);
+        radius = grown + slack(grown);
+    }
+    //******************************************************************
+
+    Vec3f center;
+    float radius;
+
+private:
+    // Bound on the error of a center just moved by up to r
+    float slack(float r) const
+    {
+        return 4 * FLT_EPSILON * (std::fabs(center.x) + std::fabs(center.y) + std::fabs(center.z) + r);
+    }
+};
+
+/** @brief Sphere containing both spheres. */
+inline BoundingSphere Merge(const BoundingSphere& a, const BoundingSphere& b)
+{
+    BoundingSphere s = a;
+    s.Expand(b);
+    return s;
+}
+
+//**********************************************************************
+//* Transforms
+//**********************************************************************
+// Bounds of transformed boxes and spheres without touching their corners or
+// surface. Matrices must be affine (last column 0, 0, 0, 1) and boxes non
+// empty. The batch kernels do the same float operations in the same order
+// as the single versions, so the results are bit-identical on every level
+// as long as the including code is built without FP contraction (see
+// Simd.h).
+
+/**
+ * @brief Upper bound of |d * m| / |d| over all directions d, i.e. the
+ *        largest scale factor of the upper 3x3 part of m.
+ *
+ * Gershgorin bound on the rows' Gram matrix: exact when the rows are
+ * orthogonal (scale then rotate), conservative for any other matrix.
+ */
+inline float MaxStretch(const Mat4& m)
+{
+    float g[3][3];
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            g[i][j] = m.data[i][0]*m.data[j][0] + m.data[i][1]*m.data[j][1] + m.data[i][2]*m.data[j][2];
+
+    float worst = 0.0f;
+    for (int i = 0; i < 3; i++)
+    {
+        const float row = g[i][i] + std::fabs(g[i][(i + 1) % 3]) + std::fabs(g[i][(i + 2) % 3]);
+        worst = row > worst ? row : worst;
+    }
+    return std::sqrt(worst);
+}
+
+/**
+ * @brief Box around a transformed box (Arvo). The center is transformed as
+ *        a point and the new half size on each axis is the old half size
+ *        times the absolute values of the 3x3 part.
+ *
+ * @param m Affine transform
+ * @param b Non empty box
+ * @return AABB3 Smallest box containing the 8 transformed corners
+ */
+inline AABB3 TransformAABB(const Mat4& m, const AABB3& b)
+{
+    const Vec3f c = b.Center();
+    const Vec3f e = b.Extent();
+    AABB3 r;
+    for (int j = 0; j < 3; j++)
+    {
+        const float tc = (c.x*m.data[0][j] + c.y*m.data[1][j]) + (c.z*m.data[2][j] + m.data[3][j]);
+        const float te = (e.x*std::fabs(m.data[0][j]) + e.y*std::fabs(m.data[1][j])) + e.z*std::fabs(m.data[2][j]);
+        r.min[j] = tc - te;
+        r.max[j] = tc + te;
+    }
+    return r;
+}
+
+/**
+ * @brief Sphere around a transformed sphere. The center is transformed as a
+ *        point and the radius scaled by MaxStretch(m).
+ */
+inline BoundingSphere TransformSphere(const Mat4& m, const BoundingSphere& s)
+{
+    const Vec3f& c = s.center;
+    BoundingSphere r;
+    for (int j = 0; j < 3; j++)
+        r.center[j] = (c.x*m.data[0][j] + c.y*m.data[1][j]) + (c.z*m.data[2][j] + m.data[3][j]);
+    r.radius = s.radius * MaxStretch(m);
+    return r;
+}
+
+/**
+ * @brief Transform an array of boxes by one matrix
+ *
+ * @param m   Affine transform
+ * @param in  Input boxes
+ * @param out Output boxes. out[i] = TransformAABB(m, in[i]). May be in
+ * @param n   Number of boxes
+ */
+void TransformAABB(const Mat4& m, const AABB3* in, AABB3* out, size_t n);
+
+/**
+ * @brief Transform an array of boxes, each by its own matrix (e.g. local
+ *        bounds by world matrices)
+ *
+ * @param m   Affine transforms
+ * @param in  Input boxes
+ * @param out Output boxes. out[i] = TransformAABB(m[i], in[i]). May be in
+ * @param n   Number of boxes
+ */
+void TransformAABB(const Mat4* m, const AABB3* in, AABB3* out, size_t n);
+
+/**
+ * @brief Transform an array of spheres by one matrix
+ *
+ * @param m   Affine transform
+ * @param in  Input spheres
+ * @param out Output spheres. out[i] = TransformSphere(m, in[i]). May be in
+ * @param n   Number of spheres
+ */
+void TransformSphere(const Mat4& m, const BoundingSphere* in, BoundingSphere* out, size_t n);
+
+/**
+ * @brief Transform an array of spheres, each by its own matrix
+ *
+ * @param m   Affine transforms
+ * @param in  Input spheres
+ * @param out Output spheres. out[i] = TransformSphere(m[i], in[i]). May be in
+ * @param n   Number of spheres
+ */
+void TransformSphere(const Mat4* m, const BoundingSphere* in, BoundingSphere* out, size_t n);
+
+//**********************************************************************
+//* Reductions over point arrays
+//**********************************************************************
+// SSE4.1/AVX2 kernels cut the array into fixed chunks of points and combine
+// the chunk results in order, so the overloads taking a ThreadPool return
+// exactly the same value as the single threaded ones. Points must be finite.
+
+/**
+ * @brief Bounding box of an array of points
+ *
+ * @param points Input points
+ * @param n      Number of points
+ * @return AABB3 Smallest box containing every point, empty if n is 0
+ */
+AABB3 ComputeBounds(const Vec3f* points, size_t n);
+
+/** @brief ComputeBounds() split over the pool threads. */
+AABB3 ComputeBounds(ThreadPool& pool, const Vec3f* points, size_t n);
+
+/**
+ * @brief Average of an array of points, accumulated in double precision
+ *
+ * @param points Input points
+ * @param n      Number of points, at least one
+ * @return Vec3f Centroid
+ */
+Vec3f ComputeCentroid(const Vec3f* points, size_t n);
+
+/** @brief ComputeCentroid() split over the pool threads. */
+Vec3f ComputeCentroid(ThreadPool& pool, const Vec3f* points, size_t n);
+
+/**
+ * @brief Ritter's bounding sphere. Starts from the segment between a point
+ *        far from the first one and the point farthest from it, then grows
+ *        the sphere until it contains every point.
+ *
+ * Up to 10-20% larger than the minimum sphere. Three passes over the
+ * points for typical inputs.
+ *
+ * @param points Input points
+ * @param n      Number of points, at least one
+ * @return BoundingSphere Sphere containing every point
+ */
+BoundingSphere RitterSphere(const Vec3f* points, size_t n);
+
+/** @brief RitterSphere() split over the pool threads. */
+BoundingSphere RitterSphere(ThreadPool& pool, const Vec3f* points, size_t n);
+
+/**
+ * @brief EPOS-14 bounding sphere (Larsson). Takes the extreme points along
+ *        the 3 axes and 4 diagonals, starts from the minimum sphere of those
+ *        14 points and grows it until it contains every point.
+ *
+ * Usually within a few percent of the minimum sphere. Two passes over the
+ * points for typical inputs.
+ *
+ * @param points Input points
+ * @param n      Number of points, at least one
+ * @return BoundingSphere Sphere containing every point
+ */
+BoundingSphere EposSphere(const Vec3f* points, size_t n);
+
+/** @brief EposSphere() split over the pool threads. */
+BoundingSphere EposSphere(ThreadPool& pool, const Vec3f* points, size_t n);
+
+#endif // BOUNDS_H
@@ -0,0 +1,171 @@
+/**
+ * @file: Bvh.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BVH_H
+#define BVH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "Vector.h"
+#include "Bounds.h"
+#include "Ray.h"
+#include "ThreadPool.h"
+
+//**********************************************************************
+//* Bounding volume hierarchy over triangle meshes
+//**********************************************************************
+/**
+ * @brief Binary BVH over an indexed triangle mesh, built with the binned
+ *        surface area heuristic.
+ *
+ * Nodes are 32 bytes and stored in one array. The two children of an inner
+ * node are adjacent and always come after their parent, so a refit is a
+ * single backward pass. The triangles are reordered so each leaf is a
+ * contiguous range; Indices() holds the reordered vertex indices and
+ * Primitives() maps every reordered triangle back to its index in the
+ * mesh. Queries always report mesh triangle indices.
+ *
+ * The hierarchy does not keep the vertex array: every query and refit takes
+ * the current vertex positions, which must belong to the mesh it was built
+ * for.
+ *
+ * The build splits large nodes with parallel binning and then builds the
+ * remaining subtrees on separate threads. The tree does not depend on the
+ * number of threads.
+ */
+class Bvh
+{
+public:
+    /**
+     * @brief Tree node, 32 bytes
+     */
+    struct Node
+    {
+        Vec3f min;
+        uint32_t first; // Leaf: first triangle. Inner: first child, the second one follows it
+        Vec3f max;
+        uint32_t count; // Leaf: number of triangles. Inner: 0
+
+        bool IsLeaf() const { return count != 0; }
+        AABB3 Bounds() const { return AABB3(min, max); }
+    };
+
+    /** @brief Number of centroid bins per axis evaluated at each split. */
+    static constexpr int Bins = 16;
+
+    /** @brief Nodes with at most this many triangles become leaves when the SAH prefers it. */
+    static constexpr uint32_t MaxLeafSize = 8;
+
+    /** @brief Depth below which every node is a leaf, bounds the traversal stacks. */
+    static constexpr int MaxDepth = 48;
+
+    Bvh() = default;
+
+    /**
+     * @brief Build the hierarchy, replacing the previous one
+     *
+     * @param vertices Vertex positions
+     * @param indices  Vertex indices, three per triangle
+     * @param triCount Number of triangles
+     */
+    void Build(const Vec3f* vertices, const uint32_t* indices, size_t triCount);
+    void Build(ThreadPool& pool, const Vec3f* vertices, const uint32_t* indices, size_t triCount);
+
+    /**
+     * @brief Recompute every node box after the vertices moved. The tree
+     *        topology is kept, so queries stay correct but slow down if the
+     *        mesh deforms a lot; rebuild in that case.
+     *
+     * @param vertices New vertex positions, same mesh as the build
+     */
+    void Refit(const Vec3f* vertices);
+    void Refit(ThreadPool& pool, const Vec3f* vertices);
+
+    /** @brief Remove the hierarchy. */
+    void Clear();
+
+    /** @brief Root box, empty for an empty hierarchy. */
+    AABB3 Bounds() const { return nodes.empty() ? AABB3::Empty() : nodes[0].Bounds(); }
+
+    /** @brief Number of triangles. */
+    size_t Size() const { return prims.size(); }
+
+    const std::vector<Node>& Nodes() const { return nodes; }
+    const std::vector<uint32_t>& Indices() const { return indices; }
+    const std::vector<uint32_t>& Primitives() const { return prims; }
+
+    /**
+     * @brief Closest hit of one ray
+     *
+     * @param ray      Ray, tMax shrinks to the hit distance
+     * @param vertices Vertex positions
+     * @param hit      Updated with a hit closer than the incoming ray.tMax
+     * @return true If a closer hit was found
+     */
+    bool Intersect(Ray& ray, const Vec3f* vertices, RayHit& hit) const;
+
+    /**
+     * @brief Closest hit of every lane of a packet, same rules as the single ray query
+     */
+    void Intersect(RayPacket& rays, const Vec3f* vertices, RayPacketHit& hit) const;
+
+    /**
+     * @brief Closest hits of an array of rays, traced in packets of 8
+     *
+     * @param rays     Input rays
+     * @param hits     Output hits, prim is RayHit::None for misses
+     * @param n        Number of rays
+     * @param vertices Vertex positions
+     */
+    void Intersect(const Ray* rays, RayHit* hits, size_t n, const Vec3f* vertices) const;
+    void Intersect(ThreadPool& pool, const Ray* rays, RayHit* hits, size_t n, const Vec3f* vertices) const;
+
+    /**
+     * @brief Any hit test for shadow and visibility rays, stops at the first hit found
+     *
+     * @return true If some triangle is hit within [ray.tMin, ray.tMax)
+     */
+    bool Occluded(const Ray& ray, const Vec3f* vertices) const;
+
+    /**
+     * @brief Any hit test of every lane of a packet
+     *
+     * @return uint32_t Bit i set if lane i is occluded
+     */
+    uint32_t Occluded(const RayPacket& rays, const Vec3f* vertices) const;
+
+private:
+    void build(ThreadPool* pool, const Vec3f* vertices, const uint32_t* indices, size_t triCount);
+    void refit(ThreadPool* pool, const Vec3f* vertices);
+    void intersect(ThreadPool* pool, const Ray* rays, RayHit* hits, size_t n, const Vec3f* vertices) const;
+    AABB3 leafBounds(const Node& leaf, const Vec3f* vertices) const;
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> indices;  // Three vertex indices per triangle, in leaf order
+    std::vector<uint32_t> prims;    // Mesh triangle index of every reordered triangle
+};
+
+#endif // BVH_H
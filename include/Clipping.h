@@ -0,0 +1,117 @@
+/**
+ * @file: Clipping.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLIPPING_H
+#define CLIPPING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Vector.h"
+
+//**********************************************************************
+//* Clip space outcodes
+//**********************************************************************
+// A clip space vertex (after "v * mvp", before Homogenize()) is inside the
+// view volume when -w <= x <= w, -w <= y <= w and 0 <= z <= w.
+// For Mat4::Projection z equals w, so only the near bit is ever set on the
+// z axis and it flags vertices behind the camera.
+
+/**
+ * @brief One bit per view volume plane the vertex lies outside of
+ */
+enum ClipOutcode : uint8_t
+{
+    ClipLeft   = 1 << 0,  // x < -w
+    ClipRight  = 1 << 1,  // x >  w
+    ClipBottom = 1 << 2,  // y < -w
+    ClipTop    = 1 << 3,  // y >  w
+    ClipNear   = 1 << 4,  // z <  0
+    ClipFar    = 1 << 5,  // z >  w
+};
+
+/**
+ * @brief Outcode of a single clip space vertex
+ *
+ * @param v Clip space vertex
+ * @return uint8_t Combination of ClipOutcode bits. Zero if inside
+ */
+inline uint8_t ComputeOutcode(const Vec4f& v)
+{
+    return (v.x < -v.w ? ClipLeft   : 0) |
+           (v.x >  v.w ? ClipRight  : 0) |
+           (v.y < -v.w ? ClipBottom : 0) |
+           (v.y >  v.w ? ClipTop    : 0) |
+           (v.z <  0.0f ? ClipNear  : 0) |
+           (v.z >  v.w ? ClipFar    : 0);
+}
+
+/**
+ * @brief Compute the outcodes of an array of clip space vertices
+ *
+ * @param clip  Clip space vertices
+ * @param codes Output outcodes, one byte per vertex
+ * @param n     Number of vertices
+ */
+void ComputeOutcodes(const Vec4f* clip, uint8_t* codes, size_t n);
+
+//**********************************************************************
+//* Triangle trivial accept / reject
+//**********************************************************************
+// Results are bitmasks with one bit per triangle: bit (t % 32) of word
+// (t / 32). Each mask must hold (triCount + 31) / 32 words. Bits past
+// triCount in the last word are cleared. Every triangle sets exactly one
+// of the three masks:
+//  - accept:    all vertices inside, draw without clipping
+//  - reject:    all vertices outside the same plane, skip
+//  - needsClip: everything else
+
+/**
+ * @brief Size of a triangle bitmask in 32 bit words
+ */
+constexpr size_t TriangleMaskWords(size_t triCount)
+{
+    return (triCount + 31) / 32;
+}
+
+/**
+ * @brief Classify indexed triangles from their vertex outcodes
+ *
+ * @param codes     Vertex outcodes from ComputeOutcodes()
+ * @param indices   Vertex indices, three per triangle
+ * @param triCount  Number of triangles
+ * @param accept    Output trivially accepted mask. May be nullptr
+ * @param reject    Output trivially rejected mask. May be nullptr
+ * @param needsClip Output mask of triangles crossing the view volume. May be nullptr
+ * @return size_t   Number of trivially accepted triangles
+ */
+size_t ClassifyTriangles(const uint8_t* codes, const uint32_t* indices, size_t triCount,
+                         uint32_t* accept, uint32_t* reject, uint32_t* needsClip);
+
+/**
+ * @brief Classify indexed triangles from their vertex outcodes (16 bit indices)
+ */
+size_t ClassifyTriangles(const uint8_t* codes, const uint16_t* indices, size_t triCount,
+                         uint32_t* accept, uint32_t* reject, uint32_t* needsClip);
+
+#endif // CLIPPING_H
@@ -0,0 +1,136 @@
+/**
+ * @file: ConstexprMath.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONSTEXPR_MATH_H
+#define CONSTEXPR_MATH_H
+
+#include <cmath>
+
+//**********************************************************************
+//* Compile time evaluation helpers
+//**********************************************************************
+// The matrix algebra is constexpr so that fixed transforms can be computed
+// by the compiler and stored in flash/rodata. At runtime the same functions
+// keep calling the SIMD and assembly kernels: IsConstantEvaluated() tells
+// the two cases apart.
+
+#if defined(__has_builtin)
+    #if __has_builtin(__builtin_is_constant_evaluated)
+        #define VECTOR_HAS_CONSTANT_EVALUATED 1
+    #endif
+#elif defined(__GNUC__) && __GNUC__ >= 9
+    #define VECTOR_HAS_CONSTANT_EVALUATED 1
+#endif
+
+/**
+ * @brief True while the compiler evaluates a constant expression.
+ *
+ * Without compiler support it is always false: everything keeps working at
+ * runtime, but the matrix functions that use a kernel can not be used in
+ * constant expressions.
+ */
+constexpr bool IsConstantEvaluated()
+{
+#ifdef VECTOR_HAS_CONSTANT_EVALUATED
+    return __builtin_is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+namespace ConstexprMathDetail
+{
+    // pi/2 split in three parts. The first two have 33 significant bits, so
+    // k * part is exact for the quadrant numbers of any |x| < 2^20
+    constexpr double HalfPi1 = 1.57079632673412561417e+00;
+    constexpr double HalfPi2 = 6.07710050630396597660e-11;
+    constexpr double HalfPi3 = 2.02226624879595063154e-21;
+
+    // Taylor series on [-pi/4, pi/4], exact to double rounding
+    constexpr double Sin(double r)
+    {
+        const double r2 = r * r;
+        return r * (1.0 + r2 * (-1.0 / 6 + r2 * (1.0 / 120 + r2 * (-1.0 / 5040 + r2 * (1.0 / 362880
+                 + r2 * (-1.0 / 39916800 + r2 * (1.0 / 6227020800.0 + r2 * (-1.0 / 1307674368000.0))))))));
+    }
+
+    constexpr double Cos(double r)
+    {
+        const double r2 = r * r;
+        return 1.0 + r2 * (-1.0 / 2 + r2 * (1.0 / 24 + r2 * (-1.0 / 720 + r2 * (1.0 / 40320
+                 + r2 * (-1.0 / 3628800 + r2 * (1.0 / 479001600.0 + r2 * (-1.0 / 87178291200.0
+                 + r2 * (1.0 / 20922789888000.0))))))));
+    }
+
+    /** @brief sin(x) if cosine is false, cos(x) otherwise. */
+    constexpr float SinCos(float x, bool cosine)
+    {
+        // x = k * pi/2 + r, |r| <= pi/4
+        const double q = static_cast<double>(x) * 0.63661977236758134308;
+        const double k = static_cast<double>(static_cast<long long>(q < 0 ? q - 0.5 : q + 0.5));
+        const double r = ((static_cast<double>(x) - k * HalfPi1) - k * HalfPi2) - k * HalfPi3;
+
+        // cos(x) = sin(x + pi/2): shift the quadrant by one
+        const long long quadrant = (static_cast<long long>(k) + (cosine ? 1 : 0)) & 3;
+        switch (quadrant)
+        {
+        case 0:  return static_cast<float>(Sin(r));
+        case 1:  return static_cast<float>(Cos(r));
+        case 2:  return static_cast<float>(-Sin(r));
+        default: return static_cast<float>(-Cos(r));
+        }
+    }
+} // namespace ConstexprMathDetail
+
+/**
+ * @brief Sine usable in constant expressions.
+ *        Calls sinf() at runtime, so results do not change there.
+ *
+ * @param x Angle in radians. The compile time path is within 1 ulp for
+ *          |x| < 1e6
+ * @return float sin(x)
+ */
+constexpr float ConstexprSin(float x)
+{
+    if (!IsConstantEvaluated())
+        return sinf(x);
+    return ConstexprMathDetail::SinCos(x, false);
+}
+
+/**
+ * @brief Cosine usable in constant expressions.
+ *        Calls cosf() at runtime, so results do not change there.
+ *
+ * @param x Angle in radians. The compile time path is within 1 ulp for
+ *          |x| < 1e6
+ * @return float cos(x)
+ */
+constexpr float ConstexprCos(float x)
+{
+    if (!IsConstantEvaluated())
+        return cosf(x);
+    return ConstexprMathDetail::SinCos(x, true);
+}
+
+#endif // CONSTEXPR_MATH_H
@@ -0,0 +1,106 @@
+/**
+ * @file: FastMath.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include "Simd.h"
+
+/**
+ * @brief Accuracy tiers for square roots and normalization.
+ *
+ * Maximum InvSqrt() error over all positive normal floats, in ulp of the
+ * exact result:
+ *
+ *  - Exact:    std::sqrt followed by a true division.                1.5 ulp
+ *  - Fast:     x86: rsqrt estimate + one Newton-Raphson step.        5 ulp
+ *              Other targets: bit-trick estimate + two Newton steps. 75 ulp
+ *  - VeryFast: x86: raw rsqrt estimate (rel. error <= 1.5 * 2^-12).  5000 ulp
+ *              Other targets: bit-trick estimate + one Newton step.  28500 ulp
+ *
+ * On x86, the components of a normalized Vec3f deviate from the exact unit
+ * vector by at most 1.4e-7 (Exact), 2.4e-7 (Fast) and 3.2e-4 (VeryFast).
+ */
+enum class Precision : uint8_t
+{
+    Exact,
+    Fast,
+    VeryFast
+};
+
+/**
+ * @brief Reciprocal square root with the requested accuracy
+ *
+ * @param x Positive value
+ * @return float 1 / sqrt(x)
+ */
+template<Precision P = Precision::Exact>
+inline float InvSqrt(float x)
+{
+    if constexpr (P == Precision::Exact)
+    {
+        return 1.0f / std::sqrt(x);
+    }
+    else
+    {
+#if defined(VECTOR_X86_SIMD) && defined(__SSE__)
+        float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+        if constexpr (P == Precision::Fast)
+            y = y * (1.5f - 0.5f * x * y * y);
+#else
+        // Initial guess from the float bit pattern (~3.4% error)
+        uint32_t i;
+        memcpy(&i, &x, sizeof(i));
+        i = 0x5F375A86u - (i >> 1);
+        float y;
+        memcpy(&y, &i, sizeof(y));
+
+        y = y * (1.5f - 0.5f * x * y * y);
+        if constexpr (P == Precision::Fast)
+            y = y * (1.5f - 0.5f * x * y * y);
+#endif
+        return y;
+    }
+}
+
+/**
+ * @brief Square root with the requested accuracy
+ *
+ * @param x Non-negative value
+ * @return float sqrt(x). Zero maps to zero on every tier
+ */
+template<Precision P = Precision::Exact>
+inline float Sqrt(float x)
+{
+    if constexpr (P == Precision::Exact)
+        return std::sqrt(x);
+    else
+        return x * InvSqrt<P>(x > FLT_MIN ? x : FLT_MIN);
+}
+
+#endif // FAST_MATH_H
@@ -0,0 +1,489 @@
+/**
+ * @file: Fixed.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+#include <type_traits>
+#include "Vector.h"
+
+//**********************************************************************
+//* Fixed point scalars
+//**********************************************************************
+// Integer only arithmetic for targets without an FPU and for DSP paths where
+// converting to float costs more than the math itself. Every operation
+// rounds to nearest and saturates instead of wrapping. Only the conversions
+// to and from float touch floating point, and they are constexpr so
+// constants are converted by the compiler.
+
+namespace FixedDetail
+{
+    constexpr int32_t SaturateInt32(int64_t v)
+    {
+        return v > INT32_MAX ? INT32_MAX : (v < INT32_MIN ? INT32_MIN : static_cast<int32_t>(v));
+    }
+
+    constexpr int16_t SaturateInt16(int32_t v)
+    {
+        return v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : static_cast<int16_t>(v));
+    }
+
+    /** @brief round(f * 2^bits), saturated to [lo, hi]. NaN gives 0. */
+    constexpr int64_t FromFloat(float f, int bits, int64_t lo, int64_t hi)
+    {
+        const double d = static_cast<double>(f) * static_cast<double>(1LL << bits);
+        return d != d ? 0
+             : d >= static_cast<double>(hi) ? hi
+             : d <= static_cast<double>(lo) ? lo
+             : static_cast<int64_t>(d < 0 ? d - 0.5 : d + 0.5);
+    }
+
+    /** @brief Integer square root rounded to nearest. */
+    constexpr uint64_t Sqrt(uint64_t v)
+    {
+        uint64_t root = 0;
+        uint64_t bit = 1ULL << 62;
+        while (bit > v)
+            bit >>= 2;
+        while (bit != 0)
+        {
+            if (v >= root + bit)
+            {
+                v -= root + bit;
+                root = (root >> 1) + bit;
+            }
+            else
+            {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+        // v is now the remainder: round up when it is past root + 0.5
+        return v > root ? root + 1 : root;
+    }
+} // namespace FixedDetail
+
+/**
+ * @brief Q1.15 number: int16_t storing x * 2^15, range [-1, 1 - 2^-15].
+ *
+ * Products use (a * b + 2^14) >> 15, the same rounding as pmulhrsw, with
+ * (-1) * (-1) saturated to the largest value.
+ */
+class Q15
+{
+public:
+    static constexpr int FractionBits = 15;
+
+    /** @brief Default constructor. The value is left uninitialized. */
+    Q15() = default;
+
+    /** @brief Convert from float, rounding to nearest and saturating. */
+    constexpr explicit Q15(float f) :
+        raw(static_cast<int16_t>(FixedDetail::FromFloat(f, FractionBits, INT16_MIN, INT16_MAX))) {}
+
+    /** @brief Build from the raw integer representation. */
+    static constexpr Q15 FromRaw(int16_t r) { return Q15(r, Raw()); }
+
+    /** @brief Largest value, 1 - 2^-15. */
+    static constexpr Q15 Max() { return FromRaw(INT16_MAX); }
+
+    /** @brief Smallest value, -1. */
+    static constexpr Q15 Min() { return FromRaw(INT16_MIN); }
+
+    /** @brief Value as float. Exact. */
+    constexpr float ToFloat() const { return static_cast<float>(raw) * (1.0f / 32768.0f); }
+
+    constexpr explicit operator float() const { return ToFloat(); }
+
+    constexpr Q15 operator+(Q15 q) const { return FromRaw(FixedDetail::SaturateInt16(raw + q.raw)); }
+    constexpr Q15 operator-(Q15 q) const { return FromRaw(FixedDetail::SaturateInt16(raw - q.raw)); }
+    constexpr Q15 operator-() const { return FromRaw(FixedDetail::SaturateInt16(-raw)); }
+
+    constexpr Q15 operator*(Q15 q) const
+    {
+        return FromRaw(FixedDetail::SaturateInt16((raw * q.raw + (1 << 14)) >> 15));
+    }
+
+    constexpr Q15& operator+=(Q15 q) { return *this = *this + q; }
+    constexpr Q15& operator-=(Q15 q) { return *this = *this - q; }
+    constexpr Q15& operator*=(Q15 q) { return *this = *this * q; }
+
+    constexpr bool operator==(Q15 q) const { return raw == q.raw; }
+    constexpr bool operator!=(Q15 q) const { return raw != q.raw; }
+    constexpr bool operator< (Q15 q) const { return raw <  q.raw; }
+    constexpr bool operator<=(Q15 q) const { return raw <= q.raw; }
+    constexpr bool operator> (Q15 q) const { return raw >  q.raw; }
+    constexpr bool operator>=(Q15 q) const { return raw >= q.raw; }
+
+    int16_t raw;
+
+private:
+    struct Raw {};
+    constexpr Q15(int16_t r, Raw) : raw(r) {}
+};
+
+/**
+ * @brief Q16.16 number: int32_t storing x * 2^16, range [-32768, 32768 - 2^-16].
+ *
+ * Products and quotients are computed in 64 bits, rounded to nearest and
+ * saturated to the range.
+ */
+class Q16
+{
+public:
+    static constexpr int FractionBits = 16;
+
+    /** @brief Default constructor. The value is left uninitialized. */
+    Q16() = default;
+
+    /** @brief Integer value, saturated to the range. */
+    constexpr Q16(int i) : raw(FixedDetail::SaturateInt32(static_cast<int64_t>(i) * 65536)) {}
+
+    /** @brief Convert from float, rounding to nearest and saturating. */
+    constexpr explicit Q16(float f) :
+        raw(static_cast<int32_t>(FixedDetail::FromFloat(f, FractionBits, INT32_MIN, INT32_MAX))) {}
+
+    /**
+     * @brief No implicit conversion from floating point. It would otherwise
+     *        go through Q16(int) and truncate: q * 0.5f, Q16 x = 2.75.
+     *        Use Q16(0.5f) instead.
+     */
+    template <class F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0>
+    Q16(F) = delete;
+
+    /** @brief Widen a Q1.15 value. Exact. */
+    constexpr Q16(Q15 q) : raw(static_cast<int32_t>(q.raw) * 2) {}
+
+    /** @brief Build from the raw integer representation. */
+    static constexpr Q16 FromRaw(int32_t r) { return Q16(r, Raw()); }
+
+    /** @brief Largest value, 32768 - 2^-16. */
+    static constexpr Q16 Max() { return FromRaw(INT32_MAX); }
+
+    /** @brief Smallest value, -32768. */
+    static constexpr Q16 Min() { return FromRaw(INT32_MIN); }
+
+    /** @brief Value as float, rounded to 24 significant bits. */
+    constexpr float ToFloat() const { return static_cast<float>(raw) * (1.0f / 65536.0f); }
+
+    constexpr explicit operator float() const { return ToFloat(); }
+
+    /** @brief Largest integer not greater than the value. */
+    constexpr int32_t ToInt() const { return raw >> FractionBits; }
+
+    // Friends, so an integer works on either side (2 * q, 1 / q)
+    friend constexpr Q16 operator+(Q16 a, Q16 b)
+    {
+        return FromRaw(FixedDetail::SaturateInt32(static_cast<int64_t>(a.raw) + b.raw));
+    }
+
+    friend constexpr Q16 operator-(Q16 a, Q16 b)
+    {
+        return FromRaw(FixedDetail::SaturateInt32(static_cast<int64_t>(a.raw) - b.raw));
+    }
+
+    constexpr Q16 operator-() const
+    {
+        return FromRaw(FixedDetail::SaturateInt32(-static_cast<int64_t>(raw)));
+    }
+
+    friend constexpr Q16 operator*(Q16 a, Q16 b)
+    {
+        return FromRaw(FixedDetail::SaturateInt32((static_cast<int64_t>(a.raw) * b.raw + (1 << 15)) >> 16));
+    }
+
+    friend constexpr Q16 operator/(Q16 a, Q16 b)
+    {
+        assert(b.raw != 0 && "Q16: division by zero");
+        // Round half away from zero: bias the dividend by half the divisor
+        const int64_t n = static_cast<int64_t>(a.raw) * 65536;
+        const int64_t h = (b.raw < 0 ? -static_cast<int64_t>(b.raw) : b.raw) / 2;
+        return FromRaw(FixedDetail::SaturateInt32((n < 0 ? n - h : n + h) / b.raw));
+    }
+
+    constexpr Q16& operator+=(Q16 q) { return *this = *this + q; }
+    constexpr Q16& operator-=(Q16 q) { return *this = *this - q; }
+    constexpr Q16& operator*=(Q16 q) { return *this = *this * q; }
+    constexpr Q16& operator/=(Q16 q) { return *this = *this / q; }
+
+    friend constexpr bool operator==(Q16 a, Q16 b) { return a.raw == b.raw; }
+    friend constexpr bool operator!=(Q16 a, Q16 b) { return a.raw != b.raw; }
+    friend constexpr bool operator< (Q16 a, Q16 b) { return a.raw <  b.raw; }
+    friend constexpr bool operator<=(Q16 a, Q16 b) { return a.raw <= b.raw; }
+    friend constexpr bool operator> (Q16 a, Q16 b) { return a.raw >  b.raw; }
+    friend constexpr bool operator>=(Q16 a, Q16 b) { return a.raw >= b.raw; }
+
+    int32_t raw;
+
+private:
+    struct Raw {};
+    constexpr Q16(int32_t r, Raw) : raw(r) {}
+};
+
+/** @brief Narrow a Q16.16 value to Q1.15, rounding to nearest and saturating. */
+constexpr Q15 ToQ15(Q16 q)
+{
+    return Q15::FromRaw(FixedDetail::SaturateInt16(static_cast<int32_t>((static_cast<int64_t>(q.raw) + 1) >> 1)));
+}
+
+/**
+ * @brief Square root
+ *
+ * @param q Non negative value
+ * @return Q16 sqrt(q) rounded to nearest
+ */
+constexpr Q16 Sqrt(Q16 q)
+{
+    assert(q.raw >= 0 && "Q16: square root of a negative number");
+    // sqrt(raw * 2^16) = sqrt(x) * 2^16
+    return Q16::FromRaw(static_cast<int32_t>(FixedDetail::Sqrt(static_cast<uint64_t>(q.raw) << 16)));
+}
+
+//**********************************************************************
+//* Fixed point vectors
+//**********************************************************************
+// Vector2/3/4 work with Q16 and Q15 components as they are: addition,
+// scaling by a fixed point or integer factor, CrossProduct... all use the
+// saturating operators above. Float factors do not compile.
+// The member LengthSquared()/Length()/Normalize() return or go through float;
+// the free functions below are their integer only replacements. Dot products
+// are overloaded so v * u returns a fixed point value.
+
+typedef Vector2<Q16> Vec2q;
+typedef Vector3<Q16> Vec3q;
+typedef Vector4<Q16> Vec4q;
+
+typedef Vector2<Q15> Vec2q15;
+typedef Vector3<Q15> Vec3q15;
+typedef Vector4<Q15> Vec4q15;
+
+namespace FixedDetail
+{
+    // Exact sum of Q32 products, rounded once to Q16 and saturated. Each
+    // product is split into its high and low 32 bits, so neither running
+    // sum can overflow for any realistic number of terms.
+    struct ProductSum
+    {
+        int64_t hi = 0;
+        int64_t lo = 1 << 15;
+
+        constexpr void Add(int32_t a, int32_t b)
+        {
+            const int64_t p = static_cast<int64_t>(a) * b;
+            hi += p >> 32;
+            lo += p & 0xFFFFFFFF;
+        }
+
+        constexpr Q16 Round() const
+        {
+            return Q16::FromRaw(SaturateInt32(hi * 65536 + (lo >> 16)));
+        }
+    };
+
+    template <size_t N>
+    constexpr Q16 Dot(const Q16* a, const Q16* b)
+    {
+        ProductSum sum;
+        for (size_t i = 0; i < N; i++)
+            sum.Add(a[i].raw, b[i].raw);
+        return sum.Round();
+    }
+
+    // Sum of squares in Q32. Can not wrap for N <= 3, and saturates for N = 4.
+    template <size_t N>
+    constexpr uint64_t SumSquares(const Q16* a)
+    {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < N; i++)
+        {
+            const uint64_t sq = static_cast<uint64_t>(static_cast<int64_t>(a[i].raw) * a[i].raw);
+            sum = sum + sq < sum ? UINT64_MAX : sum + sq;
+        }
+        return sum;
+    }
+
+    // Q15 dot products round each product and add them with saturation in
+    // order, exactly like the pmulhrsw/paddsw kernels.
+    template <size_t N>
+    constexpr Q15 Dot(const Q15* a, const Q15* b)
+    {
+        Q15 sum = a[0] * b[0];
+        for (size_t i = 1; i < N; i++)
+            sum += a[i] * b[i];
+        return sum;
+    }
+} // namespace FixedDetail
+
+/** @brief Dot product. The Q16 versions sum the exact products, then round and saturate once. */
+inline Q16 operator*(const Vector2<Q16> &v, const Vector2<Q16> &u)
+{
+    const Q16 a[2] = { v.x, v.y }, b[2] = { u.x, u.y };
+    return FixedDetail::Dot<2>(a, b);
+}
+
+/** @brief Dot product. */
+inline Q16 operator*(const Vector3<Q16> &v, const Vector3<Q16> &u)
+{
+    const Q16 a[3] = { v.x, v.y, v.z }, b[3] = { u.x, u.y, u.z };
+    return FixedDetail::Dot<3>(a, b);
+}
+
+/** @brief Dot product. */
+inline Q16 operator*(const Vector4<Q16> &v, const Vector4<Q16> &u)
+{
+    const Q16 a[4] = { v.x, v.y, v.z, v.w }, b[4] = { u.x, u.y, u.z, u.w };
+    return FixedDetail::Dot<4>(a, b);
+}
+
+/** @brief Dot product. The Q15 versions round each product and saturate the sum. */
+inline Q15 operator*(const Vector2<Q15> &v, const Vector2<Q15> &u)
+{
+    const Q15 a[2] = { v.x, v.y }, b[2] = { u.x, u.y };
+    return FixedDetail::Dot<2>(a, b);
+}
+
+/** @brief Dot product. */
+inline Q15 operator*(const Vector3<Q15> &v, const Vector3<Q15> &u)
+{
+    const Q15 a[3] = { v.x, v.y, v.z }, b[3] = { u.x, u.y, u.z };
+    return FixedDetail::Dot<3>(a, b);
+}
+
+/** @brief Dot product. */
+inline Q15 operator*(const Vector4<Q15> &v, const Vector4<Q15> &u)
+{
+    const Q15 a[4] = { v.x, v.y, v.z, v.w }, b[4] = { u.x, u.y, u.z, u.w };
+    return FixedDetail::Dot<4>(a, b);
+}
+
+/** @brief Squared Euclidean length without going through float. */
+inline Q16 LengthSquared(const Vector2<Q16> &v) { return v * v; }
+inline Q16 LengthSquared(const Vector3<Q16> &v) { return v * v; }
+inline Q16 LengthSquared(const Vector4<Q16> &v) { return v * v; }
+
+namespace FixedDetail
+{
+    // sqrt of the Q32 sum of squares is the length in Q16
+    template <size_t N>
+    inline Q16 Length(const Q16* a)
+    {
+        const uint64_t len = Sqrt(SumSquares<N>(a));
+        return Q16::FromRaw(len > INT32_MAX ? INT32_MAX : static_cast<int32_t>(len));
+    }
+
+    // x / length, rounded to nearest
+    template <size_t N>
+    inline void Normalize(Q16* a)
+    {
+        const int64_t len = Length<N>(a).raw;
+        assert(len != 0 && "Q16: cannot normalize a zero vector");
+        for (size_t i = 0; i < N; i++)
+        {
+            const int64_t n = static_cast<int64_t>(a[i].raw) * 65536;
+            a[i] = Q16::FromRaw(SaturateInt32((n < 0 ? n - len / 2 : n + len / 2) / len));
+        }
+    }
+} // namespace FixedDetail
+
+/** @brief Euclidean length from the exact 64 bit sum of squares, rounded once. */
+inline Q16 Length(const Vector2<Q16> &v)
+{
+    const Q16 a[2] = { v.x, v.y };
+    return FixedDetail::Length<2>(a);
+}
+
+inline Q16 Length(const Vector3<Q16> &v)
+{
+    const Q16 a[3] = { v.x, v.y, v.z };
+    return FixedDetail::Length<3>(a);
+}
+
+inline Q16 Length(const Vector4<Q16> &v)
+{
+    const Q16 a[4] = { v.x, v.y, v.z, v.w };
+    return FixedDetail::Length<4>(a);
+}
+
+/** @brief Unit vector in the direction of v. Zero vectors are not allowed. */
+inline Vector2<Q16> Normalized(const Vector2<Q16> &v)
+{
+    Q16 a[2] = { v.x, v.y };
+    FixedDetail::Normalize<2>(a);
+    return Vector2<Q16>(a[0], a[1]);
+}
+
+inline Vector3<Q16> Normalized(const Vector3<Q16> &v)
+{
+    Q16 a[3] = { v.x, v.y, v.z };
+    FixedDetail::Normalize<3>(a);
+    return Vector3<Q16>(a[0], a[1], a[2]);
+}
+
+inline Vector4<Q16> Normalized(const Vector4<Q16> &v)
+{
+    Q16 a[4] = { v.x, v.y, v.z, v.w };
+    FixedDetail::Normalize<4>(a);
+    return Vector4<Q16>(a[0], a[1], a[2], a[3]);
+}
+
+//**********************************************************************
+//* Q1.15 array kernels
+//**********************************************************************
+// SSE4.1/AVX2 (pmulhrsw, paddsw) with bit-identical scalar fallbacks.
+// Input and output arrays may be the same array, but must not partially overlap.
+
+/**
+ * @brief Element wise product. out[i] = a[i] * b[i]
+ *
+ * @param a   First factors
+ * @param b   Second factors
+ * @param out Output products
+ * @param n   Number of elements
+ */
+void MultiplyBatch(const Q15* a, const Q15* b, Q15* out, size_t n);
+
+/**
+ * @brief Scale every element. out[i] = in[i] * s
+ *
+ * @param in  Input values
+ * @param s   Scale factor
+ * @param out Output values
+ * @param n   Number of elements
+ */
+void ScaleBatch(const Q15* in, Q15 s, Q15* out, size_t n);
+
+/**
+ * @brief Dot products of two arrays of vectors. out[i] = a[i] * b[i]
+ *
+ * @param a   First vectors
+ * @param b   Second vectors
+ * @param out Output dot products
+ * @param n   Number of vectors
+ */
+void DotBatch(const Vec4q15* a, const Vec4q15* b, Q15* out, size_t n);
+
+#endif // FIXED_H
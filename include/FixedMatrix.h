@@ -0,0 +1,372 @@
+/**
+ * @file: FixedMatrix.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FIXED_MATRIX_H
+#define FIXED_MATRIX_H
+
+#include <stddef.h>
+#include "Fixed.h"
+#include "Mat3.h"
+#include "Mat4.h"
+#include "Simd.h"
+
+//**********************************************************************
+//* Q16.16 matrices
+//**********************************************************************
+// Same layout and conventions as Mat3/Mat4: row vectors (v * M), A * B
+// applies A first and the translation is in the last row. Every element of
+// a product is the exact sum of its Q32 terms, rounded once and saturated,
+// so results do not depend on the order of the terms or on the kernel that
+// computed them.
+//
+// There are no fixed point rotation builders: build the float matrix in a
+// constant expression and convert it, e.g.
+//     constexpr Mat4q r(Mat4::RotationZ(0.5f));
+
+namespace FixedDetail
+{
+    /** @brief out = v * m for an N x N matrix. */
+    template <size_t N>
+    constexpr void RowTimesMatrix(const Q16* v, const Q16 (*m)[N], Q16* out)
+    {
+        for (size_t j = 0; j < N; j++)
+        {
+            ProductSum sum;
+            for (size_t k = 0; k < N; k++)
+                sum.Add(v[k].raw, m[k][j].raw);
+            out[j] = sum.Round();
+        }
+    }
+} // namespace FixedDetail
+
+class Mat3q
+{
+public:
+    Mat3q() = default;
+
+    constexpr Mat3q(Q16 a11, Q16 a12, Q16 a13
+                  , Q16 a21, Q16 a22, Q16 a23
+                  , Q16 a31, Q16 a32, Q16 a33) :
+        data { a11, a12, a13,
+               a21, a22, a23,
+               a31, a32, a33 }
+    {}
+
+    /** @brief Convert a float matrix, rounding to nearest and saturating. */
+    constexpr explicit Mat3q(const Mat3& m) :
+        data {}
+    {
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                data[i][j] = Q16(m.data[i][j]);
+    }
+
+    /** @brief Float matrix with the same values. */
+    constexpr Mat3 ToMat3() const
+    {
+        Mat3 m(0, 0, 0, 0, 0, 0, 0, 0, 0);
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                m.data[i][j] = data[i][j].ToFloat();
+        return m;
+    }
+
+    /**
+     * @brief Matrix multiplication
+     *
+     * @param m Matrix to multiply
+     * @return Mat3q Result of the multiplication
+     */
+    constexpr Mat3q operator*(const Mat3q& m) const
+    {
+        Mat3q r(0, 0, 0, 0, 0, 0, 0, 0, 0);
+        for (int i = 0; i < 3; i++)
+            FixedDetail::RowTimesMatrix<3>(data[i], m.data, r.data[i]);
+        return r;
+    }
+
+    constexpr Mat3q& operator*=(const Mat3q& m)
+    {
+        return *this = *this * m;
+    }
+
+    /** @brief Scalar multiplication */
+    constexpr Mat3q operator*(Q16 s) const
+    {
+        Mat3q r(*this);
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                r.data[i][j] *= s;
+        return r;
+    }
+
+    /** @brief Matrix addition */
+    constexpr Mat3q operator+(const Mat3q& m) const
+    {
+        Mat3q r(*this);
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                r.data[i][j] += m.data[i][j];
+        return r;
+    }
+
+    /** @brief Matrix subtraction */
+    constexpr Mat3q operator-(const Mat3q& m) const
+    {
+        Mat3q r(*this);
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                r.data[i][j] -= m.data[i][j];
+        return r;
+    }
+
+    /**
+     * @brief Transpose matrix
+     *
+     * @return Mat3q
+     */
+    constexpr Mat3q operator!() const
+    {
+        return {
+            data[0][0], data[1][0], data[2][0],
+            data[0][1], data[1][1], data[2][1],
+            data[0][2], data[1][2], data[2][2],
+        };
+    }
+
+    constexpr static Mat3q Identity()
+    {
+        return {
+            1, 0, 0,
+            0, 1, 0,
+            0, 0, 1,
+        };
+    }
+
+    constexpr static Mat3q Scaling(Q16 x, Q16 y, Q16 z)
+    {
+        return {
+            x, 0, 0,
+            0, y, 0,
+            0, 0, z,
+        };
+    }
+
+    // [ row ][ col ]
+    Q16 data[3][3];
+};
+
+class alignas(16) Mat4q
+{
+public:
+    Mat4q() = default;
+
+    constexpr Mat4q(Q16 a11, Q16 a12, Q16 a13, Q16 a14
+                  , Q16 a21, Q16 a22, Q16 a23, Q16 a24
+                  , Q16 a31, Q16 a32, Q16 a33, Q16 a34
+                  , Q16 a41, Q16 a42, Q16 a43, Q16 a44) :
+        data { a11, a12, a13, a14,
+               a21, a22, a23, a24,
+               a31, a32, a33, a34,
+               a41, a42, a43, a44 }
+    {}
+
+    /** @brief Convert a float matrix, rounding to nearest and saturating. */
+    constexpr explicit Mat4q(const Mat4& m) :
+        data {}
+    {
+        for (int i = 0; i < 4; i++)
+            for (int j = 0; j < 4; j++)
+                data[i][j] = Q16(m.data[i][j]);
+    }
+
+    /** @brief Embed a 3x3 matrix, like Mat4(const Mat3&). */
+    constexpr Mat4q(const Mat3q& m) :
+        data { m.data[0][0], m.data[0][1], m.data[0][2], 0,
+               m.data[1][0], m.data[1][1], m.data[1][2], 0,
+               m.data[2][0], m.data[2][1], m.data[2][2], 0,
+                          0,            0,            0, 1 }
+    {}
+
+    /** @brief Float matrix with the same values. */
+    constexpr Mat4 ToMat4() const
+    {
+        return {
+            data[0][0].ToFloat(), data[0][1].ToFloat(), data[0][2].ToFloat(), data[0][3].ToFloat(),
+            data[1][0].ToFloat(), data[1][1].ToFloat(), data[1][2].ToFloat(), data[1][3].ToFloat(),
+            data[2][0].ToFloat(), data[2][1].ToFloat(), data[2][2].ToFloat(), data[2][3].ToFloat(),
+            data[3][0].ToFloat(), data[3][1].ToFloat(), data[3][2].ToFloat(), data[3][3].ToFloat(),
+        };
+    }
+
+    /**
+     * @brief Matrix multiplication. Uses the TransformBatch() kernels at runtime.
+     *
+     * @param m Matrix to multiply
+     * @return Mat4q Result of the multiplication
+     */
+    constexpr Mat4q operator*(const Mat4q& m) const
+    {
+    #ifdef VECTOR_X86_SIMD
+        if (!IsConstantEvaluated() && SimdActiveLevel() != SimdLevel::Scalar)
+            return multiplyKernel(m);
+    #endif
+        Mat4q r(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        for (int i = 0; i < 4; i++)
+            FixedDetail::RowTimesMatrix<4>(data[i], m.data, r.data[i]);
+        return r;
+    }
+
+    constexpr Mat4q& operator*=(const Mat4q& m)
+    {
+        return *this = *this * m;
+    }
+
+    /** @brief Scalar multiplication */
+    constexpr Mat4q operator*(Q16 s) const
+    {
+        Mat4q r(*this);
+        for (int i = 0; i < 4; i++)
+            for (int j = 0; j < 4; j++)
+                r.data[i][j] *= s;
+        return r;
+    }
+
+    /** @brief Matrix addition */
+    constexpr Mat4q operator+(const Mat4q& m) const
+    {
+        Mat4q r(*this);
+        for (int i = 0; i < 4; i++)
+            for (int j = 0; j < 4; j++)
+                r.data[i][j] += m.data[i][j];
+        return r;
+    }
+
+    /** @brief Matrix subtraction */
+    constexpr Mat4q operator-(const Mat4q& m) const
+    {
+        Mat4q r(*this);
+        for (int i = 0; i < 4; i++)
+            for (int j = 0; j < 4; j++)
+                r.data[i][j] -= m.data[i][j];
+        return r;
+    }
+
+    /**
+     * @brief Transpose matrix
+     *
+     * @return Mat4q
+     */
+    constexpr Mat4q operator!() const
+    {
+        return {
+            data[0][0], data[1][0], data[2][0], data[3][0],
+            data[0][1], data[1][1], data[2][1], data[3][1],
+            data[0][2], data[1][2], data[2][2], data[3][2],
+            data[0][3], data[1][3], data[2][3], data[3][3],
+        };
+    }
+
+    constexpr static Mat4q Identity()
+    {
+        return {
+            1, 0, 0, 0,
+            0, 1, 0, 0,
+            0, 0, 1, 0,
+            0, 0, 0, 1,
+        };
+    }
+
+    constexpr static Mat4q Scaling(Q16 x, Q16 y, Q16 z)
+    {
+        return {
+            x, 0, 0, 0,
+            0, y, 0, 0,
+            0, 0, z, 0,
+            0, 0, 0, 1,
+        };
+    }
+
+    constexpr static Mat4q Translation(Q16 x, Q16 y, Q16 z)
+    {
+        return {
+            1, 0, 0, 0,
+            0, 1, 0, 0,
+            0, 0, 1, 0,
+            x, y, z, 1,
+        };
+    }
+
+private:
+#ifdef VECTOR_X86_SIMD
+    Mat4q multiplyKernel(const Mat4q& m) const;
+#endif
+
+public:
+    // [ row ][ col ]
+    Q16 data[4][4];
+};
+
+/** @brief Row vector times matrix, one rounding per component. */
+constexpr Vector3<Q16> operator*(const Vector3<Q16>& v, const Mat3q& m)
+{
+    const Q16 a[3] = { v.x, v.y, v.z };
+    Q16 u[3] = { 0, 0, 0 };
+    FixedDetail::RowTimesMatrix<3>(a, m.data, u);
+    return { u[0], u[1], u[2] };
+}
+
+constexpr Vector3<Q16>& operator*=(Vector3<Q16>& v, const Mat3q& m)
+{
+    return v = v * m;
+}
+
+/** @brief Row vector times matrix, one rounding per component. Same result as TransformBatch(). */
+constexpr Vector4<Q16> operator*(const Vector4<Q16>& v, const Mat4q& m)
+{
+    const Q16 a[4] = { v.x, v.y, v.z, v.w };
+    Q16 u[4] = { 0, 0, 0, 0 };
+    FixedDetail::RowTimesMatrix<4>(a, m.data, u);
+    return { u[0], u[1], u[2], u[3] };
+}
+
+constexpr Vector4<Q16>& operator*=(Vector4<Q16>& v, const Mat4q& m)
+{
+    return v = v * m;
+}
+
+/**
+ * @brief Transform an array of vectors: out[i] = in[i] * m.
+ *        SSE4.1/AVX2 kernels (pmuldq) with results bit-identical to the
+ *        scalar operator. in and out may be the same array, but must not
+ *        partially overlap.
+ *
+ * @param m   Transform matrix
+ * @param in  Input vectors
+ * @param out Output vectors
+ * @param n   Number of vectors
+ */
+void TransformBatch(const Mat4q& m, const Vec4q* in, Vec4q* out, size_t n);
+
+#endif // FIXED_MATRIX_H
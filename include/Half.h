@@ -0,0 +1,198 @@
+/**
+ * @file: Half.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALF_H
+#define HALF_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "Vector.h"
+#include "Simd.h"
+
+//**********************************************************************
+//* IEEE 754 half precision storage
+//**********************************************************************
+// Half is a storage format: vertex data is kept in 16 bits and widened to
+// float for the math. The BatchTransform.h kernels convert on load and store,
+// so large meshes take half the memory and bandwidth of Vec3f/Vec4f.
+//
+// The conversions round to nearest even and handle subnormals, infinities
+// and NaN. They give the same bits as the F16C instructions, which the
+// x86 kernels use.
+
+/**
+ * @brief Convert a float to half precision bits
+ *
+ * @param f Value to convert. Values past 65504 round to infinity
+ * @return uint16_t Half precision bit pattern
+ */
+inline uint16_t FloatToHalfBits(float f)
+{
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    const uint16_t sign = (u >> 16) & 0x8000;
+    const uint32_t a = u & 0x7FFFFFFF;
+
+    // Infinity, or NaN with the quiet bit set and the top of the payload
+    if (a >= 0x7F800000)
+        return sign | 0x7C00 | (a > 0x7F800000 ? 0x200 | ((a >> 13) & 0x3FF) : 0);
+
+    // From halfway past 65504 up
+    if (a >= 0x477FF000)
+        return sign | 0x7C00;
+
+    // Subnormal half (or zero): keep the top bits of the significand
+    if (a < 0x38800000)
+    {
+        const uint32_t e = a >> 23;
+        if (e < 101)
+            return sign;
+        const uint32_t m = (a & 0x7FFFFF) | 0x800000;
+        const uint32_t shift = 126 - e;
+        const uint32_t half = 1u << (shift - 1);
+        const uint32_t rem = m & ((half << 1) - 1);
+        uint32_t h = m >> shift;
+        if (rem > half || (rem == half && (h & 1)))
+            h++;
+        return sign | h;
+    }
+
+    // Normal: rebias the exponent, drop 13 significand bits rounding to even.
+    // A carry out of the significand correctly bumps the exponent.
+    uint32_t h = (a - 0x38000000) >> 13;
+    const uint32_t rem = a & 0x1FFF;
+    if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+        h++;
+    return sign | h;
+}
+
+/**
+ * @brief Convert half precision bits to float. Exact.
+ *
+ * @param h Half precision bit pattern
+ * @return float Same value
+ */
+inline float HalfBitsToFloat(uint16_t h)
+{
+    const uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+    const uint32_t e = (h >> 10) & 0x1F;
+    uint32_t m = h & 0x3FF;
+    uint32_t u;
+
+    if (e == 0x1F)
+    {
+        // Infinity or NaN. NaNs come back quiet.
+        u = sign | 0x7F800000 | (m << 13) | (m ? 0x400000 : 0);
+    }
+    else if (e != 0)
+    {
+        u = sign | ((e + 112) << 23) | (m << 13);
+    }
+    else if (m == 0)
+    {
+        u = sign;
+    }
+    else
+    {
+        // Subnormal half: normalize the significand
+        uint32_t exponent = 113;
+        while (!(m & 0x400))
+        {
+            m <<= 1;
+            exponent--;
+        }
+        u = sign | (exponent << 23) | ((m & 0x3FF) << 13);
+    }
+
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+/**
+ * @brief 16 bit floating point value for storage.
+ *        Convert to float for arithmetic.
+ */
+class Half
+{
+public:
+    /** @brief Default constructor. The value is left uninitialized. */
+    Half() = default;
+
+    /** @brief Convert from float, rounding to nearest even. */
+    explicit Half(float f) : bits(FloatToHalfBits(f)) {}
+
+    /** @brief Build from the raw bit pattern. */
+    static constexpr Half FromBits(uint16_t b) { return Half(b, Bits()); }
+
+    /** @brief Value as float. Exact. */
+    float ToFloat() const { return HalfBitsToFloat(bits); }
+
+    explicit operator float() const { return ToFloat(); }
+
+    uint16_t bits;
+
+private:
+    struct Bits {};
+    constexpr Half(uint16_t b, Bits) : bits(b) {}
+};
+
+// Half vectors are storage only: there is no arithmetic in half precision
+// and, since Half only converts explicitly, no Vec3f <-> Vec3f16 converting
+// constructor either. Convert with FloatToHalf() and HalfToFloat().
+typedef Vector2<Half> Vec2f16;
+typedef Vector3<Half> Vec3f16;
+typedef Vector4<Half> Vec4f16;
+
+/** @brief Narrow a vector to half precision, rounding to nearest even. */
+inline Vec2f16 FloatToHalf(const Vector2<float>& v) { return { Half(v.x), Half(v.y) }; }
+inline Vec3f16 FloatToHalf(const Vector3<float>& v) { return { Half(v.x), Half(v.y), Half(v.z) }; }
+inline Vec4f16 FloatToHalf(const Vector4<float>& v) { return { Half(v.x), Half(v.y), Half(v.z), Half(v.w) }; }
+
+/** @brief Widen a half precision vector to float. Exact. */
+inline Vector2<float> HalfToFloat(const Vec2f16& h) { return { h.x.ToFloat(), h.y.ToFloat() }; }
+inline Vector3<float> HalfToFloat(const Vec3f16& h) { return { h.x.ToFloat(), h.y.ToFloat(), h.z.ToFloat() }; }
+inline Vector4<float> HalfToFloat(const Vec4f16& h) { return { h.x.ToFloat(), h.y.ToFloat(), h.z.ToFloat(), h.w.ToFloat() }; }
+
+/**
+ * @brief Widen an array of halves to float. F16C on x86.
+ *
+ * @param in  Input values
+ * @param out Output values
+ * @param n   Number of values
+ */
+void HalfToFloatBatch(const Half* in, float* out, size_t n);
+
+/**
+ * @brief Narrow an array of floats to half precision, rounding to nearest
+ *        even. F16C on x86.
+ *
+ * @param in  Input values
+ * @param out Output values
+ * @param n   Number of values
+ */
+void FloatToHalfBatch(const float* in, Half* out, size_t n);
+
+#endif // HALF_H
@@ -3,7 +3,7 @@
  * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
  * Created Date: 2021-11-14
  * -----
- * Last Modified: 22-10-2025
+ * Last Modified: 17-10-2026
  * Modified By: Ricard Bitriá Ribes
  * -----
  * @copyright (c) 2021 Ricard Bitriá Ribes
@@ -26,6 +26,7 @@
 #define MATRIX3_H
 
 #include "Vector3.h"
+#include "ConstexprMath.h"
 
 class Mat3
 {
@@ -47,7 +48,7 @@ public:
      * @param  scalar Scalar to multiply
      * @return Mat3& Reference to this matrix
      */
-    __attribute__((always_inline)) inline Mat3& operator*=(float scalar)
+    __attribute__((always_inline)) constexpr Mat3& operator*=(float scalar)
     {
         data[0][0] *= scalar;
         data[0][1] *= scalar;
@@ -67,7 +68,7 @@ public:
      * @param scalar Scalar to multiply
      * @return Mat3 Result of the multiplication
      */
-    __attribute__((always_inline)) inline Mat3 operator*(float scalar) const
+    __attribute__((always_inline)) constexpr Mat3 operator*(float scalar) const
     {
         return {
             data[0][0] * scalar, data[0][1] * scalar, data[0][2] * scalar,
@@ -82,7 +83,10 @@ public:
      * @param m Matrix to multiply
      * @return Mat3 Result of the multiplication
      */
-    Mat3& operator*=(const Mat3& m);
+    constexpr Mat3& operator*=(const Mat3& m)
+    {
+        return *this = *this * m;
+    }
 
     /**
      * @brief Matrix multiplication
@@ -90,7 +94,20 @@ public:
      * @param m Matrix to multiply
      * @return Mat3 Result of the multiplication
      */
-    Mat3 operator*(const Mat3& m) const;
+    constexpr Mat3 operator*(const Mat3& m) const
+    {
+        return {
+            data[0][0] * m.data[0][0] + data[0][1] * m.data[1][0] + data[0][2] * m.data[2][0],
+            data[0][0] * m.data[0][1] + data[0][1] * m.data[1][1] + data[0][2] * m.data[2][1],
+            data[0][0] * m.data[0][2] + data[0][1] * m.data[1][2] + data[0][2] * m.data[2][2],
+            data[1][0] * m.data[0][0] + data[1][1] * m.data[1][0] + data[1][2] * m.data[2][0],
+            data[1][0] * m.data[0][1] + data[1][1] * m.data[1][1] + data[1][2] * m.data[2][1],
+            data[1][0] * m.data[0][2] + data[1][1] * m.data[1][2] + data[1][2] * m.data[2][2],
+            data[2][0] * m.data[0][0] + data[2][1] * m.data[1][0] + data[2][2] * m.data[2][0],
+            data[2][0] * m.data[0][1] + data[2][1] * m.data[1][1] + data[2][2] * m.data[2][1],
+            data[2][0] * m.data[0][2] + data[2][1] * m.data[1][2] + data[2][2] * m.data[2][2],
+        };
+    }
 
     /**
      * @brief Matrix addition
@@ -98,7 +115,7 @@ public:
      * @param m Matrix to add
      * @return Mat3 Result of the addition
      */
-    __attribute__((always_inline)) inline Mat3 operator+(const Mat3& m) const
+    __attribute__((always_inline)) constexpr Mat3 operator+(const Mat3& m) const
     {
         return {
             data[0][0] + m.data[0][0], data[0][1] + m.data[0][1], data[0][2] + m.data[0][2],
@@ -113,7 +130,7 @@ public:
      * @param m Matrix to add
      * @return Mat3& Reference to this matrix
      */
-    __attribute__((always_inline)) inline Mat3& operator+=(const Mat3& m)
+    __attribute__((always_inline)) constexpr Mat3& operator+=(const Mat3& m)
     {
         data[0][0] += m.data[0][0];
         data[0][1] += m.data[0][1];
@@ -133,7 +150,7 @@ public:
      * @param m Matrix to subtract
      * @return Mat3 Result of the subtraction
      */
-    __attribute__((always_inline)) inline Mat3 operator-(const Mat3& m) const
+    __attribute__((always_inline)) constexpr Mat3 operator-(const Mat3& m) const
     {
         return {
             data[0][0] - m.data[0][0], data[0][1] - m.data[0][1], data[0][2] - m.data[0][2],
@@ -148,7 +165,7 @@ public:
      * @param m Matrix to subtract
      * @return Mat3& Reference to this matrix
      */
-    __attribute__((always_inline)) inline Mat3& operator-=(const Mat3& m)
+    __attribute__((always_inline)) constexpr Mat3& operator-=(const Mat3& m)
     {
         data[0][0] -= m.data[0][0];
         data[0][1] -= m.data[0][1];
@@ -167,7 +184,7 @@ public:
      * 
      * @return Mat3 
      */
-    __attribute__((always_inline)) inline Mat3 operator!() const
+    __attribute__((always_inline)) constexpr Mat3 operator!() const
     {
         return {
             data[0][0], data[1][0], data[2][0],
@@ -176,7 +193,7 @@ public:
         };
     }
 
-    __attribute__((always_inline)) inline float& operator()(const int row, const int col)
+    __attribute__((always_inline)) constexpr float& operator()(const int row, const int col)
     {
         assert(row >= 0 && row < 3 && col >= 0 && col < 3 && "Mat3: row and col indices must be in [0,2]");
         return data[row][col];
@@ -234,7 +251,17 @@ public:
      * @param theta Rotation angle in radians
      * @return Mat3
      */
-    static Mat3 RotationZ(float theta);
+    constexpr static Mat3 RotationZ(float theta)
+    {
+        const float sinTheta = ConstexprSin(theta);
+        const float cosTheta = ConstexprCos(theta);
+
+        return {
+            cosTheta,  sinTheta, 0.0f,
+            -sinTheta, cosTheta, 0.0f,
+            0.0f,      0.0f,     1.0f,
+        };
+    }
 
     /**
      * @brief Rotation matrix around Y axis
@@ -242,7 +269,17 @@ public:
      * @param theta Rotation angle in radians
      * @return Mat3
      */
-    static Mat3 RotationY(float theta);
+    constexpr static Mat3 RotationY(float theta)
+    {
+        const float sinTheta = ConstexprSin(theta);
+        const float cosTheta = ConstexprCos(theta);
+
+        return {
+            cosTheta, 0.0f, -sinTheta,
+            0.0f,     1.0f, 0.0f,
+            sinTheta, 0.0f, cosTheta
+        };
+    }
 
     /**
      * @brief Rotation matrix around X axis
@@ -250,21 +287,70 @@ public:
      * @param theta Rotation angle in radians
      * @return Mat3
      */
-    static Mat3 RotationX(float theta);
+    constexpr static Mat3 RotationX(float theta)
+    {
+        const float sinTheta = ConstexprSin(theta);
+        const float cosTheta = ConstexprCos(theta);
+
+        return {
+            1.0f,  0.0f,     0.0f,
+            0.0f,  cosTheta, sinTheta,
+            0.0f, -sinTheta, cosTheta,
+        };
+    }
 
     /**
-     * @brief Inverse matrix
+     * @brief Inverse matrix, computed in closed form from the adjugate
      * 
+     * @param det Optional output for the determinant. May be nullptr
      * @return Mat3 Inverted matrix. If the matrix is not invertible, returns zero matrix.
      */
-    Mat3 Inverse() const;
+    constexpr Mat3 Inverse(float* det = nullptr) const
+    {
+        const float (&m)[3][3] = data;
+
+        // First column of the adjugate, reused for the determinant
+        const float a00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+        const float a10 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+        const float a20 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+
+        const float d = m[0][0] * a00 + m[0][1] * a10 + m[0][2] * a20;
+        if (det)
+            *det = d;
+        if (d == 0.0f)
+            return Mat3(); // Singular matrix, return zero matrix
+
+        const float inv = 1.0f / d;
+        return {
+            a00 * inv, (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv, (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv,
+            a10 * inv, (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv, (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv,
+            a20 * inv, (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv, (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv,
+        };
+    }
+
+    /**
+     * @brief Inverse of a rotation matrix, which is its transpose.
+     *        The matrix must be orthonormal, which is not checked.
+     * 
+     * @return Mat3 Inverted matrix
+     */
+    constexpr Mat3 InverseRigid() const
+    {
+        // The inverse of a rotation is its transpose
+        return !*this;
+    }
 
     /**
      * @brief Determinant of the matrix
      * 
      * @return float Determinant value
      */
-    float Determinant() const;
+    constexpr float Determinant() const
+    {
+        return data[0][0] * (data[1][1] * data[2][2] - data[1][2] * data[2][1]) -
+               data[0][1] * (data[1][0] * data[2][2] - data[1][2] * data[2][0]) +
+               data[0][2] * (data[1][0] * data[2][1] - data[1][1] * data[2][0]);
+    }
 
 public:
 	// [ row ][ col ]
@@ -272,13 +358,13 @@ public:
 };
 
 template<typename T>
-__attribute__((hot, optimize("O3"), always_inline)) inline Vector3<T>& operator*=(Vector3<T>& v, const Mat3& m)
+__attribute__((hot, optimize("O3"), always_inline)) constexpr Vector3<T>& operator*=(Vector3<T>& v, const Mat3& m)
 {
 	return v = v * m;
 }
 
 template<typename T>
-__attribute__((hot, optimize("O3"), always_inline)) inline Vector3<T> operator*(const Vector3<T>& v, const Mat3& m)
+__attribute__((hot, optimize("O3"), always_inline)) constexpr Vector3<T> operator*(const Vector3<T>& v, const Mat3& m)
 {
 	return {
 		v.x * m.data[0][0] + v.y * m.data[1][0] + v.z * m.data[2][0],
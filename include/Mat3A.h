@@ -0,0 +1,484 @@
+/**
+ * @file: Mat3A.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATRIX3A_H
+#define MATRIX3A_H
+
+#include "Vec3A.h"
+#include "Mat3.h"
+#include "Simd.h"
+#include "ConstexprMath.h"
+
+#if defined(VECTOR_X86_SIMD)
+// Inline kernels with baseline SSE only, no dispatch. Each row is one aligned
+// register, the fourth lane is padding. The products are summed in the same
+// order as the Mat3 code, so the results are identical under the same
+// condition as Vec3A: no FP contraction in the including code.
+
+/**
+ * @brief a[0]*B0 + a[1]*B1 + a[2]*B2, where Bk are the rows of B
+ */
+__attribute__((always_inline)) inline __m128 rowTimes3x3_sse(const float* a, const float* B)
+{
+    // Broadcasts straight from memory (a load only when built with AVX)
+    const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[0]), _mm_load_ps(B)),
+                                 _mm_mul_ps(_mm_set1_ps(a[1]), _mm_load_ps(B + 4)));
+    return _mm_add_ps(xy, _mm_mul_ps(_mm_set1_ps(a[2]), _mm_load_ps(B + 8)));
+}
+#endif
+
+/**
+ * @brief 3x3 matrix with each row padded to 16 bytes (48 bytes in total).
+ *
+ * Same values, conventions and operations as Mat3 (row vectors, v * M),
+ * but every row is a single aligned SIMD load. Convert with Mat3A(const Mat3&)
+ * and ToMat3().
+ */
+class alignas(16) Mat3A
+{
+public:
+    Mat3A() = default;
+    constexpr Mat3A(const Mat3A&) = default;
+
+    constexpr Mat3A(const float a11, const float a12, const float a13
+                  , const float a21, const float a22, const float a23
+                  , const float a31, const float a32, const float a33) :
+        data { a11, a12, a13, 0.0f,
+               a21, a22, a23, 0.0f,
+               a31, a32, a33, 0.0f }
+    {}
+
+    /** @brief Build from three row vectors. */
+    constexpr Mat3A(const Vec3A& r0, const Vec3A& r1, const Vec3A& r2) :
+        Mat3A(r0.x, r0.y, r0.z,
+              r1.x, r1.y, r1.z,
+              r2.x, r2.y, r2.z)
+    {}
+
+    /** @brief Convert from a packed matrix. */
+    constexpr explicit Mat3A(const Mat3& m) :
+        Mat3A(m.data[0][0], m.data[0][1], m.data[0][2],
+              m.data[1][0], m.data[1][1], m.data[1][2],
+              m.data[2][0], m.data[2][1], m.data[2][2])
+    {}
+
+    /**
+     * @brief Packed matrix with the same values
+     *
+     * @return Mat3
+     */
+    constexpr Mat3 ToMat3() const
+    {
+        return {
+            data[0][0], data[0][1], data[0][2],
+            data[1][0], data[1][1], data[1][2],
+            data[2][0], data[2][1], data[2][2],
+        };
+    }
+
+    /**
+     * @brief Row of the matrix
+     *
+     * @param i Row index in [0, 2]
+     * @return Vec3A
+     */
+    constexpr Vec3A Row(const int i) const
+    {
+        assert(i >= 0 && i < 3 && "Mat3A: row index must be in [0,2]");
+        return { data[i][0], data[i][1], data[i][2] };
+    }
+
+    /**
+     * @brief  Scalar multiplication assignment
+     *
+     * @param  scalar Scalar to multiply
+     * @return Mat3A& Reference to this matrix
+     */
+    constexpr Mat3A& operator*=(float scalar)
+    {
+        return *this = *this * scalar;
+    }
+
+    /**
+     * @brief Scalar multiplication
+     *
+     * @param scalar Scalar to multiply
+     * @return Mat3A Result of the multiplication
+     */
+    constexpr Mat3A operator*(float scalar) const
+    {
+    #ifdef VECTOR_X86_SIMD
+        if (!IsConstantEvaluated())
+            return scaleKernel(scalar);
+    #endif
+        return {
+            data[0][0] * scalar, data[0][1] * scalar, data[0][2] * scalar,
+            data[1][0] * scalar, data[1][1] * scalar, data[1][2] * scalar,
+            data[2][0] * scalar, data[2][1] * scalar, data[2][2] * scalar,
+        };
+    }
+
+    /**
+     * @brief Matrix multiplication
+     *
+     * @param m Matrix to multiply
+     * @return Mat3A& Reference to this matrix
+     */
+    constexpr Mat3A& operator*=(const Mat3A& m)
+    {
+        return *this = *this * m;
+    }
+
+    /**
+     * @brief Matrix multiplication
+     *
+     * @param m Matrix to multiply
+     * @return Mat3A Result of the multiplication
+     */
+    constexpr Mat3A operator*(const Mat3A& m) const
+    {
+    #ifdef VECTOR_X86_SIMD
+        if (!IsConstantEvaluated())
+            return multiplyKernel(m);
+    #endif
+        Mat3A r(0, 0, 0, 0, 0, 0, 0, 0, 0);
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                r.data[i][j] = data[i][0] * m.data[0][j] + data[i][1] * m.data[1][j] + data[i][2] * m.data[2][j];
+        return r;
+    }
+
+    /**
+     * @brief Matrix addition
+     *
+     * @param m Matrix to add
+     * @return Mat3A Result of the addition
+     */
+    constexpr Mat3A operator+(const Mat3A& m) const
+    {
+    #ifdef VECTOR_X86_SIMD
+        if (!IsConstantEvaluated())
+            return addKernel(m);
+    #endif
+        return {
+            data[0][0] + m.data[0][0], data[0][1] + m.data[0][1], data[0][2] + m.data[0][2],
+            data[1][0] + m.data[1][0], data[1][1] + m.data[1][1], data[1][2] + m.data[1][2],
+            data[2][0] + m.data[2][0], data[2][1] + m.data[2][1], data[2][2] + m.data[2][2],
+        };
+    }
+
+    /**
+     * @brief  Matrix addition assignment
+     *
+     * @param m Matrix to add
+     * @return Mat3A& Reference to this matrix
+     */
+    constexpr Mat3A& operator+=(const Mat3A& m)
+    {
+        return *this = *this + m;
+    }
+
+    /**
+     * @brief Matrix subtraction
+     *
+     * @param m Matrix to subtract
+     * @return Mat3A Result of the subtraction
+     */
+    constexpr Mat3A operator-(const Mat3A& m) const
+    {
+    #ifdef VECTOR_X86_SIMD
+        if (!IsConstantEvaluated())
+            return subtractKernel(m);
+    #endif
+        return {
+            data[0][0] - m.data[0][0], data[0][1] - m.data[0][1], data[0][2] - m.data[0][2],
+            data[1][0] - m.data[1][0], data[1][1] - m.data[1][1], data[1][2] - m.data[1][2],
+            data[2][0] - m.data[2][0], data[2][1] - m.data[2][1], data[2][2] - m.data[2][2],
+        };
+    }
+
+    /**
+     * @brief  Matrix subtraction assignment
+     *
+     * @param m Matrix to subtract
+     * @return Mat3A& Reference to this matrix
+     */
+    constexpr Mat3A& operator-=(const Mat3A& m)
+    {
+        return *this = *this - m;
+    }
+
+    /**
+     * @brief Transpose matrix
+     *
+     * @return Mat3A
+     */
+    constexpr Mat3A operator!() const
+    {
+    #ifdef VECTOR_X86_SIMD
+        if (!IsConstantEvaluated())
+            return transposeKernel();
+    #endif
+        return {
+            data[0][0], data[1][0], data[2][0],
+            data[0][1], data[1][1], data[2][1],
+            data[0][2], data[1][2], data[2][2],
+        };
+    }
+
+    __attribute__((always_inline)) constexpr float& operator()(const int row, const int col)
+    {
+        assert(row >= 0 && row < 3 && col >= 0 && col < 3 && "Mat3A: row and col indices must be in [0,2]");
+        return data[row][col];
+    }
+
+    /**
+     * @brief  Identity matrix
+     *
+     * @return constexpr Mat3A   Return identity matrix
+     */
+    constexpr static Mat3A Identity()
+    {
+        return Mat3A(Mat3::Identity());
+    }
+
+    /**
+     * @brief Scaling matrix
+     *
+     * @param factor Scale factor
+     * @return constexpr Mat3A
+     */
+    constexpr static Mat3A Scaling(float factor)
+    {
+        return Mat3A(Mat3::Scaling(factor));
+    }
+
+    /**
+     * @brief Scaling matrix
+     *
+     * @param x Scale factor in X axis
+     * @param y Scale factor in Y axis
+     * @param z Scale factor in Z axis
+     * @return constexpr Mat3A
+     */
+    constexpr static Mat3A Scaling(float x, float y, float z)
+    {
+        return Mat3A(Mat3::Scaling(x, y, z));
+    }
+
+    /**
+     * @brief Rotation matrix around Z axis
+     *
+     * @param theta Rotation angle in radians
+     * @return Mat3A
+     */
+    constexpr static Mat3A RotationZ(float theta)
+    {
+        return Mat3A(Mat3::RotationZ(theta));
+    }
+
+    /**
+     * @brief Rotation matrix around Y axis
+     *
+     * @param theta Rotation angle in radians
+     * @return Mat3A
+     */
+    constexpr static Mat3A RotationY(float theta)
+    {
+        return Mat3A(Mat3::RotationY(theta));
+    }
+
+    /**
+     * @brief Rotation matrix around X axis
+     *
+     * @param theta Rotation angle in radians
+     * @return Mat3A
+     */
+    constexpr static Mat3A RotationX(float theta)
+    {
+        return Mat3A(Mat3::RotationX(theta));
+    }
+
+    /**
+     * @brief Inverse matrix, computed in closed form from the adjugate.
+     *        The columns of the adjugate are cross products of the rows.
+     *
+     * @param det Optional output for the determinant. May be nullptr
+     * @return Mat3A Inverted matrix. If the matrix is not invertible, returns zero matrix.
+     */
+    constexpr Mat3A Inverse(float* det = nullptr) const
+    {
+    #ifdef VECTOR_X86_SIMD
+        if (!IsConstantEvaluated())
+            return inverseKernel(det);
+    #endif
+        return Mat3A(ToMat3().Inverse(det));
+    }
+
+    /**
+     * @brief Inverse of a rotation matrix, which is its transpose.
+     *        The matrix must be orthonormal, which is not checked.
+     *
+     * @return Mat3A Inverted matrix
+     */
+    constexpr Mat3A InverseRigid() const
+    {
+        return !*this;
+    }
+
+    /**
+     * @brief Determinant of the matrix
+     *
+     * @return float Determinant value
+     */
+    constexpr float Determinant() const
+    {
+    #ifdef VECTOR_X86_SIMD
+        if (!IsConstantEvaluated())
+        {
+            const __m128 r0 = _mm_load_ps(data[0]);
+            return sum3_sse(_mm_mul_ps(r0, cross3_sse(_mm_load_ps(data[1]), _mm_load_ps(data[2]))));
+        }
+    #endif
+        return ToMat3().Determinant();
+    }
+
+private:
+    // Runtime kernels behind the constexpr operators
+#ifdef VECTOR_X86_SIMD
+    Mat3A scaleKernel(float scalar) const;
+    Mat3A multiplyKernel(const Mat3A& m) const;
+    Mat3A addKernel(const Mat3A& m) const;
+    Mat3A subtractKernel(const Mat3A& m) const;
+    Mat3A transposeKernel() const;
+    Mat3A inverseKernel(float* det) const;
+#endif
+
+public:
+    // [ row ][ col ], the fourth column is padding
+    float data[3][4];
+};
+
+static_assert(sizeof(Mat3A) == 48, "Mat3A must be 48 bytes");
+
+#ifdef VECTOR_X86_SIMD
+__attribute__((always_inline)) inline Mat3A Mat3A::scaleKernel(float scalar) const
+{
+    const __m128 s = _mm_set1_ps(scalar);
+    Mat3A r;
+    for (int i = 0; i < 3; i++)
+        _mm_store_ps(r.data[i], _mm_mul_ps(_mm_load_ps(data[i]), s));
+    return r;
+}
+
+__attribute__((always_inline)) inline Mat3A Mat3A::multiplyKernel(const Mat3A& m) const
+{
+    const __m128 r0 = rowTimes3x3_sse(data[0], m.data[0]);
+    const __m128 r1 = rowTimes3x3_sse(data[1], m.data[0]);
+    const __m128 r2 = rowTimes3x3_sse(data[2], m.data[0]);
+    Mat3A r;
+    _mm_store_ps(r.data[0], r0);
+    _mm_store_ps(r.data[1], r1);
+    _mm_store_ps(r.data[2], r2);
+    return r;
+}
+
+__attribute__((always_inline)) inline Mat3A Mat3A::addKernel(const Mat3A& m) const
+{
+    Mat3A r;
+    for (int i = 0; i < 3; i++)
+        _mm_store_ps(r.data[i], _mm_add_ps(_mm_load_ps(data[i]), _mm_load_ps(m.data[i])));
+    return r;
+}
+
+__attribute__((always_inline)) inline Mat3A Mat3A::subtractKernel(const Mat3A& m) const
+{
+    Mat3A r;
+    for (int i = 0; i < 3; i++)
+        _mm_store_ps(r.data[i], _mm_sub_ps(_mm_load_ps(data[i]), _mm_load_ps(m.data[i])));
+    return r;
+}
+
+__attribute__((always_inline)) inline Mat3A Mat3A::transposeKernel() const
+{
+    __m128 r0 = _mm_load_ps(data[0]);
+    __m128 r1 = _mm_load_ps(data[1]);
+    __m128 r2 = _mm_load_ps(data[2]);
+    __m128 r3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    Mat3A r;
+    _mm_store_ps(r.data[0], r0);
+    _mm_store_ps(r.data[1], r1);
+    _mm_store_ps(r.data[2], r2);
+    return r;
+}
+
+__attribute__((always_inline)) inline Mat3A Mat3A::inverseKernel(float* det) const
+{
+    const __m128 r0 = _mm_load_ps(data[0]);
+    const __m128 r1 = _mm_load_ps(data[1]);
+    const __m128 r2 = _mm_load_ps(data[2]);
+    __m128 c0 = cross3_sse(r1, r2);
+    __m128 c1 = cross3_sse(r2, r0);
+    __m128 c2 = cross3_sse(r0, r1);
+
+    const float d = sum3_sse(_mm_mul_ps(r0, c0));
+    if (det)
+        *det = d;
+    if (d == 0.0f)
+        return Mat3A(0, 0, 0, 0, 0, 0, 0, 0, 0); // Singular matrix, return zero matrix
+
+    // The adjugate is the transpose of the rows c0, c1, c2
+    __m128 c3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    const __m128 inv = _mm_set1_ps(1.0f / d);
+    Mat3A r;
+    _mm_store_ps(r.data[0], _mm_mul_ps(c0, inv));
+    _mm_store_ps(r.data[1], _mm_mul_ps(c1, inv));
+    _mm_store_ps(r.data[2], _mm_mul_ps(c2, inv));
+    return r;
+}
+#endif
+
+/** @brief Row vector times matrix. Same result as Vector3<float> * Mat3. */
+__attribute__((hot, optimize("O3"), always_inline)) constexpr Vec3A operator*(const Vec3A& v, const Mat3A& m)
+{
+#ifdef VECTOR_X86_SIMD
+    if (!IsConstantEvaluated())
+        return Vec3A::FromSse(rowTimes3x3_sse(&v.x, m.data[0]));
+#endif
+    return {
+        v.x * m.data[0][0] + v.y * m.data[1][0] + v.z * m.data[2][0],
+        v.x * m.data[0][1] + v.y * m.data[1][1] + v.z * m.data[2][1],
+        v.x * m.data[0][2] + v.y * m.data[1][2] + v.z * m.data[2][2]
+    };
+}
+
+
+__attribute__((hot, optimize("O3"), always_inline)) constexpr Vec3A& operator*=(Vec3A& v, const Mat3A& m)
+{
+    return v = v * m;
+}
+
+#endif // MATRIX3A_H
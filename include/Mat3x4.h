@@ -0,0 +1,350 @@
+/**
+ * @file: Mat3x4.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATRIX3X4_H
+#define MATRIX3X4_H
+
+#include "Vector3.h"
+#include "Mat3.h"
+#include "Mat4.h"
+
+#ifdef VECTOR_X86_SIMD
+// Inline kernel with baseline SSE instructions only, no runtime dispatch and
+// no FMA, like Mat4 and Mat3A. It sums (b0*a0 + b1*a1) + (b2*a2 + w), the
+// same order as the scalar code, so the results are identical as long as the
+// including code is built without FP contraction.
+
+/**
+ * @brief Row of a * b: b[0]*A0 + b[1]*A1 + b[2]*A2 + (0, 0, 0, b[3]), where Ak are the rows of a
+ */
+__attribute__((always_inline)) inline __m128 rowTimes3x4_sse(__m128 b, __m128 a0, __m128 a1, __m128 a2)
+{
+    const __m128 wMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+    const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(b, b, 0x00), a0),
+                                 _mm_mul_ps(_mm_shuffle_ps(b, b, 0x55), a1));
+    const __m128 zw = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(b, b, 0xAA), a2),
+                                 _mm_and_ps(b, wMask));
+    return _mm_add_ps(xy, zw);
+}
+#endif
+
+/**
+ * @brief Affine transform stored in 48 bytes.
+ *
+ * Equivalent to a Mat4 whose last column is (0, 0, 0, 1). Each row holds one
+ * of the first three columns of that Mat4, so a point is transformed with
+ * three 4-wide dot products and rows stay 16 byte aligned:
+ *
+ *   Mat4                  Mat3x4
+ *   | L00 L01 L02 0 |     | L00 L10 L20 tx |
+ *   | L10 L11 L12 0 |     | L01 L11 L21 ty |
+ *   | L20 L21 L22 0 |     | L02 L12 L22 tz |
+ *   | tx  ty  tz  1 |
+ *
+ * Operators follow the Mat4 convention: v * (a * b) == (v * a) * b.
+ */
+class alignas(16) Mat3x4
+{
+public:
+    Mat3x4() = default;
+    constexpr Mat3x4(const Mat3x4&) = default;
+
+    /** @brief Construct from the 12 stored values, row by row. */
+    constexpr Mat3x4(const float a11, const float a12, const float a13, const float a14
+                   , const float a21, const float a22, const float a23, const float a24
+                   , const float a31, const float a32, const float a33, const float a34) :
+        data { a11, a12, a13, a14,
+               a21, a22, a23, a24,
+               a31, a32, a33, a34 }
+    {}
+
+    /** @brief Construct from a Mat4. The last column of m is ignored. */
+    constexpr explicit Mat3x4(const Mat4& m) :
+        data { m.data[0][0], m.data[1][0], m.data[2][0], m.data[3][0],
+               m.data[0][1], m.data[1][1], m.data[2][1], m.data[3][1],
+               m.data[0][2], m.data[1][2], m.data[2][2], m.data[3][2] }
+    {}
+
+    /** @brief Construct from a linear transform, without translation. */
+    constexpr explicit Mat3x4(const Mat3& m) :
+        data { m.data[0][0], m.data[1][0], m.data[2][0], 0.0f,
+               m.data[0][1], m.data[1][1], m.data[2][1], 0.0f,
+               m.data[0][2], m.data[1][2], m.data[2][2], 0.0f }
+    {}
+
+    /**
+     * @brief Equivalent 4x4 matrix
+     *
+     * @return Mat4 Matrix with (0, 0, 0, 1) as last column
+     */
+    constexpr Mat4 ToMat4() const
+    {
+        return {
+            data[0][0], data[1][0], data[2][0], 0.0f,
+            data[0][1], data[1][1], data[2][1], 0.0f,
+            data[0][2], data[1][2], data[2][2], 0.0f,
+            data[0][3], data[1][3], data[2][3], 1.0f,
+        };
+    }
+
+    /**
+     * @brief Linear part of the transform (rotation, scale and shear)
+     *
+     * @return Mat3 Upper 3x3 block of the equivalent Mat4
+     */
+    constexpr Mat3 ToMat3() const
+    {
+        return {
+            data[0][0], data[1][0], data[2][0],
+            data[0][1], data[1][1], data[2][1],
+            data[0][2], data[1][2], data[2][2],
+        };
+    }
+
+    /**
+     * @brief Translation part of the transform
+     *
+     * @return Vector3<float> Translation
+     */
+    constexpr Vector3<float> GetTranslation() const
+    {
+        return { data[0][3], data[1][3], data[2][3] };
+    }
+
+    /**
+     * @brief Compose two transforms, 36 multiplications
+     *
+     * @param m Transform applied after this one
+     * @return Mat3x4 Result of the multiplication
+     */
+    constexpr Mat3x4 operator*(const Mat3x4& m) const
+    {
+    #ifdef VECTOR_X86_SIMD
+        if (!IsConstantEvaluated())
+            return multiplyKernel(m);
+    #endif
+        Mat3x4 result = m;
+        for (int i = 0; i < 3; i++)
+        {
+            const float b0 = m.data[i][0];
+            const float b1 = m.data[i][1];
+            const float b2 = m.data[i][2];
+            // Translation only enters the last column. Adding +0 elsewhere
+            // keeps signed zeros the same as the SIMD kernel.
+            const float w[4] = { 0.0f, 0.0f, 0.0f, m.data[i][3] };
+            for (int j = 0; j < 4; j++)
+                result.data[i][j] = (b0 * data[0][j] + b1 * data[1][j]) + (b2 * data[2][j] + w[j]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Compose two transforms, 36 multiplications
+     *
+     * @param m Transform applied after this one
+     * @return Mat3x4& Reference to this matrix
+     */
+    constexpr Mat3x4& operator*=(const Mat3x4& m)
+    {
+        return *this = *this * m;
+    }
+
+    /**
+     * @brief Transform a point (implicit w = 1)
+     *
+     * @param p Point
+     * @return Vector3<float> Transformed point
+     */
+    __attribute__((always_inline)) constexpr Vector3<float> TransformPoint(const Vector3<float>& p) const
+    {
+        return {
+            p.x * data[0][0] + p.y * data[0][1] + p.z * data[0][2] + data[0][3],
+            p.x * data[1][0] + p.y * data[1][1] + p.z * data[1][2] + data[1][3],
+            p.x * data[2][0] + p.y * data[2][1] + p.z * data[2][2] + data[2][3],
+        };
+    }
+
+    /**
+     * @brief Transform a direction (implicit w = 0). Translation is ignored.
+     *
+     * @param d Direction
+     * @return Vector3<float> Transformed direction
+     */
+    __attribute__((always_inline)) constexpr Vector3<float> TransformDirection(const Vector3<float>& d) const
+    {
+        return {
+            d.x * data[0][0] + d.y * data[0][1] + d.z * data[0][2],
+            d.x * data[1][0] + d.y * data[1][1] + d.z * data[1][2],
+            d.x * data[2][0] + d.y * data[2][1] + d.z * data[2][2],
+        };
+    }
+
+    /**
+     * @brief Inverse transform
+     *
+     * @return Mat3x4 Inverted transform. If the linear part is not invertible, returns zero matrix.
+     */
+    constexpr Mat3x4 Inverse() const
+    {
+        // | L 0 |^-1   |  L^-1    0 |
+        // | t 1 |    = | -t*L^-1  1 |
+        const Mat3 inv = ToMat3().Inverse();
+        const Vector3<float> t = GetTranslation() * inv;
+
+        Mat3x4 result(inv);
+        result.data[0][3] = -t.x;
+        result.data[1][3] = -t.y;
+        result.data[2][3] = -t.z;
+        return result;
+    }
+
+    /**
+     * @brief  Identity transform
+     *
+     * @return constexpr Mat3x4   Return identity matrix
+     */
+    constexpr static Mat3x4 Identity()
+    {
+        return {
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+        };
+    }
+
+    /**
+     * @brief Scaling transform
+     *
+     * @param x Scale factor in X axis
+     * @param y Scale factor in Y axis
+     * @param z Scale factor in Z axis
+     * @return constexpr Mat3x4
+     */
+    constexpr static Mat3x4 Scaling(float x, float y, float z)
+    {
+        return {
+            x,    0.0f, 0.0f, 0.0f,
+            0.0f, y,    0.0f, 0.0f,
+            0.0f, 0.0f, z,    0.0f,
+        };
+    }
+
+    /**
+     * @brief Scaling transform
+     *
+     * @param factor Scale factor
+     * @return constexpr Mat3x4
+     */
+    constexpr static Mat3x4 Scaling(float factor)
+    {
+        return Scaling(factor, factor, factor);
+    }
+
+    template<class V>
+    constexpr static Mat3x4 Translation(const V& tl)
+    {
+        return Translation( tl.x,tl.y,tl.z );
+    }
+
+    constexpr static Mat3x4 Translation(float x, float y, float z)
+    {
+        return {
+            1.0f, 0.0f, 0.0f, x,
+            0.0f, 1.0f, 0.0f, y,
+            0.0f, 0.0f, 1.0f, z,
+        };
+    }
+
+    /**
+     * @brief Rotation transform around Z axis
+     *
+     * @param theta Rotation angle in radians
+     * @return Mat3x4
+     */
+    constexpr static Mat3x4 RotationZ(float theta)
+    {
+        return Mat3x4(Mat3::RotationZ(theta));
+    }
+
+    /**
+     * @brief Rotation transform around Y axis
+     *
+     * @param theta Rotation angle in radians
+     * @return Mat3x4
+     */
+    constexpr static Mat3x4 RotationY(float theta)
+    {
+        return Mat3x4(Mat3::RotationY(theta));
+    }
+
+    /**
+     * @brief Rotation transform around X axis
+     *
+     * @param theta Rotation angle in radians
+     * @return Mat3x4
+     */
+    constexpr static Mat3x4 RotationX(float theta)
+    {
+        return Mat3x4(Mat3::RotationX(theta));
+    }
+
+private:
+#ifdef VECTOR_X86_SIMD
+    // Runtime kernel behind the constexpr product
+    inline Mat3x4 multiplyKernel(const Mat3x4& m) const;
+#endif
+
+public:
+    // [ row ][ col ]
+    float data[3][4];
+};
+
+#ifdef VECTOR_X86_SIMD
+__attribute__((always_inline)) inline Mat3x4 Mat3x4::multiplyKernel(const Mat3x4& m) const
+{
+    const __m128 a0 = _mm_load_ps(data[0]);
+    const __m128 a1 = _mm_load_ps(data[1]);
+    const __m128 a2 = _mm_load_ps(data[2]);
+    const __m128 r0 = rowTimes3x4_sse(_mm_load_ps(m.data[0]), a0, a1, a2);
+    const __m128 r1 = rowTimes3x4_sse(_mm_load_ps(m.data[1]), a0, a1, a2);
+    const __m128 r2 = rowTimes3x4_sse(_mm_load_ps(m.data[2]), a0, a1, a2);
+    Mat3x4 r;
+    _mm_store_ps(r.data[0], r0);
+    _mm_store_ps(r.data[1], r1);
+    _mm_store_ps(r.data[2], r2);
+    return r;
+}
+#endif
+
+__attribute__((hot, optimize("O3"), always_inline)) constexpr Vector3<float> operator*(const Vector3<float>& v, const Mat3x4& m)
+{
+    return m.TransformPoint(v);
+}
+
+__attribute__((hot, optimize("O3"), always_inline)) constexpr Vector3<float>& operator*=(Vector3<float>& v, const Mat3x4& m)
+{
+    return v = m.TransformPoint(v);
+}
+
+#endif // MATRIX3X4_H
@@ -3,7 +3,7 @@
  * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
  * Created Date: 2021-11-14
  * -----
- * Last Modified: 22-10-2025
+ * Last Modified: 17-10-2026
  * Modified By: Ricard Bitriá Ribes
  * -----
  * @copyright (c) 2021 Ricard Bitriá Ribes
@@ -26,8 +26,65 @@
 #define MATRIX4_H
 
 #include <stdint.h>
+#include <type_traits>
 #include "Vector4.h"
 #include "Mat3.h"
+#include "Simd.h"
+#include "ConstexprMath.h"
+
+// ASM functions
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+extern "C" void mult_4x4x4_asm(const float* A, const float* B, float* C);
+extern "C" void mult_1x4x4_asm(const float* v, const float* M, float* u);
+extern "C" void mult_4x4xS_asm(const float* A, const float* s, float* C);
+#endif
+
+#if defined(VECTOR_X86_SIMD)
+// Inline kernels with baseline SSE instructions only, no runtime dispatch and
+// no FMA, like Mat3A. They sum (x*r0 + y*r1) + (z*r2 + w*r3), the same order
+// as the scalar code of the operators, so both give the same bits as long as
+// the including code is built without FP contraction (see Simd.h).
+// The constexpr operators only call them outside of constant expressions.
+
+/**
+ * @brief C = A * s for 16 byte aligned 4x4 matrices
+ */
+__attribute__((always_inline)) inline void mult_4x4xS_sse(const float* A, float s, float* C)
+{
+    const __m128 vs = _mm_set1_ps(s);
+    _mm_store_ps(C,      _mm_mul_ps(_mm_load_ps(A),      vs));
+    _mm_store_ps(C + 4,  _mm_mul_ps(_mm_load_ps(A + 4),  vs));
+    _mm_store_ps(C + 8,  _mm_mul_ps(_mm_load_ps(A + 8),  vs));
+    _mm_store_ps(C + 12, _mm_mul_ps(_mm_load_ps(A + 12), vs));
+}
+
+/**
+ * @brief Row vector a times the 16 byte aligned 4x4 matrix M
+ */
+__attribute__((always_inline)) inline __m128 rowTimes4x4_sse(__m128 a, const float* M)
+{
+    const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, 0x00), _mm_load_ps(M)),
+                                 _mm_mul_ps(_mm_shuffle_ps(a, a, 0x55), _mm_load_ps(M + 4)));
+    const __m128 zw = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, 0xAA), _mm_load_ps(M + 8)),
+                                 _mm_mul_ps(_mm_shuffle_ps(a, a, 0xFF), _mm_load_ps(M + 12)));
+    return _mm_add_ps(xy, zw);
+}
+
+/**
+ * @brief C = A * B for 16 byte aligned 4x4 matrices. C may alias A or B
+ */
+__attribute__((always_inline)) inline void mult_4x4x4_sse(const float* A, const float* B, float* C)
+{
+    const __m128 r0 = rowTimes4x4_sse(_mm_load_ps(A),      B);
+    const __m128 r1 = rowTimes4x4_sse(_mm_load_ps(A + 4),  B);
+    const __m128 r2 = rowTimes4x4_sse(_mm_load_ps(A + 8),  B);
+    const __m128 r3 = rowTimes4x4_sse(_mm_load_ps(A + 12), B);
+    _mm_store_ps(C,      r0);
+    _mm_store_ps(C + 4,  r1);
+    _mm_store_ps(C + 8,  r2);
+    _mm_store_ps(C + 12, r3);
+}
+#endif
 
 class alignas(16) Mat4
 {
@@ -85,11 +142,21 @@ public:
      * @param  scalar Scalar to multiply
      * @return Mat4& Reference to this matrix
      */
-    Mat4& operator*=(float scalar)
+    constexpr Mat4& operator*=(float scalar)
     {
-    #ifdef CONFIG_IDF_TARGET_ESP32S3
-        mult_4x4xS_asm(&data[0][0], &scalar, &data[0][0]);
-    #else
+    #if defined(CONFIG_IDF_TARGET_ESP32S3)
+        if (!IsConstantEvaluated())
+        {
+            mult_4x4xS_asm(&data[0][0], &scalar, &data[0][0]);
+            return *this;
+        }
+    #elif defined(VECTOR_X86_SIMD)
+        if (!IsConstantEvaluated())
+        {
+            mult_4x4xS_sse(&data[0][0], scalar, &data[0][0]);
+            return *this;
+        }
+    #endif
         data[0][0] *= scalar;
         data[0][1] *= scalar;
         data[0][2] *= scalar;
@@ -106,7 +173,6 @@ public:
         data[3][1] *= scalar;
         data[3][2] *= scalar;
         data[3][3] *= scalar;
-    #endif
         return *this;
     }
 
@@ -116,20 +182,18 @@ public:
      * @param scalar Scalar to multiply
      * @return Mat4 Result of the multiplication
      */
-    Mat4 operator*(float scalar) const
+    constexpr Mat4 operator*(float scalar) const
     {
-    #ifdef CONFIG_IDF_TARGET_ESP32S3
-        Mat4 result;
-        mult_4x4xS_asm(&data[0][0], &scalar, &result.data[0][0]);
-        return result;
-    #else
+    #if defined(CONFIG_IDF_TARGET_ESP32S3) || defined(VECTOR_X86_SIMD)
+        if (!IsConstantEvaluated())
+            return scaleKernel(scalar);
+    #endif
         return {
             data[0][0] * scalar, data[0][1] * scalar, data[0][2] * scalar, data[0][3] * scalar,
             data[1][0] * scalar, data[1][1] * scalar, data[1][2] * scalar, data[1][3] * scalar,
             data[2][0] * scalar, data[2][1] * scalar, data[2][2] * scalar, data[2][3] * scalar,
             data[3][0] * scalar, data[3][1] * scalar, data[3][2] * scalar, data[3][3] * scalar,
         };
-    #endif
     }
 
     /**
@@ -138,7 +202,22 @@ public:
      * @param m Matrix to multiply
      * @return Mat4 Result of the multiplication
      */
-    Mat4& operator*=(const Mat4& m);
+    constexpr Mat4& operator*=(const Mat4& m)
+    {
+    #ifdef CONFIG_IDF_TARGET_ESP32S3
+        if (!IsConstantEvaluated())
+        {
+            mult_4x4x4_asm(&data[0][0], &m.data[0][0], &data[0][0]);
+            return *this;
+        }
+    #endif
+        // Element wise copy: the ESP32-S3 assignment operator is not constexpr
+        const Mat4 r = *this * m;
+        for (int i = 0; i < 4; i++)
+            for (int j = 0; j < 4; j++)
+                data[i][j] = r.data[i][j];
+        return *this;
+    }
 
     /**
      * @brief Matrix multiplication
@@ -146,7 +225,31 @@ public:
      * @param m Matrix to multiply
      * @return Mat4 Result of the multiplication
      */
-    Mat4 operator*(const Mat4& m) const;
+    constexpr Mat4 operator*(const Mat4& m) const
+    {
+    #if defined(CONFIG_IDF_TARGET_ESP32S3) || defined(VECTOR_X86_SIMD)
+        if (!IsConstantEvaluated())
+            return multiplyKernel(m);
+    #endif
+        return {
+            (data[0][0]*m.data[0][0] + data[0][1]*m.data[1][0]) + (data[0][2]*m.data[2][0] + data[0][3]*m.data[3][0]),
+            (data[0][0]*m.data[0][1] + data[0][1]*m.data[1][1]) + (data[0][2]*m.data[2][1] + data[0][3]*m.data[3][1]),
+            (data[0][0]*m.data[0][2] + data[0][1]*m.data[1][2]) + (data[0][2]*m.data[2][2] + data[0][3]*m.data[3][2]),
+            (data[0][0]*m.data[0][3] + data[0][1]*m.data[1][3]) + (data[0][2]*m.data[2][3] + data[0][3]*m.data[3][3]),
+            (data[1][0]*m.data[0][0] + data[1][1]*m.data[1][0]) + (data[1][2]*m.data[2][0] + data[1][3]*m.data[3][0]),
+            (data[1][0]*m.data[0][1] + data[1][1]*m.data[1][1]) + (data[1][2]*m.data[2][1] + data[1][3]*m.data[3][1]),
+            (data[1][0]*m.data[0][2] + data[1][1]*m.data[1][2]) + (data[1][2]*m.data[2][2] + data[1][3]*m.data[3][2]),
+            (data[1][0]*m.data[0][3] + data[1][1]*m.data[1][3]) + (data[1][2]*m.data[2][3] + data[1][3]*m.data[3][3]),
+            (data[2][0]*m.data[0][0] + data[2][1]*m.data[1][0]) + (data[2][2]*m.data[2][0] + data[2][3]*m.data[3][0]),
+            (data[2][0]*m.data[0][1] + data[2][1]*m.data[1][1]) + (data[2][2]*m.data[2][1] + data[2][3]*m.data[3][1]),
+            (data[2][0]*m.data[0][2] + data[2][1]*m.data[1][2]) + (data[2][2]*m.data[2][2] + data[2][3]*m.data[3][2]),
+            (data[2][0]*m.data[0][3] + data[2][1]*m.data[1][3]) + (data[2][2]*m.data[2][3] + data[2][3]*m.data[3][3]),
+            (data[3][0]*m.data[0][0] + data[3][1]*m.data[1][0]) + (data[3][2]*m.data[2][0] + data[3][3]*m.data[3][0]),
+            (data[3][0]*m.data[0][1] + data[3][1]*m.data[1][1]) + (data[3][2]*m.data[2][1] + data[3][3]*m.data[3][1]),
+            (data[3][0]*m.data[0][2] + data[3][1]*m.data[1][2]) + (data[3][2]*m.data[2][2] + data[3][3]*m.data[3][2]),
+            (data[3][0]*m.data[0][3] + data[3][1]*m.data[1][3]) + (data[3][2]*m.data[2][3] + data[3][3]*m.data[3][3]),
+        };
+    }
 
     /**
      * @brief Matrix addition
@@ -154,7 +257,7 @@ public:
      * @param m Matrix to add
      * @return Mat4 Result of the addition
      */
-    Mat4 operator+(const Mat4& m) const
+    constexpr Mat4 operator+(const Mat4& m) const
     {
         return {
             data[0][0] + m.data[0][0], data[0][1] + m.data[0][1], data[0][2] + m.data[0][2], data[0][3] + m.data[0][3],
@@ -170,7 +273,7 @@ public:
      * @param m Matrix to add
      * @return Mat4& Reference to this matrix
      */
-    Mat4& operator+=(const Mat4& m)
+    constexpr Mat4& operator+=(const Mat4& m)
     {
         data[0][0] += m.data[0][0];
         data[0][1] += m.data[0][1];
@@ -197,7 +300,7 @@ public:
      * @param m Matrix to subtract
      * @return Mat4 Result of the subtraction
      */
-    Mat4 operator-(const Mat4& m) const
+    constexpr Mat4 operator-(const Mat4& m) const
     {
         return {
             data[0][0] - m.data[0][0], data[0][1] - m.data[0][1], data[0][2] - m.data[0][2], data[0][3] - m.data[0][3],
@@ -213,7 +316,7 @@ public:
      * @param m Matrix to subtract
      * @return Mat4& Reference to this matrix
      */
-    Mat4& operator-=(const Mat4& m)
+    constexpr Mat4& operator-=(const Mat4& m)
     {
         data[0][0] -= m.data[0][0];
         data[0][1] -= m.data[0][1];
@@ -239,7 +342,7 @@ public:
      * 
      * @return Mat4 
      */
-    __attribute__((always_inline)) inline Mat4 operator!() const
+    __attribute__((always_inline)) constexpr Mat4 operator!() const
     {
         return {
             data[0][0], data[1][0], data[2][0], data[3][0],
@@ -249,7 +352,7 @@ public:
         };
     }
 
-    __attribute__((always_inline)) inline float& operator()(const int row, const int col)
+    __attribute__((always_inline)) constexpr float& operator()(const int row, const int col)
     {
         assert(row >= 0 && row < 4 && col >= 0 && col < 4 && "Mat4: row and col indices must be in [0,3]");
         return data[row][col];
@@ -305,7 +408,18 @@ public:
      * @param theta Rotation angle in radians
      * @return Mat4 
      */
-    static Mat4 RotationZ(float theta);
+    constexpr static Mat4 RotationZ(float theta)
+    {
+        const float sinTheta = ConstexprSin(theta);
+        const float cosTheta = ConstexprCos(theta);
+
+        return {
+            cosTheta,  sinTheta, 0.0f, 0.0f,
+            -sinTheta, cosTheta, 0.0f, 0.0f,
+            0.0f,      0.0f,     1.0f, 0.0f,
+            0.0f,      0.0f,     0.0f, 1.0f,
+        };
+    }
 
     /**
      * @brief Rotation matrix around Y axis
@@ -313,7 +427,18 @@ public:
      * @param theta Rotation angle in radians
      * @return Mat4 
      */
-    static Mat4 RotationY(float theta);
+    constexpr static Mat4 RotationY(float theta)
+    {
+        const float sinTheta = ConstexprSin(theta);
+        const float cosTheta = ConstexprCos(theta);
+
+        return {
+            cosTheta, 0.0f, -sinTheta, 0.0f,
+            0.0f,     1.0f, 0.0f,      0.0f,
+            sinTheta, 0.0f, cosTheta,  0.0f,
+            0.0f,     0.0f, 0.0f,      1.0f,
+        };
+    }
 
     /**
      * @brief Rotation matrix around X axis
@@ -321,7 +446,18 @@ public:
      * @param theta Rotation angle in radians
      * @return Mat4 
      */
-    static Mat4 RotationX(float theta);
+    constexpr static Mat4 RotationX(float theta)
+    {
+        const float sinTheta = ConstexprSin(theta);
+        const float cosTheta = ConstexprCos(theta);
+
+        return {
+            1.0f, 0.0f,     0.0f,     0.0f,
+            0.0f, cosTheta, sinTheta, 0.0f,
+            0.0f,-sinTheta, cosTheta, 0.0f,
+            0.0f, 0.0f,     0.0f,     1.0f,
+        };
+    }
 
     template<class V>
     constexpr static Mat4 Translation(const V& tl)
@@ -358,58 +494,230 @@ public:
     }
 
     /**
-     * @brief Inverse matrix
+     * @brief Inverse matrix, computed in closed form from the adjugate
+     * 
+     * @param det Optional output for the determinant. May be nullptr
+     * @return Mat4 Inverted matrix. If the matrix is not invertible, returns zero matrix.
+     */
+    __attribute__((optimize("O3"))) constexpr Mat4 Inverse(float* det = nullptr) const
+    {
+    #ifdef VECTOR_X86_SIMD
+        if (!IsConstantEvaluated() && SimdActiveLevel() >= SimdLevel::SSE41)
+            return inverseKernel(det);
+    #endif
+        const float (&m)[4][4] = data;
+
+        // 2x2 determinants of the top (s) and bottom (c) row pairs
+        const float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+        const float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+        const float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+        const float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+        const float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+        const float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+        const float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+        const float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+        const float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+        const float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+        const float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+        const float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+        const float d = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        if (det)
+            *det = d;
+        if (d == 0.0f)
+            return Mat4(0.0f); // Singular matrix, return zero matrix
+
+        // Adjugate divided by the determinant
+        const float inv = 1.0f / d;
+        return {
+            ( m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * inv,
+            (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * inv,
+            ( m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * inv,
+            (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * inv,
+
+            (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * inv,
+            ( m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * inv,
+            (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * inv,
+            ( m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * inv,
+
+            ( m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * inv,
+            (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * inv,
+            ( m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * inv,
+            (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * inv,
+
+            (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * inv,
+            ( m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * inv,
+            (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * inv,
+            ( m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * inv,
+        };
+    }
+
+    /**
+     * @brief Inverse of an affine matrix (last column is 0, 0, 0, 1).
+     *        Inverts the upper 3x3 block and transforms the translation.
      * 
      * @return Mat4 Inverted matrix. If the matrix is not invertible, returns zero matrix.
      */
-    Mat4 Inverse() const;
+    __attribute__((optimize("O3"))) constexpr Mat4 InverseAffine() const
+    {
+        // | L 0 |^-1   |  L^-1    0 |
+        // | t 1 |    = | -t*L^-1  1 |
+        const float (&m)[4][4] = data;
+
+        const float a00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+        const float a01 = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+        const float a02 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+        const float d = m[0][0] * a00 + m[1][0] * a01 + m[2][0] * a02;
+        if (d == 0.0f)
+            return Mat4(0.0f); // Singular matrix, return zero matrix
+
+        const float inv = 1.0f / d;
+        const float r00 = a00 * inv;
+        const float r01 = a01 * inv;
+        const float r02 = a02 * inv;
+        const float r10 = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) * inv;
+        const float r11 = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv;
+        const float r12 = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv;
+        const float r20 = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) * inv;
+        const float r21 = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv;
+        const float r22 = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv;
+
+        const float tx = m[3][0];
+        const float ty = m[3][1];
+        const float tz = m[3][2];
+        return {
+            r00, r01, r02, 0.0f,
+            r10, r11, r12, 0.0f,
+            r20, r21, r22, 0.0f,
+            -(tx * r00 + ty * r10 + tz * r20),
+            -(tx * r01 + ty * r11 + tz * r21),
+            -(tx * r02 + ty * r12 + tz * r22),
+            1.0f,
+        };
+    }
+
+    /**
+     * @brief Inverse of a rigid transform (rotation followed by translation).
+     *        Transposes the rotation and transforms the translation.
+     *        The upper 3x3 block must be orthonormal, which is not checked.
+     * 
+     * @return Mat4 Inverted matrix
+     */
+    __attribute__((optimize("O3"))) constexpr Mat4 InverseRigid() const
+    {
+        // The inverse of a rotation is its transpose
+        const float (&m)[4][4] = data;
+        const float tx = m[3][0];
+        const float ty = m[3][1];
+        const float tz = m[3][2];
+        return {
+            m[0][0], m[1][0], m[2][0], 0.0f,
+            m[0][1], m[1][1], m[2][1], 0.0f,
+            m[0][2], m[1][2], m[2][2], 0.0f,
+            -(tx * m[0][0] + ty * m[0][1] + tz * m[0][2]),
+            -(tx * m[1][0] + ty * m[1][1] + tz * m[1][2]),
+            -(tx * m[2][0] + ty * m[2][1] + tz * m[2][2]),
+            1.0f,
+        };
+    }
 
-    float Determinant() const;
+    /**
+     * @brief Determinant of the matrix
+     * 
+     * @return float Determinant value
+     */
+    constexpr float Determinant() const
+    {
+        return data[0][3] * data[1][2] * data[2][1] * data[3][0] - data[0][2] * data[1][3] * data[2][1] * data[3][0]
+             - data[0][3] * data[1][1] * data[2][2] * data[3][0] + data[0][1] * data[1][3] * data[2][2] * data[3][0]
+             + data[0][2] * data[1][1] * data[2][3] * data[3][0] - data[0][1] * data[1][2] * data[2][3] * data[3][0]
+             - data[0][3] * data[1][2] * data[2][0] * data[3][1] + data[0][2] * data[1][3] * data[2][0] * data[3][1]
+             + data[0][3] * data[1][0] * data[2][2] * data[3][1] - data[0][0] * data[1][3] * data[2][2] * data[3][1]
+             - data[0][2] * data[1][0] * data[2][3] * data[3][1] + data[0][0] * data[1][2] * data[2][3] * data[3][1]
+             + data[0][3] * data[1][1] * data[2][0] * data[3][2] - data[0][1] * data[1][3] * data[2][0] * data[3][2]
+             - data[0][3] * data[1][0] * data[2][1] * data[3][2] + data[0][0] * data[1][3] * data[2][1] * data[3][2]
+             + data[0][1] * data[1][0] * data[2][3] * data[3][2] - data[0][0] * data[1][1] * data[2][3] * data[3][2]
+             - data[0][2] * data[1][1] * data[2][0] * data[3][3] + data[0][1] * data[1][2] * data[2][0] * data[3][3]
+             + data[0][2] * data[1][0] * data[2][1] * data[3][3] - data[0][0] * data[1][2] * data[2][1] * data[3][3]
+             - data[0][1] * data[1][0] * data[2][2] * data[3][3] + data[0][0] * data[1][1] * data[2][2] * data[3][3];
+    }
+
+private:
+    // Runtime kernels behind the constexpr operators
+#if defined(CONFIG_IDF_TARGET_ESP32S3) || defined(VECTOR_X86_SIMD)
+    Mat4 multiplyKernel(const Mat4& m) const;
+    Mat4 scaleKernel(float scalar) const;
+#endif
+#ifdef VECTOR_X86_SIMD
+    Mat4 inverseKernel(float* det) const;
+#endif
 
 public:
     // [ row ][ col ]
     float data[4][4];
 };
 
-// ASM functions
-#if defined(CONFIG_IDF_TARGET_ESP32S3)
-extern "C" void mult_4x4x4_asm(const float* A, const float* B, float* C);
-extern "C" void mult_1x4x4_asm(const float* v, const float* M, float* u);
-extern "C" void mult_4x4xS_asm(const float* A, const float* s, float* C);
-#endif
-
-template<typename T>
-__attribute__((always_inline, hot, optimize("O3"))) inline Vector4<T>& operator*=(Vector4<T>& v, const Mat4& m)
+#if defined(CONFIG_IDF_TARGET_ESP32S3) || defined(VECTOR_X86_SIMD)
+__attribute__((always_inline)) inline Mat4 Mat4::multiplyKernel(const Mat4& m) const
 {
-    return v = v * m;
+    Mat4 result;
+#ifdef CONFIG_IDF_TARGET_ESP32S3
+    mult_4x4x4_asm(&data[0][0], &m.data[0][0], &result.data[0][0]);
+#else
+    mult_4x4x4_sse(&data[0][0], &m.data[0][0], &result.data[0][0]);
+#endif
+    return result;
 }
 
-template<typename T>
-__attribute__((always_inline, hot, optimize("O3"))) inline Vector4<T> operator*(const Vector4<T>& v, const Mat4& m)
+__attribute__((always_inline)) inline Mat4 Mat4::scaleKernel(float scalar) const
 {
-    return{
-        v.x * m.data[0][0] + v.y * m.data[1][0] + v.z * m.data[2][0] + v.w * m.data[3][0],
-        v.x * m.data[0][1] + v.y * m.data[1][1] + v.z * m.data[2][1] + v.w * m.data[3][1],
-        v.x * m.data[0][2] + v.y * m.data[1][2] + v.z * m.data[2][2] + v.w * m.data[3][2],
-        v.x * m.data[0][3] + v.y * m.data[1][3] + v.z * m.data[2][3] + v.w * m.data[3][3]
-    };
+    Mat4 result;
+#ifdef CONFIG_IDF_TARGET_ESP32S3
+    mult_4x4xS_asm(&data[0][0], &scalar, &result.data[0][0]);
+#else
+    mult_4x4xS_sse(&data[0][0], scalar, &result.data[0][0]);
+#endif
+    return result;
 }
 
-#if defined(CONFIG_IDF_TARGET_ESP32S3)
-template<>
-__attribute__((always_inline)) inline Vector4<float> operator*(const Vector4<float>& v, const Mat4& m)
+/**
+ * @brief Runtime v * M kernel for float vectors
+ */
+__attribute__((always_inline)) inline Vector4<float> mult_1x4x4(const Vector4<float>& v, const Mat4& m)
 {
-    static Vector4<float> u;
-    mult_1x4x4_asm((float*)&v, &m.data[0][0], (float*)&u);
+    Vector4<float> u;
+#ifdef CONFIG_IDF_TARGET_ESP32S3
+    mult_1x4x4_asm((const float*)&v, &m.data[0][0], (float*)&u);
+#else
+    _mm_store_ps(&u.x, rowTimes4x4_sse(_mm_load_ps(&v.x), &m.data[0][0]));
+#endif
     return u;
 }
+#endif
 
-template<>
-__attribute__((always_inline)) inline Vector4<float>& operator*=(Vector4<float>& v, const Mat4& m)
+template<typename T>
+__attribute__((always_inline, hot, optimize("O3"))) constexpr Vector4<T>& operator*=(Vector4<T>& v, const Mat4& m)
 {
-    mult_1x4x4_asm((float*)&v, &m.data[0][0], (float*)&v);
-    return v;
+    return v = v * m;
 }
+
+template<typename T>
+__attribute__((always_inline, hot, optimize("O3"))) constexpr Vector4<T> operator*(const Vector4<T>& v, const Mat4& m)
+{
+#if defined(CONFIG_IDF_TARGET_ESP32S3) || defined(VECTOR_X86_SIMD)
+    if constexpr (std::is_same<T, float>::value)
+    {
+        if (!IsConstantEvaluated())
+            return mult_1x4x4(v, m);
+    }
 #endif
+    return{
+        (v.x * m.data[0][0] + v.y * m.data[1][0]) + (v.z * m.data[2][0] + v.w * m.data[3][0]),
+        (v.x * m.data[0][1] + v.y * m.data[1][1]) + (v.z * m.data[2][1] + v.w * m.data[3][1]),
+        (v.x * m.data[0][2] + v.y * m.data[1][2]) + (v.z * m.data[2][2] + v.w * m.data[3][2]),
+        (v.x * m.data[0][3] + v.y * m.data[1][3]) + (v.z * m.data[2][3] + v.w * m.data[3][3])
+    };
+}
 
 #endif // MATRIX4_H
@@ -3,7 +3,7 @@
  * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
  * Created Date: 2021-11-14
  * -----
- * Last Modified: 16-05-2023
+ * Last Modified: 17-10-2026
  * Modified By: Ricard Bitriá Ribes
  * -----
  * @copyright (c) 2021 Ricard Bitriá Ribes
@@ -27,5 +27,6 @@
 
 #include "Mat3.h"
 #include "Mat4.h"
+#include "Mat3x4.h"
 
 #endif // MATRIX_H
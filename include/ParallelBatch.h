@@ -0,0 +1,105 @@
+/**
+ * @file: ParallelBatch.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PARALLEL_BATCH_H
+#define PARALLEL_BATCH_H
+
+#include <stddef.h>
+#include "BatchTransform.h"
+#include "VectorBatch.h"
+#include "ThreadPool.h"
+
+// Multithreaded versions of the batch kernels. Each overload takes the pool
+// as first argument and otherwise behaves exactly like the single threaded
+// function of the same name: same arguments, same aliasing rules and
+// bit-identical output for any number of threads.
+//
+// The array is cut into chunks whose input and output fit in half the per-core
+// cache (ThreadPool::CacheSize()), with at least four chunks per thread so
+// work stealing can even out slower threads. Chunk sizes are multiples of
+// ParallelBatchAlign, a multiple of every kernel's block width, so every
+// element goes through the same kernel code as in a single call.
+// Arrays shorter than ParallelBatchThreshold, and pools of one thread, call
+// the single threaded function directly.
+
+/** @brief Chunk sizes are multiples of this many elements. */
+constexpr size_t ParallelBatchAlign = 64;
+
+/** @brief Minimum number of elements before more than one thread is used. */
+constexpr size_t ParallelBatchThreshold = 16384;
+
+//**********************************************************************
+//* Transforms
+//**********************************************************************
+/** @brief Parallel TransformBatch(). */
+void TransformBatch(ThreadPool& pool, const Mat4& m, const Vec4f* in, Vec4f* out, size_t n);
+
+/** @brief Parallel TransformPointBatch() to homogeneous coordinates. */
+void TransformPointBatch(ThreadPool& pool, const Mat4& m, const Vec3f* in, Vec4f* out, size_t n);
+
+/** @brief Parallel TransformPointBatch() for affine matrices. */
+void TransformPointBatch(ThreadPool& pool, const Mat4& m, const Vec3f* in, Vec3f* out, size_t n);
+
+/** @brief Parallel TransformDirectionBatch(). */
+void TransformDirectionBatch(ThreadPool& pool, const Mat4& m, const Vec3f* in, Vec3f* out, size_t n);
+
+/** @brief Parallel TransformPointBatch() by an affine transform. */
+void TransformPointBatch(ThreadPool& pool, const Mat3x4& m, const Vec3f* in, Vec3f* out, size_t n);
+
+/** @brief Parallel TransformDirectionBatch() by an affine transform. */
+void TransformDirectionBatch(ThreadPool& pool, const Mat3x4& m, const Vec3f* in, Vec3f* out, size_t n);
+
+//**********************************************************************
+//* Half precision transforms
+//**********************************************************************
+/** @brief Parallel TransformBatch() of half precision vectors. */
+void TransformBatch(ThreadPool& pool, const Mat4& m, const Vec4f16* in, Vec4f16* out, size_t n);
+
+/** @brief Parallel TransformPointBatch() of half precision points to homogeneous coordinates. */
+void TransformPointBatch(ThreadPool& pool, const Mat4& m, const Vec3f16* in, Vec4f* out, size_t n);
+
+/** @brief Parallel TransformPointBatch() of half precision points. */
+void TransformPointBatch(ThreadPool& pool, const Mat4& m, const Vec3f16* in, Vec3f16* out, size_t n);
+
+/** @brief Parallel TransformDirectionBatch() of half precision directions. */
+void TransformDirectionBatch(ThreadPool& pool, const Mat4& m, const Vec3f16* in, Vec3f16* out, size_t n);
+
+//**********************************************************************
+//* Normalization and projection
+//**********************************************************************
+/** @brief Parallel NormalizeBatch(). */
+template<Precision P = Precision::Exact>
+void NormalizeBatch(ThreadPool& pool, const Vec3f* in, Vec3f* out, size_t n);
+
+/** @brief Parallel ProjectBatch() to float screen coordinates. invW may be nullptr. */
+void ProjectBatch(ThreadPool& pool, const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2f* screen, float* invW, size_t n);
+
+/** @brief Parallel ProjectBatch() to integer pixel coordinates. invW may be nullptr. */
+void ProjectBatch(ThreadPool& pool, const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2* screen, float* invW, size_t n);
+
+/** @brief Parallel ProjectBatch() to 16 bit pixel coordinates. invW may be nullptr. */
+void ProjectBatch(ThreadPool& pool, const Mat4& mvp, const Viewport& vp, const Vec3f* in, Vec2h* screen, float* invW, size_t n);
+
+#endif // PARALLEL_BATCH_H
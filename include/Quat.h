@@ -0,0 +1,255 @@
+/**
+ * @file: Quat.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUAT_H
+#define QUAT_H
+
+#include <stddef.h>
+#include "Vector4.h"
+#include "Mat3.h"
+#include "Mat4.h"
+
+//**********************************************************************
+//* Rotation quaternion (X,Y,Z,W)
+//**********************************************************************
+/**
+ * @brief Rotation quaternion stored as a Vector4<float>: (x, y, z) is the
+ *        vector part and w the scalar part.
+ *
+ * Products follow the matrix convention of the library (row vectors):
+ * a * b rotates by a first and then by b, so
+ * (a * b).ToMat3() == a.ToMat3() * b.ToMat3() and v * (a * b) == (v * a) * b.
+ *
+ * Rotations built with RotationX/Y/Z() match the Mat3/Mat4 functions of the
+ * same name. Vector4 arithmetic (+, -, scalar *) and operator* between two
+ * Vector4 (dot product) are inherited.
+ */
+class Quat : public Vector4<float>
+{
+public:
+    /** @brief Default constructor. Components are left uninitialized. */
+    Quat() = default;
+
+    /** @brief Construct from explicit x/y/z/w values. */
+    constexpr Quat(float x, float y, float z, float w) : Vector4<float>(x, y, z, w) {}
+
+    /** @brief Construct from a 4D vector, e.g. the result of Vector4 arithmetic. */
+    constexpr explicit Quat(const Vector4<float>& v) : Vector4<float>(v) {}
+
+    /** @brief Identity rotation. */
+    constexpr static Quat Identity()
+    {
+        return { 0.0f, 0.0f, 0.0f, 1.0f };
+    }
+
+    /**
+     * @brief Rotation around an arbitrary axis
+     *
+     * @param axis  Unit length rotation axis
+     * @param theta Rotation angle in radians
+     * @return Quat
+     */
+    static Quat AxisAngle(const Vector3<float>& axis, float theta);
+
+    /**
+     * @brief Rotation around X axis. Same rotation as Mat3::RotationX
+     *
+     * @param theta Rotation angle in radians
+     * @return Quat
+     */
+    static Quat RotationX(float theta);
+
+    /**
+     * @brief Rotation around Y axis. Same rotation as Mat3::RotationY
+     *
+     * @param theta Rotation angle in radians
+     * @return Quat
+     */
+    static Quat RotationY(float theta);
+
+    /**
+     * @brief Rotation around Z axis. Same rotation as Mat3::RotationZ
+     *
+     * @param theta Rotation angle in radians
+     * @return Quat
+     */
+    static Quat RotationZ(float theta);
+
+    /**
+     * @brief Rotation stored in a matrix
+     *
+     * @param m Orthonormal matrix without scaling
+     * @return Quat Unit quaternion with w >= 0 for the same rotation
+     */
+    static Quat FromMat3(const Mat3& m);
+
+    /**
+     * @brief Rotation stored in the upper 3x3 block of a matrix
+     *
+     * @param m Matrix whose upper 3x3 block is orthonormal
+     * @return Quat Unit quaternion with w >= 0 for the same rotation
+     */
+    static Quat FromMat4(const Mat4& m);
+
+    /**
+     * @brief Rotation matrix. The quaternion must be unit length.
+     *
+     * @return Mat3
+     */
+    Mat3 ToMat3() const;
+
+    /**
+     * @brief Rotation matrix without translation. The quaternion must be unit length.
+     *
+     * @return Mat4
+     */
+    Mat4 ToMat4() const;
+
+    /**
+     * @brief Conjugate (-x, -y, -z, w). Inverse rotation of a unit quaternion.
+     *
+     * @return Quat
+     */
+    constexpr Quat Conjugate() const
+    {
+        return { -x, -y, -z, w };
+    }
+
+    /**
+     * @brief Inverse of a quaternion of any non-zero length
+     *
+     * @return Quat Conjugate divided by the squared length
+     */
+    Quat Inverse() const
+    {
+        const float lengthSquared = LengthSquared();
+        assert(lengthSquared != 0);
+        const float inv = 1.0f / lengthSquared;
+        return { -x * inv, -y * inv, -z * inv, w * inv };
+    }
+
+    /**
+     * @brief Rotate a vector. The quaternion must be unit length.
+     *
+     * @param v Vector to rotate
+     * @return Vector3<float> Rotated vector
+     */
+    __attribute__((always_inline)) inline Vector3<float> Rotate(const Vector3<float>& v) const
+    {
+        // v' = v + w * t + q x t, with t = 2 * (q x v)
+        const float tx = 2.0f * (y * v.z - z * v.y);
+        const float ty = 2.0f * (z * v.x - x * v.z);
+        const float tz = 2.0f * (x * v.y - y * v.x);
+        return {
+            v.x + w * tx + (y * tz - z * ty),
+            v.y + w * ty + (z * tx - x * tz),
+            v.z + w * tz + (x * ty - y * tx),
+        };
+    }
+
+    /**
+     * @brief Compose two rotations
+     *
+     * @param q Rotation applied after this one
+     * @return Quat Combined rotation
+     */
+    __attribute__((always_inline)) inline Quat operator*(const Quat& q) const
+    {
+        // Hamilton product q (x) this
+        return {
+            q.w * x + q.x * w + q.y * z - q.z * y,
+            q.w * y - q.x * z + q.y * w + q.z * x,
+            q.w * z + q.x * y - q.y * x + q.z * w,
+            q.w * w - q.x * x - q.y * y - q.z * z,
+        };
+    }
+
+    /**
+     * @brief Compose two rotations
+     *
+     * @param q Rotation applied after this one
+     * @return Quat& Reference to this quaternion
+     */
+    __attribute__((always_inline)) inline Quat& operator*=(const Quat& q)
+    {
+        return *this = *this * q;
+    }
+};
+
+/** @brief Rotate a vector, same as v * q.ToMat3(). */
+__attribute__((always_inline)) inline Vector3<float> operator*(const Vector3<float>& v, const Quat& q)
+{
+    return q.Rotate(v);
+}
+
+/**
+ * @brief Normalized linear interpolation along the shortest path
+ *
+ * @param a Start rotation (unit length)
+ * @param b End rotation (unit length)
+ * @param t Interpolation factor in [0, 1]
+ * @return Quat Unit quaternion
+ */
+Quat Nlerp(const Quat& a, const Quat& b, float t);
+
+/**
+ * @brief Spherical linear interpolation along the shortest path.
+ *        Constant angular velocity. Nearly parallel inputs fall back to Nlerp.
+ *
+ * @param a Start rotation (unit length)
+ * @param b End rotation (unit length)
+ * @param t Interpolation factor in [0, 1]
+ * @return Quat Unit quaternion
+ */
+Quat Slerp(const Quat& a, const Quat& b, float t);
+
+//**********************************************************************
+//* Batch interpolation
+//**********************************************************************
+// One interpolation per element, e.g. one per animation track. The output
+// array may be the same array as a or b, but must not partially overlap.
+// Nlerp kernels give the same result as the scalar Nlerp. Slerp kernels use
+// polynomial acos/sin approximations and stay within 1e-6 of the scalar Slerp.
+
+/**
+ * @brief Nlerp(a[i], b[i], t[i]) for each element
+ */
+void NlerpBatch(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n);
+
+/**
+ * @brief Nlerp(a[i], b[i], t) for each element
+ */
+void NlerpBatch(const Quat* a, const Quat* b, float t, Quat* out, size_t n);
+
+/**
+ * @brief Slerp(a[i], b[i], t[i]) for each element
+ */
+void SlerpBatch(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n);
+
+/**
+ * @brief Slerp(a[i], b[i], t) for each element
+ */
+void SlerpBatch(const Quat* a, const Quat* b, float t, Quat* out, size_t n);
+
+#endif // QUAT_H
@@ -0,0 +1,282 @@
+/**
+ * @file: Ray.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef RAY_H
+#define RAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <limits>
+#include "Vector.h"
+#include "Bounds.h"
+
+//**********************************************************************
+//* Rays and hits
+//**********************************************************************
+/**
+ * @brief Half line origin + t * direction, limited to tMin <= t < tMax.
+ *        The direction does not need to be normalized; t is measured in
+ *        multiples of it.
+ */
+class Ray
+{
+public:
+    Ray() = default;
+
+    /** @brief Construct from origin and direction, optionally limited to [tMin, tMax). */
+    constexpr Ray(const Vec3f& origin, const Vec3f& direction, float tMin = 0.0f,
+                  float tMax = std::numeric_limits<float>::infinity()) :
+        origin(origin), tMin(tMin), direction(direction), tMax(tMax)
+    {}
+
+    /** @brief Point at parameter t. */
+    Vec3f At(float t) const { return origin + direction * t; }
+
+    /** @brief Component-wise 1 / direction, infinite for zero components. Input of the slab tests. */
+    Vec3f InverseDirection() const
+    {
+        return Vec3f(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    }
+
+    Vec3f origin;
+    float tMin;
+    Vec3f direction;
+    float tMax;
+};
+
+/**
+ * @brief Closest intersection found so far
+ */
+struct RayHit
+{
+    /** @brief Value of prim when nothing was hit. */
+    static constexpr uint32_t None = UINT32_MAX;
+
+    float t;        // Ray parameter of the hit
+    float u;        // Barycentric weight of the second vertex
+    float v;        // Barycentric weight of the third vertex
+    uint32_t prim;  // Triangle index, None if no hit
+
+    /** @brief No hit yet. */
+    static constexpr RayHit Miss()
+    {
+        return {std::numeric_limits<float>::infinity(), 0.0f, 0.0f, None};
+    }
+};
+
+//**********************************************************************
+//* Ray packets
+//**********************************************************************
+/**
+ * @brief 8 rays in structure of arrays layout, the unit of work of the
+ *        SIMD kernels (one AVX2 register or two SSE registers per field).
+ *
+ * Unused lanes are inactive: their interval is empty (tMin > tMax), so they
+ * never hit anything.
+ */
+struct alignas(32) RayPacket
+{
+    static constexpr int Size = 8;
+
+    float ox[Size], oy[Size], oz[Size];     // Origins
+    float dx[Size], dy[Size], dz[Size];     // Directions
+    float idx[Size], idy[Size], idz[Size];  // 1 / direction
+    float tMin[Size], tMax[Size];
+
+    /** @brief Store a ray in a lane. */
+    void Set(int lane, const Ray& r)
+    {
+        assert(lane >= 0 && lane < Size);
+        const Vec3f inv = r.InverseDirection();
+        ox[lane] = r.origin.x;
+        oy[lane] = r.origin.y;
+        oz[lane] = r.origin.z;
+        dx[lane] = r.direction.x;
+        dy[lane] = r.direction.y;
+        dz[lane] = r.direction.z;
+        idx[lane] = inv.x;
+        idy[lane] = inv.y;
+        idz[lane] = inv.z;
+        tMin[lane] = r.tMin;
+        tMax[lane] = r.tMax;
+    }
+
+    /** @brief Make a lane inactive. */
+    void Clear(int lane)
+    {
+        Set(lane, Ray(Vec3f(0.0f), Vec3f(1.0f), std::numeric_limits<float>::infinity(), 0.0f));
+    }
+
+    /** @brief Ray of a lane, with its current tMax. */
+    Ray Get(int lane) const
+    {
+        assert(lane >= 0 && lane < Size);
+        return Ray(Vec3f(ox[lane], oy[lane], oz[lane]), Vec3f(dx[lane], dy[lane], dz[lane]), tMin[lane], tMax[lane]);
+    }
+
+    /**
+     * @brief Fill the packet from an array of rays
+     *
+     * @param rays  Input rays
+     * @param count Number of rays, at most Size. The other lanes are cleared
+     */
+    void Load(const Ray* rays, int count)
+    {
+        assert(count >= 0 && count <= Size);
+        for (int i = 0; i < Size; i++)
+        {
+            if (i < count)
+                Set(i, rays[i]);
+            else
+                Clear(i);
+        }
+    }
+};
+
+/**
+ * @brief Closest hits of a packet, same fields as RayHit
+ */
+struct alignas(32) RayPacketHit
+{
+    float t[RayPacket::Size];
+    float u[RayPacket::Size];
+    float v[RayPacket::Size];
+    uint32_t prim[RayPacket::Size];
+
+    /** @brief No hit in any lane. */
+    void Reset()
+    {
+        for (int i = 0; i < RayPacket::Size; i++)
+        {
+            const RayHit m = RayHit::Miss();
+            t[i] = m.t;
+            u[i] = m.u;
+            v[i] = m.v;
+            prim[i] = m.prim;
+        }
+    }
+
+    /** @brief Hit of a lane. */
+    RayHit Get(int lane) const
+    {
+        return {t[lane], u[lane], v[lane], prim[lane]};
+    }
+};
+
+//**********************************************************************
+//* Scalar reference
+//**********************************************************************
+// Defined in Ray.cpp, which is built without FP contraction like the SIMD
+// kernels there. They do exactly the same float operations (no FMA), so
+// every backend finds the same hits with the same t, u and v.
+
+/**
+ * @brief Möller-Trumbore ray-triangle test, two sided
+ *
+ * @param ray Ray. A hit must satisfy ray.tMin <= t < ray.tMax
+ * @param a   First vertex
+ * @param b   Second vertex
+ * @param c   Third vertex
+ * @param t   Output ray parameter of the hit
+ * @param u   Output weight of b
+ * @param v   Output weight of c
+ * @return true The ray hits the triangle. Degenerate triangles and rays in
+ *         the triangle plane never hit
+ */
+bool IntersectTriangle(const Ray& ray, const Vec3f& a, const Vec3f& b, const Vec3f& c,
+                       float& t, float& u, float& v);
+
+/**
+ * @brief Slab test of a ray against a box
+ *
+ * NaNs from 0 * inf (origin on a slab plane, direction parallel to it) are
+ * dropped by the min/max order, so such rays count as inside that slab.
+ *
+ * @param ray    Ray
+ * @param invDir ray.InverseDirection()
+ * @param box    Box
+ * @param tNear  Output entry parameter, clamped to ray.tMin
+ * @return true The ray overlaps the box within [tMin, tMax]
+ */
+bool IntersectAABB(const Ray& ray, const Vec3f& invDir, const AABB3& box, float& tNear);
+
+//**********************************************************************
+//* SIMD kernels
+//**********************************************************************
+// AVX2 tests all 8 lanes of a packet at once, SSE4.1 runs two halves of 4
+// and the scalar backend calls the reference above once per lane.
+
+/**
+ * @brief Slab test of every packet ray against one box
+ *
+ * @param rays  Ray packet
+ * @param box   Box
+ * @param tNear Output entry parameter per lane, may be nullptr
+ * @return uint32_t Bit i set if lane i overlaps the box
+ */
+uint32_t IntersectAABB(const RayPacket& rays, const AABB3& box, float* tNear);
+
+/**
+ * @brief Closest hit of every packet ray against a range of indexed triangles
+ *
+ * On a hit closer than rays.tMax, the lane's hit is replaced and its tMax
+ * shrinks to the hit distance, so later calls only report closer hits.
+ * On equal distances the earlier triangle is kept.
+ *
+ * @param rays     Ray packet, tMax updated
+ * @param vertices Vertex positions
+ * @param indices  Vertex indices, three per triangle
+ * @param first    First triangle
+ * @param last     One past the last triangle
+ * @param hit      Closest hits, updated. prim is the triangle index
+ */
+void IntersectTriangles(RayPacket& rays, const Vec3f* vertices, const uint32_t* indices,
+                        size_t first, size_t last, RayPacketHit& hit);
+
+/**
+ * @brief Closest hit of one ray against a range of indexed triangles
+ *        (scalar, same rules as the packet version)
+ *
+ * @return true If a closer hit was found
+ */
+bool IntersectTriangles(Ray& ray, const Vec3f* vertices, const uint32_t* indices,
+                        size_t first, size_t last, RayHit& hit);
+
+/**
+ * @brief Closest hit of an array of rays against every triangle of a mesh.
+ *        Brute force in packets of 8 rays, meant for small meshes;
+ *        larger ones should use a Bvh.
+ *
+ * @param rays     Input rays
+ * @param hits     Output hits, prim is RayHit::None for misses
+ * @param n        Number of rays
+ * @param vertices Vertex positions
+ * @param indices  Vertex indices, three per triangle
+ * @param triCount Number of triangles
+ */
+void IntersectRays(const Ray* rays, RayHit* hits, size_t n,
+                   const Vec3f* vertices, const uint32_t* indices, size_t triCount);
+
+#endif // RAY_H
@@ -0,0 +1,96 @@
+/**
+ * @file: Simd.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdint.h>
+
+// Host SIMD kernels are only built for x86 targets. ESP32-S3 builds keep using
+// the hand written assembly in mat_mult.S and every other target falls back to
+// plain C++. Define VECTOR_NO_SIMD to force the scalar code paths.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && defined(__GNUC__) && !defined(VECTOR_NO_SIMD)
+    #define VECTOR_X86_SIMD 1
+    #include <immintrin.h>
+
+    // Per-function target attributes allow building kernels for several
+    // instruction sets in the same binary. The right one is picked at runtime.
+    #define VECTOR_TARGET_SSE41     __attribute__((target("sse4.1")))
+    #define VECTOR_TARGET_AVX2      __attribute__((target("avx2,fma,f16c")))
+    #define VECTOR_TARGET_AVX512    __attribute__((target("avx512f,avx2,fma,f16c")))
+#endif
+
+// Several kernels give the same bits as inline header code (a scalar method,
+// an operator). That header code is compiled with the flags of the including
+// file, so the guarantee needs that file to be built without floating point
+// contraction too, or a * b + c may become an FMA there. The Vector CMake
+// target and the ESP-IDF component only build the library itself with
+// -ffp-contract=off; code that relies on same bits must pass it too.
+// Without it they can differ in the last bits.
+
+/**
+ * @brief Instruction set levels the library has kernels for.
+ *        Each level implies all the previous ones. AVX2 also implies FMA and
+ *        F16C (half precision conversions).
+ */
+enum class SimdLevel : uint8_t
+{
+    Scalar = 0,
+    SSE41,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @brief Best SIMD level supported by the CPU running the program
+ *
+ * @return SimdLevel Detected level. Always Scalar on non-x86 targets.
+ */
+SimdLevel SimdHostLevel();
+
+/**
+ * @brief SIMD level currently used by the dispatched kernels
+ *
+ * @return SimdLevel Active level. Defaults to SimdHostLevel()
+ */
+SimdLevel SimdActiveLevel();
+
+/**
+ * @brief Select the SIMD level used by the dispatched kernels.
+ *        Useful to benchmark or validate each backend on the same machine.
+ *
+ * @param level Requested level. Clamped to SimdHostLevel()
+ * @return SimdLevel Level actually applied
+ */
+SimdLevel SimdSetLevel(SimdLevel level);
+
+/**
+ * @brief Human readable name of a SIMD level
+ *
+ * @param level SIMD level
+ * @return const char* Name of the level
+ */
+const char* SimdLevelName(SimdLevel level);
+
+#endif // SIMD_H
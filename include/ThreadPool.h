@@ -0,0 +1,139 @@
+/**
+ * @file: ThreadPool.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//**********************************************************************
+//* Fork-join pool for data parallel loops
+//**********************************************************************
+/**
+ * @brief Fixed set of worker threads that run ParallelFor() loops.
+ *
+ * The index range is cut into chunks of the requested size and every thread,
+ * the caller included, starts with its own contiguous run of chunks. A thread
+ * takes chunks from the front of its run and, once it is empty, steals from
+ * the back of the other runs, so uneven chunks still keep every thread busy.
+ *
+ * Chunk boundaries only depend on n and the chunk size, never on the number
+ * of threads or on which thread runs a chunk. ParallelFor() returns once every
+ * chunk is done.
+ *
+ * Workers are created once and sleep between loops. Loops submitted from
+ * several threads run one after the other. A ParallelFor() issued from inside
+ * a loop body runs serially on the calling worker.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Start the worker threads
+     *
+     * @param threads Number of threads including the caller of ParallelFor(),
+     *                0 to use one per core. 1 runs every loop serially.
+     */
+    explicit ThreadPool(unsigned threads = 0);
+
+    /** @brief Wait for the running loop, if any, and stop the workers. */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** @brief Number of threads taking part in a loop, including the caller. */
+    unsigned Size() const { return threads; }
+
+    /**
+     * @brief Run body over [0, n) split into chunks
+     *
+     * @param n     Number of indices
+     * @param chunk Indices per chunk (the last one may be shorter). 0 is taken as 1
+     * @param body  Called as body(begin, end) once per chunk, from any thread.
+     *              Must not throw.
+     */
+    template <class F>
+    void ParallelFor(size_t n, size_t chunk, F&& body)
+    {
+        typedef typename std::remove_reference<F>::type Body;
+        run(n, chunk, [](void* ctx, size_t begin, size_t end) {
+            (*static_cast<Body*>(ctx))(begin, end);
+        }, const_cast<void*>(static_cast<const void*>(&body)));
+    }
+
+    /** @brief Shared pool with one thread per core, created on first use. */
+    static ThreadPool& Default();
+
+    /**
+     * @brief Per-core data cache size used to size batch chunks
+     *
+     * @return size_t L2 size in bytes reported by the OS, or 256 KiB if unknown
+     */
+    static size_t CacheSize();
+
+private:
+    typedef void (*Task)(void* ctx, size_t begin, size_t end);
+
+    // Chunks still owned by one thread, packed as begin | end << 32 so the
+    // owner (front) and thieves (back) can both claim with one CAS
+    struct alignas(64) Run
+    {
+        std::atomic<uint64_t> chunks;
+    };
+
+    void run(size_t n, size_t chunk, Task task, void* ctx);
+    void work(unsigned self);
+    void workerLoop(unsigned self);
+
+    unsigned threads;
+    std::vector<std::thread> workers;
+    std::unique_ptr<Run[]> runs;
+
+    std::mutex submit;              // Serializes ParallelFor() callers
+    std::mutex lock;                // Guards the fields below
+    std::condition_variable wake;   // Signals a new loop or stop to the workers
+    std::condition_variable done;   // Signals the caller that the workers finished
+    uint64_t generation = 0;        // Incremented for every loop
+    unsigned active = 0;            // Workers still inside the current loop
+    bool stop = false;
+
+    // Current loop, written before the workers are woken
+    Task task = nullptr;
+    void* ctx = nullptr;
+    size_t count = 0;               // Number of indices
+    size_t chunk = 0;               // Indices per chunk
+    unsigned participants = 0;      // Threads with a run in this loop
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,166 @@
+/**
+ * @file: Transform.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include "Vector.h"
+#include "Mat4.h"
+#include "Quat.h"
+
+/**
+ * @brief Translation, rotation and scale of an object.
+ *
+ * The matrix is Mat4::Scaling(scale) * rotation.ToMat4() * Mat4::Translation(translation),
+ * i.e. points are scaled first, then rotated and then translated. It is
+ * written directly from the components, without intermediate products, and
+ * cached until one of the components changes.
+ *
+ * The cache is filled lazily by GetMatrix(), which is const but writes it.
+ * Like the setters, the first GetMatrix() after a change must not run
+ * concurrently with any other access to the same Transform.
+ */
+class Transform
+{
+public:
+    /** @brief Identity transform. */
+    Transform() :
+        translation(0.0f), rotation(Quat::Identity()), scale(1.0f), dirty(true)
+    {}
+
+    /**
+     * @brief Construct from components
+     *
+     * @param translation Translation
+     * @param rotation    Rotation. Must be unit length
+     * @param scale       Scale factor along each axis
+     */
+    Transform(const Vec3f& translation, const Quat& rotation, const Vec3f& scale = Vec3f(1.0f)) :
+        translation(translation), rotation(rotation), scale(scale), dirty(true)
+    {}
+
+    //******************************************************************
+    //* Components
+    //******************************************************************
+    const Vec3f& GetTranslation() const { return translation; }
+    const Quat& GetRotation() const { return rotation; }
+    const Vec3f& GetScale() const { return scale; }
+
+    void SetTranslation(const Vec3f& t)
+    {
+        translation = t;
+        dirty = true;
+    }
+
+    /** @brief Set the rotation. Must be unit length. */
+    void SetRotation(const Quat& r)
+    {
+        rotation = r;
+        dirty = true;
+    }
+
+    void SetScale(const Vec3f& s)
+    {
+        scale = s;
+        dirty = true;
+    }
+
+    void SetScale(float s)
+    {
+        SetScale(Vec3f(s));
+    }
+
+    /** @brief Move by an offset. */
+    void Translate(const Vec3f& offset)
+    {
+        translation += offset;
+        dirty = true;
+    }
+
+    /** @brief Rotate by r after the current rotation. Renormalizes the result. */
+    void Rotate(const Quat& r)
+    {
+        rotation *= r;
+        rotation.Normalize();
+        dirty = true;
+    }
+
+    //******************************************************************
+    //* Matrix
+    //******************************************************************
+    /**
+     * @brief True if a component changed since the matrix was last built
+     */
+    bool IsDirty() const { return dirty; }
+
+    /**
+     * @brief Transformation matrix. Rebuilt only if a component changed.
+     *
+     * Not thread safe while IsDirty(): the rebuild writes the cache without
+     * synchronisation. Call it once from a single thread before sharing the
+     * Transform with other threads (e.g. ThreadPool jobs); after that,
+     * concurrent calls only read. Use ToMat4() to get the matrix without
+     * touching the cache.
+     *
+     * @return const Mat4& Cached matrix, valid until the next change
+     */
+    const Mat4& GetMatrix() const
+    {
+        if (dirty)
+        {
+            matrix = ToMat4();
+            dirty = false;
+        }
+        return matrix;
+    }
+
+    /**
+     * @brief Build the transformation matrix, ignoring the cache
+     *
+     * @return Mat4 Transformation matrix
+     */
+    Mat4 ToMat4() const;
+
+    /**
+     * @brief Split a matrix into translation, rotation and scale.
+     *
+     * The matrix must be affine (last column 0, 0, 0, 1) without shear. Scale
+     * factors are the lengths of the first three rows. A mirroring matrix
+     * (negative determinant) gets a negative X scale. Rows must not be zero.
+     *
+     * @param m Matrix to decompose
+     * @return Transform Transform whose ToMat4() reproduces m
+     */
+    static Transform Decompose(const Mat4& m);
+
+private:
+    Vec3f translation;
+    Quat rotation;
+    Vec3f scale;
+
+    mutable Mat4 matrix;
+    mutable bool dirty;
+};
+
+#endif // TRANSFORM_H
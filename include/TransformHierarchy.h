@@ -0,0 +1,165 @@
+/**
+ * @file: TransformHierarchy.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRANSFORM_HIERARCHY_H
+#define TRANSFORM_HIERARCHY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+#include <vector>
+#include "Mat4.h"
+#include "ThreadPool.h"
+
+//**********************************************************************
+//* Flattened parent-child transform tree
+//**********************************************************************
+/**
+ * @brief Tree of local transforms with cached world matrices.
+ *
+ * world(node) = local(node) * world(parent), roots use their local matrix.
+ *
+ * Nodes are kept in flat arrays in depth first order, so every subtree is a
+ * contiguous range that starts with its root and each parent comes before its
+ * children. Update() recomputes only the subtrees below changed nodes, each
+ * one a linear walk over the arrays. The overload taking a ThreadPool
+ * spreads independent subtrees over the pool threads when enough nodes
+ * changed.
+ *
+ * Node handles returned by Add() stay valid for the lifetime of the
+ * container. Adding nodes only appends them; the arrays are put back in depth
+ * first order at the start of the next Update().
+ */
+class TransformHierarchy
+{
+public:
+    typedef uint32_t Node;
+
+    /** @brief Parent of root nodes. */
+    static constexpr Node None = UINT32_MAX;
+
+    /** @brief Minimum number of changed nodes before Update(pool) uses more than one thread. */
+    static constexpr size_t ParallelThreshold = 4096;
+
+    TransformHierarchy() = default;
+
+    /** @brief Allocate room for n nodes. */
+    void Reserve(size_t n);
+
+    /** @brief Remove all nodes. Previous handles become invalid. */
+    void Clear();
+
+    /** @brief Number of nodes. */
+    size_t Size() const { return parent.size(); }
+
+    /**
+     * @brief Add a node
+     *
+     * @param local  Transform relative to the parent
+     * @param parent Parent node, or None for a root
+     * @return Node Handle of the new node
+     */
+    Node Add(const Mat4& local, Node parent = None);
+
+    /** @brief Parent of a node, None for roots. */
+    Node GetParent(Node node) const
+    {
+        const uint32_t p = parent[slotOf(node)];
+        return p == None ? None : handle[p];
+    }
+
+    /** @brief Transform relative to the parent. */
+    const Mat4& GetLocal(Node node) const
+    {
+        return local[slotOf(node)];
+    }
+
+    /** @brief Replace the local transform. The subtree is recomputed on the next Update(). */
+    void SetLocal(Node node, const Mat4& m)
+    {
+        const uint32_t i = slotOf(node);
+        local[i] = m;
+        markDirty(node, i);
+    }
+
+    /**
+     * @brief World transform computed by the last Update()
+     *
+     * @param node Node handle
+     * @return const Mat4& Stale if the node or an ancestor changed since then
+     */
+    const Mat4& GetWorld(Node node) const
+    {
+        return world[slotOf(node)];
+    }
+
+    /** @brief Recompute the world matrix of every changed node and its descendants. */
+    void Update();
+    void Update(ThreadPool& pool);
+
+private:
+    struct Range
+    {
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    uint32_t slotOf(Node node) const
+    {
+        assert(node < slot.size() && "TransformHierarchy: invalid node");
+        return slot[node];
+    }
+
+    void markDirty(Node node, uint32_t i)
+    {
+        if (!dirty[i])
+        {
+            dirty[i] = 1;
+            changed.push_back(node);
+        }
+    }
+
+    void relayout();
+    void updateRange(uint32_t begin, uint32_t end);
+    void update(ThreadPool* pool);
+
+    // Per slot, in depth first order once laid out
+    std::vector<uint32_t> parent;   // Slot of the parent, None for roots
+    std::vector<uint32_t> extent;   // Number of nodes in the subtree, including itself
+    std::vector<uint32_t> handle;   // Node handle stored in this slot
+    std::vector<Mat4> local;
+    std::vector<Mat4> world;
+    std::vector<uint8_t> dirty;
+
+    // Per node handle
+    std::vector<uint32_t> slot;
+
+    std::vector<Node> changed;      // Nodes marked dirty since the last Update()
+    std::vector<uint32_t> roots;    // Update() scratch
+    std::vector<Range> work;        // Update() scratch
+    std::vector<uint32_t> batches;  // Update() scratch, first range of each pool chunk
+    bool ordered = true;            // False after Add() until the next relayout
+};
+
+#endif // TRANSFORM_HIERARCHY_H
@@ -0,0 +1,353 @@
+/**
+ * @file: Vec3A.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef VEC3A_H
+#define VEC3A_H
+
+#include <type_traits>
+#include "Vector.h"
+#include "Simd.h"
+
+//**********************************************************************
+//* 16 byte aligned 3D vector
+//**********************************************************************
+// Vec3A is a Vector3<float> padded to 16 bytes, so on x86 every operation is
+// a single aligned load, one or two SSE instructions and a single store.
+// The kernels only use baseline SSE and do the float operations in the same
+// order as Vector3<float>, so the results are identical as long as the
+// including code is built without FP contraction (see Simd.h).
+//
+// Vec3A derives from Vector3<float>: it can be passed to anything taking a
+// Vec3f reference, and mixed Vec3A/Vec3f expressions use the Vec3f code.
+// Converting a Vec3f to a Vec3A is explicit. Arrays of Vec3A take 16 bytes per
+// element instead of 12, so use them for hot working sets, not for storage.
+
+/**
+ * @brief 3D float vector with 16 byte size and alignment.
+ */
+class alignas(16) Vec3A : public Vector3<float>
+{
+public:
+    //******************************************************************
+    //* Constructors
+    //******************************************************************
+    /** @brief Default constructor. Components are left uninitialized. */
+    Vec3A() = default;
+
+    /** @brief Construct from explicit x/y/z values. */
+    constexpr Vec3A(float x, float y, float z) : Vector3<float>(x, y, z), pad(0.0f) {}
+
+    /** @brief Construct with all components set to the same scalar. */
+    constexpr explicit Vec3A(float s) : Vector3<float>(s), pad(0.0f) {}
+
+    /** @brief Convert from a packed vector. */
+    template <class U>
+    constexpr explicit Vec3A(const Vector3<U>& v) : Vector3<float>(v), pad(0.0f) {}
+
+#ifdef VECTOR_X86_SIMD
+    /** @brief Build from the x/y/z/pad lanes of an SSE register. */
+    static Vec3A FromSse(__m128 v)
+    {
+        Vec3A r;
+        _mm_store_ps(&r.x, v);
+        return r;
+    }
+
+    /** @brief The x/y/z/pad lanes as an SSE register. */
+    __m128 ToSse() const
+    {
+        return _mm_load_ps(&x);
+    }
+#endif
+    //******************************************************************
+
+    //******************************************************************
+    //* Operators
+    //******************************************************************
+    template <class U>
+    /** @brief Assign from a packed vector. The padding is kept. */
+    Vec3A& operator=(const Vector3<U>& v)
+    {
+        x = v.x;
+        y = v.y;
+        z = v.z;
+        return *this;
+    }
+
+    /** @brief Component-wise addition assignment. */
+    Vec3A& operator+=(const Vec3A& v);
+
+    /** @brief Component-wise subtraction assignment. */
+    Vec3A& operator-=(const Vec3A& v);
+
+    /** @brief Scalar multiplication assignment. */
+    Vec3A& operator*=(float scalar);
+
+    /** @brief Scalar division assignment. */
+    Vec3A& operator/=(float scalar);
+
+    /** @brief Unary minus in-place. */
+    Vec3A& operator-();
+    //******************************************************************
+
+    //******************************************************************
+    //* Methods
+    //******************************************************************
+    /** @brief Squared Euclidean length. */
+    float LengthSquared() const;
+
+    /** @brief Euclidean length. See Precision for the accuracy of each tier. */
+    template <Precision P = Precision::Exact>
+    float Length() const
+    {
+        return Sqrt<P>(LengthSquared());
+    }
+
+    /** @brief Normalize vector in place. See Precision for the accuracy of each tier. */
+    template <Precision P = Precision::Exact>
+    void Normalize()
+    {
+        const float lengthSquared = LengthSquared();
+        assert(lengthSquared != 0);
+        *this *= InvSqrt<P>(lengthSquared);
+    }
+
+    /** @brief True if vector length is approximately one. */
+    bool IsNormalized() const
+    {
+        const float epsilon = 1e-5f;
+        return std::fabs(Length() - 1.0f) <= epsilon;
+    }
+    //******************************************************************
+
+    // Padding up to 16 bytes. Not part of the value: the constructors set it
+    // to 0 and the operators never read it into x/y/z.
+    float pad;
+};
+
+static_assert(sizeof(Vec3A) == 16, "Vec3A must be 16 bytes");
+
+#ifdef VECTOR_X86_SIMD
+/**
+ * @brief Sum of the x/y/z lanes, added in the same order as the scalar code
+ */
+__attribute__((always_inline)) inline float sum3_sse(__m128 v)
+{
+    const __m128 xy = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(_mm_add_ss(xy, _mm_movehl_ps(v, v)));
+}
+
+/**
+ * @brief Cross product of the x/y/z lanes
+ */
+__attribute__((always_inline)) inline __m128 cross3_sse(__m128 a, __m128 b)
+{
+    const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 aZXY = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+    const __m128 bZXY = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+    return _mm_sub_ps(_mm_mul_ps(aYZX, bZXY), _mm_mul_ps(aZXY, bYZX));
+}
+#endif
+
+//**********************************************************************
+//* Vec3A
+//**********************************************************************
+// Non-template overloads, preferred over the Vector3<T> templates for Vec3A
+// arguments. Scalars are converted to float.
+
+/** @brief Component-wise vector addition. */
+inline Vec3A operator+(const Vec3A& v, const Vec3A& u)
+{
+#ifdef VECTOR_X86_SIMD
+    return Vec3A::FromSse(_mm_add_ps(v.ToSse(), u.ToSse()));
+#else
+    return Vec3A(v.x+u.x, v.y+u.y, v.z+u.z);
+#endif
+}
+
+/** @brief Component-wise vector subtraction. */
+inline Vec3A operator-(const Vec3A& v, const Vec3A& u)
+{
+#ifdef VECTOR_X86_SIMD
+    return Vec3A::FromSse(_mm_sub_ps(v.ToSse(), u.ToSse()));
+#else
+    return Vec3A(v.x-u.x, v.y-u.y, v.z-u.z);
+#endif
+}
+
+template <class U, class = typename std::enable_if<std::is_arithmetic<U>::value>::type>
+/** @brief Vector multiplied by scalar. */
+inline Vec3A operator*(const Vec3A& v, const U scalar)
+{
+    const float s = static_cast<float>(scalar);
+#ifdef VECTOR_X86_SIMD
+    return Vec3A::FromSse(_mm_mul_ps(v.ToSse(), _mm_set1_ps(s)));
+#else
+    return Vec3A(v.x*s, v.y*s, v.z*s);
+#endif
+}
+
+template <class U, class = typename std::enable_if<std::is_arithmetic<U>::value>::type>
+/** @brief Scalar multiplied by vector. */
+inline Vec3A operator*(const U scalar, const Vec3A& v)
+{
+    return v * scalar;
+}
+
+template <class U, class = typename std::enable_if<std::is_arithmetic<U>::value>::type>
+/** @brief Vector divided by scalar. */
+inline Vec3A operator/(const Vec3A& v, const U scalar)
+{
+    assert(scalar != 0);
+    const float s = static_cast<float>(scalar);
+#ifdef VECTOR_X86_SIMD
+    return Vec3A::FromSse(_mm_div_ps(v.ToSse(), _mm_set1_ps(s)));
+#else
+    return Vec3A(v.x/s, v.y/s, v.z/s);
+#endif
+}
+
+/** @brief Dot product. */
+inline float operator*(const Vec3A& v, const Vec3A& u)
+{
+#ifdef VECTOR_X86_SIMD
+    return sum3_sse(_mm_mul_ps(v.ToSse(), u.ToSse()));
+#else
+    return v.x*u.x + v.y*u.y + v.z*u.z;
+#endif
+}
+
+/** @brief 3D cross product. */
+inline Vec3A CrossProduct(const Vec3A& v, const Vec3A& u)
+{
+#ifdef VECTOR_X86_SIMD
+    return Vec3A::FromSse(cross3_sse(v.ToSse(), u.ToSse()));
+#else
+    return Vec3A(v.y*u.z - v.z*u.y,
+                 v.z*u.x - v.x*u.z,
+                 v.x*u.y - v.y*u.x);
+#endif
+}
+
+/** @brief Linear interpolation from v to u. */
+inline Vec3A Lerp(const Vec3A& v, const Vec3A& u, const float t)
+{
+    return v + (u - v) * t;
+}
+
+/** @brief Clamp each component to [min, max]. */
+inline Vec3A Clamp(const Vec3A& v, const float min, const float max)
+{
+#ifdef VECTOR_X86_SIMD
+    const __m128 a = v.ToSse();
+    const __m128 lo = _mm_set1_ps(min);
+    const __m128 upper = _mm_min_ps(_mm_set1_ps(max), a);
+    const __m128 below = _mm_cmplt_ps(a, lo);
+    return Vec3A::FromSse(_mm_or_ps(_mm_and_ps(below, lo), _mm_andnot_ps(below, upper)));
+#else
+    return Vec3A(v.x < min ? min : (v.x > max ? max : v.x),
+                 v.y < min ? min : (v.y > max ? max : v.y),
+                 v.z < min ? min : (v.z > max ? max : v.z));
+#endif
+}
+
+/** @brief Component-wise minimum. */
+inline Vec3A min(const Vec3A& v, const Vec3A& u)
+{
+#ifdef VECTOR_X86_SIMD
+    return Vec3A::FromSse(_mm_min_ps(v.ToSse(), u.ToSse()));
+#else
+    return Vec3A(v.x < u.x ? v.x : u.x,
+                 v.y < u.y ? v.y : u.y,
+                 v.z < u.z ? v.z : u.z);
+#endif
+}
+
+/** @brief Component-wise maximum. */
+inline Vec3A max(const Vec3A& v, const Vec3A& u)
+{
+#ifdef VECTOR_X86_SIMD
+    return Vec3A::FromSse(_mm_max_ps(v.ToSse(), u.ToSse()));
+#else
+    return Vec3A(v.x > u.x ? v.x : u.x,
+                 v.y > u.y ? v.y : u.y,
+                 v.z > u.z ? v.z : u.z);
+#endif
+}
+
+template <Precision P = Precision::Exact>
+/** @brief Euclidean distance between two vectors. */
+inline float DistanceBetween(const Vec3A& v, const Vec3A& u)
+{
+    return (v - u).template Length<P>();
+}
+
+/** @brief Squared Euclidean distance between two vectors. */
+inline float DistanceBetweenSquared(const Vec3A& v, const Vec3A& u)
+{
+    return (v - u).LengthSquared();
+}
+
+//**********************************************************************
+//* Vec3A members
+//**********************************************************************
+inline Vec3A& Vec3A::operator+=(const Vec3A& v)
+{
+    return *this = *this + v;
+}
+
+inline Vec3A& Vec3A::operator-=(const Vec3A& v)
+{
+    return *this = *this - v;
+}
+
+inline Vec3A& Vec3A::operator*=(float scalar)
+{
+    return *this = *this * scalar;
+}
+
+inline Vec3A& Vec3A::operator/=(float scalar)
+{
+    return *this = *this / scalar;
+}
+
+inline Vec3A& Vec3A::operator-()
+{
+#ifdef VECTOR_X86_SIMD
+    return *this = FromSse(_mm_xor_ps(ToSse(), _mm_set1_ps(-0.0f)));
+#else
+    x = -x;
+    y = -y;
+    z = -z;
+    return *this;
+#endif
+}
+
+inline float Vec3A::LengthSquared() const
+{
+    return *this * *this;
+}
+
+#endif // VEC3A_H
@@ -3,7 +3,7 @@
  * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
  * Created Date: 2021-11-13
  * -----
- * Last Modified: 22-10-2025
+ * Last Modified: 17-10-2026
  * Modified By: Ricard Bitriá Ribes
  * -----
  * @copyright (c) 2021 Ricard Bitriá Ribes
@@ -28,6 +28,7 @@
 #include <cmath>
 #include <cassert>
 #include <cstddef>
+#include "FastMath.h"
 
 //**********************************************************************
 //* 2 dimensional vector (X,Y)
@@ -145,22 +146,24 @@ public:
                static_cast<float>(y) * static_cast<float>(y);
     }
 
-    /** @brief Euclidean length. */
+    /** @brief Euclidean length. See Precision for the accuracy of each tier. */
+    template <Precision P = Precision::Exact>
     float Length() const
     {
-        return std::sqrt(LengthSquared());
+        return Sqrt<P>(LengthSquared());
     }
 
-    /** @brief Normalize vector in place. */
+    /** @brief Normalize vector in place. See Precision for the accuracy of each tier. */
+    template <Precision P = Precision::Exact>
     void Normalize()
     {
-        float len = Length();
-        assert(len != 0);
+        const float lengthSquared = LengthSquared();
+        assert(lengthSquared != 0);
 
-        len = 1.0f / len;
+        const float invLength = InvSqrt<P>(lengthSquared);
 
-        x *= len;
-        y *= len;
+        x *= invLength;
+        y *= invLength;
     }
 
     /** @brief True if vector length is approximately one. */
@@ -284,6 +287,14 @@ inline float DistanceBetween(const Vector2<T> &v, const Vector2<T> &u)
     return distance.Length();
 }
 
+template <Precision P, class T>
+/** @brief Euclidean distance between two vectors with the accuracy tier P. */
+inline float DistanceBetween(const Vector2<T> &v, const Vector2<T> &u)
+{
+    Vector2<T> distance = v - u;
+    return distance.template Length<P>();
+}
+
 template <class T>
 /** @brief Squared Euclidean distance between two vectors. */
 inline float DistanceBetweenSquared (const Vector2<T> &v, const Vector2<T> &u)
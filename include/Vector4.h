@@ -3,7 +3,7 @@
  * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
  * Created Date: 2021-11-14
  * -----
- * Last Modified: 22-10-2025
+ * Last Modified: 17-10-2026
  * Modified By: Ricard Bitriá Ribes
  * -----
  * @copyright (c) 2021 Ricard Bitriá Ribes
@@ -164,24 +164,26 @@ public:
         return x*x + y*y + z*z + w*w;
     }
 
-    /** @brief Euclidean length. */
+    /** @brief Euclidean length. See Precision for the accuracy of each tier. */
+    template <Precision P = Precision::Exact>
     float Length() const
     {
-        return std::sqrt(LengthSquared());
+        return Sqrt<P>(LengthSquared());
     }
     
-    /** @brief Normalize vector in place. */
+    /** @brief Normalize vector in place. See Precision for the accuracy of each tier. */
+    template <Precision P = Precision::Exact>
     void Normalize()
     {
-        float magnitude = Length();
-        assert(magnitude != 0);
+        const float lengthSquared = LengthSquared();
+        assert(lengthSquared != 0);
 
-        magnitude = 1.0f / magnitude;
+        const float invLength = InvSqrt<P>(lengthSquared);
 
-        x *= magnitude;
-        y *= magnitude;
-        z *= magnitude;
-        w *= magnitude;
+        x *= invLength;
+        y *= invLength;
+        z *= invLength;
+        w *= invLength;
     }
 
     /** @brief True if vector length is approximately one. */
@@ -320,6 +322,14 @@ inline float DistanceBetween(const Vector4<T> &v, const Vector4<T> &u)
     return distance.Length();
 }
 
+template <Precision P, class T>
+/** @brief Euclidean distance between two vectors with the accuracy tier P. */
+inline float DistanceBetween(const Vector4<T> &v, const Vector4<T> &u)
+{
+    Vector4<T> distance = v - u;
+    return distance.template Length<P>();
+}
+
 template <class T>
 /** @brief Squared Euclidean distance between two vectors. */
 inline float DistanceBetweenSquared (const Vector4<T> &v, const Vector4<T> &u)
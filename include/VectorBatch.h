@@ -0,0 +1,144 @@
+/**
+ * @file: VectorBatch.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef VECTOR_BATCH_H
+#define VECTOR_BATCH_H
+
+#include <stddef.h>
+#include "Vector.h"
+#include "FastMath.h"
+#include "Simd.h"
+
+// Array versions of the per-vector methods, backed by SSE4.1/AVX2 kernels.
+// Input and output arrays may be the same array, but must not partially overlap.
+
+/**
+ * @brief Normalize an array of vectors. Same result as calling
+ *        Normalize<P>() on each element. Zero length vectors are not allowed.
+ *        With Precision::Exact the result is bit-identical to the scalar method,
+ *        provided the caller is built without FP contraction (see Simd.h).
+ *
+ * @tparam P  Accuracy tier
+ * @param in  Input vectors
+ * @param out Output unit vectors
+ * @param n   Number of vectors
+ */
+template<Precision P = Precision::Exact>
+void NormalizeBatch(const Vec3f* in, Vec3f* out, size_t n);
+
+/**
+ * @brief Length of an array of vectors. Same result as calling
+ *        Length<P>() on each element, bit-identical with Precision::Exact
+ *        under the same condition as NormalizeBatch().
+ *
+ * @tparam P  Accuracy tier
+ * @param in  Input vectors
+ * @param out Output lengths
+ * @param n   Number of vectors
+ */
+template<Precision P = Precision::Exact>
+void LengthBatch(const Vec3f* in, float* out, size_t n);
+
+//**********************************************************************
+//* int16 vector arrays
+//**********************************************************************
+// Kernels for Vec2h/Vec3h/Vec4h arrays that work on 8 (SSE4.1) or 16 (AVX2)
+// components per instruction. Component wise operations do not care where
+// one vector ends and the next starts, so all three types share the same
+// code and run at memory speed.
+
+/**
+ * @brief What integer batch arithmetic does with results out of the int16 range.
+ *
+ *  - Wrap:     keep the low 16 bits, like the scalar Vector operators.
+ *  - Saturate: clamp to [INT16_MIN, INT16_MAX].
+ */
+enum class Overflow : uint8_t
+{
+    Wrap,
+    Saturate
+};
+
+/**
+ * @brief Component wise addition. out[i] = a[i] + b[i]
+ *
+ * @tparam O  Overflow behaviour
+ * @param a   First operands
+ * @param b   Second operands
+ * @param out Output vectors
+ * @param n   Number of vectors
+ */
+template<Overflow O = Overflow::Wrap>
+void AddBatch(const Vec2h* a, const Vec2h* b, Vec2h* out, size_t n);
+template<Overflow O = Overflow::Wrap>
+void AddBatch(const Vec3h* a, const Vec3h* b, Vec3h* out, size_t n);
+template<Overflow O = Overflow::Wrap>
+void AddBatch(const Vec4h* a, const Vec4h* b, Vec4h* out, size_t n);
+
+/** @brief Component wise subtraction. out[i] = a[i] - b[i] */
+template<Overflow O = Overflow::Wrap>
+void SubBatch(const Vec2h* a, const Vec2h* b, Vec2h* out, size_t n);
+template<Overflow O = Overflow::Wrap>
+void SubBatch(const Vec3h* a, const Vec3h* b, Vec3h* out, size_t n);
+template<Overflow O = Overflow::Wrap>
+void SubBatch(const Vec4h* a, const Vec4h* b, Vec4h* out, size_t n);
+
+/** @brief Multiply by an integer scalar. out[i] = in[i] * s */
+template<Overflow O = Overflow::Wrap>
+void ScaleBatch(const Vec2h* in, int16_t s, Vec2h* out, size_t n);
+template<Overflow O = Overflow::Wrap>
+void ScaleBatch(const Vec3h* in, int16_t s, Vec3h* out, size_t n);
+template<Overflow O = Overflow::Wrap>
+void ScaleBatch(const Vec4h* in, int16_t s, Vec4h* out, size_t n);
+
+/** @brief Clamp each component to [min, max]. out[i] = Clamp(in[i], min, max) */
+void ClampBatch(const Vec2h* in, int16_t min, int16_t max, Vec2h* out, size_t n);
+void ClampBatch(const Vec3h* in, int16_t min, int16_t max, Vec3h* out, size_t n);
+void ClampBatch(const Vec4h* in, int16_t min, int16_t max, Vec4h* out, size_t n);
+
+/** @brief Component wise minimum. out[i] = min(a[i], b[i]) */
+void MinBatch(const Vec2h* a, const Vec2h* b, Vec2h* out, size_t n);
+void MinBatch(const Vec3h* a, const Vec3h* b, Vec3h* out, size_t n);
+void MinBatch(const Vec4h* a, const Vec4h* b, Vec4h* out, size_t n);
+
+/** @brief Component wise maximum. out[i] = max(a[i], b[i]) */
+void MaxBatch(const Vec2h* a, const Vec2h* b, Vec2h* out, size_t n);
+void MaxBatch(const Vec3h* a, const Vec3h* b, Vec3h* out, size_t n);
+void MaxBatch(const Vec4h* a, const Vec4h* b, Vec4h* out, size_t n);
+
+/**
+ * @brief Dot products with pmaddwd. The int32 result is exact unless it
+ *        is out of the int32 range, which needs components close to
+ *        -32768; then it wraps.
+ *
+ * @param a   First vectors
+ * @param b   Second vectors
+ * @param out Output dot products
+ * @param n   Number of vectors
+ */
+void DotBatch(const Vec2h* a, const Vec2h* b, int32_t* out, size_t n);
+void DotBatch(const Vec3h* a, const Vec3h* b, int32_t* out, size_t n);
+void DotBatch(const Vec4h* a, const Vec4h* b, int32_t* out, size_t n);
+
+#endif // VECTOR_BATCH_H
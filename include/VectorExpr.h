@@ -0,0 +1,376 @@
+/**
+ * @file: VectorExpr.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef VECTOR_EXPR_H
+#define VECTOR_EXPR_H
+
+#include <stddef.h>
+#include <cassert>
+#include <type_traits>
+#include "Vector.h"
+
+//**********************************************************************
+//* Opt-in expression templates
+//**********************************************************************
+// The regular Vector2/3/4 operators return a new vector at every step, so
+// a + (b - c) * s + d * t builds four temporaries. Wrapping one operand in
+// Lazy() turns the whole expression into a tree of small nodes instead; the
+// result is computed component by component in a single pass when it is
+// assigned to a vector:
+//
+//   Vec3f r = Lazy(a) + (Lazy(b) - c) * s + d * t;
+//
+// Leaves can also be arrays (one vector or scalar per element), and
+// Evaluate() runs the fused expression over all of them in one loop:
+//
+//   Evaluate(out, n, Lazy(pos) + Lazy(vel) * dt);
+//
+// Intermediate values follow the usual C++ promotions (int16_t operands are
+// added as int) and are converted to the destination component type once,
+// when stored. Nodes keep references to their operands: evaluate the
+// expression in the statement that builds it instead of keeping it in an
+// auto variable past the lifetime of any temporary it uses.
+
+namespace VectorExpr
+{
+    //******************************************************************
+    //* Traits
+    //******************************************************************
+    template <class V> struct Dim : std::integral_constant<size_t, 0> {};
+    template <class T> struct Dim<Vector2<T>> : std::integral_constant<size_t, 2> {};
+    template <class T> struct Dim<Vector3<T>> : std::integral_constant<size_t, 3> {};
+    template <class T> struct Dim<Vector4<T>> : std::integral_constant<size_t, 4> {};
+
+    /** @brief Component I of a vector, without the branches of operator[]. */
+    template <size_t I, class V>
+    __attribute__((always_inline)) inline auto Component(const V& v)
+    {
+        if constexpr (I == 0) return v.x;
+        else if constexpr (I == 1) return v.y;
+        else if constexpr (I == 2) return v.z;
+        else return v.w;
+    }
+
+    template <class E, size_t N> struct Node;
+
+    template <class E> struct IsNode
+    {
+        template <class D, size_t N> static std::true_type test(const Node<D, N>*);
+        static std::false_type test(...);
+        static constexpr bool value = decltype(test(static_cast<const E*>(nullptr)))::value;
+    };
+
+    //******************************************************************
+    //* Vector nodes
+    //******************************************************************
+    /**
+     * @brief Base of every vector valued node
+     *
+     * Derived nodes implement Get<I>(i): component I of element i. Single
+     * vector leaves ignore i, array leaves index with it.
+     *
+     * @tparam E Derived node type
+     * @tparam N Number of components
+     */
+    template <class E, size_t N>
+    struct Node
+    {
+        static constexpr size_t Size = N;
+
+        __attribute__((always_inline)) const E& Self() const
+        {
+            return static_cast<const E&>(*this);
+        }
+
+        /** @brief Evaluate element i into a vector of type V. */
+        template <class V>
+        __attribute__((always_inline)) V Eval(size_t i) const
+        {
+            static_assert(Dim<V>::value == N, "VectorExpr: dimension mismatch");
+            typedef decltype(V::x) T;
+            const E& e = Self();
+            if constexpr (N == 2)
+                return V(T(e.template Get<0>(i)), T(e.template Get<1>(i)));
+            else if constexpr (N == 3)
+                return V(T(e.template Get<0>(i)), T(e.template Get<1>(i)), T(e.template Get<2>(i)));
+            else
+                return V(T(e.template Get<0>(i)), T(e.template Get<1>(i)),
+                         T(e.template Get<2>(i)), T(e.template Get<3>(i)));
+        }
+
+        /** @brief Evaluate a single vector expression. */
+        template <class V, std::enable_if_t<Dim<V>::value == N, int> = 0>
+        __attribute__((always_inline)) operator V() const
+        {
+            return Eval<V>(0);
+        }
+    };
+
+    /** @brief Single vector leaf. */
+    template <class V>
+    struct Ref : Node<Ref<V>, Dim<V>::value>
+    {
+        const V& v;
+        explicit Ref(const V& v) : v(v) {}
+
+        template <size_t I>
+        __attribute__((always_inline)) auto Get(size_t) const { return Component<I>(v); }
+    };
+
+    /** @brief Array leaf: element i of the array. */
+    template <class V>
+    struct ArrayRef : Node<ArrayRef<V>, Dim<V>::value>
+    {
+        const V* p;
+        explicit ArrayRef(const V* p) : p(p) {}
+
+        template <size_t I>
+        __attribute__((always_inline)) auto Get(size_t i) const { return Component<I>(p[i]); }
+    };
+
+    template <class A, class B>
+    struct Add : Node<Add<A, B>, A::Size>
+    {
+        static_assert(A::Size == B::Size, "VectorExpr: dimension mismatch");
+        A a;
+        B b;
+        Add(const A& a, const B& b) : a(a), b(b) {}
+
+        template <size_t I>
+        __attribute__((always_inline)) auto Get(size_t i) const
+        {
+            return a.template Get<I>(i) + b.template Get<I>(i);
+        }
+    };
+
+    template <class A, class B>
+    struct Sub : Node<Sub<A, B>, A::Size>
+    {
+        static_assert(A::Size == B::Size, "VectorExpr: dimension mismatch");
+        A a;
+        B b;
+        Sub(const A& a, const B& b) : a(a), b(b) {}
+
+        template <size_t I>
+        __attribute__((always_inline)) auto Get(size_t i) const
+        {
+            return a.template Get<I>(i) - b.template Get<I>(i);
+        }
+    };
+
+    template <class A>
+    struct Neg : Node<Neg<A>, A::Size>
+    {
+        A a;
+        explicit Neg(const A& a) : a(a) {}
+
+        template <size_t I>
+        __attribute__((always_inline)) auto Get(size_t i) const
+        {
+            return -a.template Get<I>(i);
+        }
+    };
+
+    template <class A, class S>
+    struct Mul : Node<Mul<A, S>, A::Size>
+    {
+        A a;
+        S s;
+        Mul(const A& a, const S& s) : a(a), s(s) {}
+
+        template <size_t I>
+        __attribute__((always_inline)) auto Get(size_t i) const
+        {
+            return a.template Get<I>(i) * s.Get(i);
+        }
+    };
+
+    template <class A, class S>
+    struct Div : Node<Div<A, S>, A::Size>
+    {
+        A a;
+        S s;
+        Div(const A& a, const S& s) : a(a), s(s) {}
+
+        template <size_t I>
+        __attribute__((always_inline)) auto Get(size_t i) const
+        {
+            return a.template Get<I>(i) / s.Get(i);
+        }
+    };
+
+    //******************************************************************
+    //* Scalar nodes
+    //******************************************************************
+    /** @brief Same scalar for every element. */
+    template <class T>
+    struct Scalar
+    {
+        T value;
+        explicit Scalar(T value) : value(value) {}
+        __attribute__((always_inline)) T Get(size_t) const { return value; }
+    };
+
+    /** @brief Element i of a scalar array. */
+    template <class T>
+    struct ScalarArray
+    {
+        const T* p;
+        explicit ScalarArray(const T* p) : p(p) {}
+        __attribute__((always_inline)) T Get(size_t i) const { return p[i]; }
+    };
+
+    template <class S> struct IsScalarNode : std::false_type {};
+    template <class T> struct IsScalarNode<ScalarArray<T>> : std::true_type {};
+
+    //******************************************************************
+    //* Operand wrapping
+    //******************************************************************
+    template <class X, class = void> struct Operand {};
+
+    template <class X>
+    struct Operand<X, std::enable_if_t<IsNode<X>::value>>
+    {
+        typedef X Type;
+        static const X& Wrap(const X& x) { return x; }
+    };
+
+    template <class X>
+    struct Operand<X, std::enable_if_t<(Dim<X>::value > 0)>>
+    {
+        typedef Ref<X> Type;
+        static Ref<X> Wrap(const X& x) { return Ref<X>(x); }
+    };
+
+    template <class X, class = void> struct ScalarOperand {};
+
+    template <class X>
+    struct ScalarOperand<X, std::enable_if_t<std::is_arithmetic<X>::value>>
+    {
+        typedef Scalar<X> Type;
+        static Scalar<X> Wrap(X x) { return Scalar<X>(x); }
+    };
+
+    template <class X>
+    struct ScalarOperand<X, std::enable_if_t<IsScalarNode<X>::value>>
+    {
+        typedef X Type;
+        static const X& Wrap(const X& x) { return x; }
+    };
+
+    // At least one side must already be a node, so the regular vector
+    // operators are never replaced
+    template <class A, class B, template <class, class> class Op>
+    using VectorOp = std::enable_if_t<(IsNode<A>::value || IsNode<B>::value),
+                                      Op<typename Operand<A>::Type, typename Operand<B>::Type>>;
+
+    template <class A, class S, template <class, class> class Op>
+    using ScalarOp = std::enable_if_t<IsNode<A>::value, Op<A, typename ScalarOperand<S>::Type>>;
+
+    //******************************************************************
+    //* Operators
+    //******************************************************************
+    template <class A, class B>
+    __attribute__((always_inline)) inline auto operator+(const A& a, const B& b) -> VectorOp<A, B, Add>
+    {
+        return { Operand<A>::Wrap(a), Operand<B>::Wrap(b) };
+    }
+
+    template <class A, class B>
+    __attribute__((always_inline)) inline auto operator-(const A& a, const B& b) -> VectorOp<A, B, Sub>
+    {
+        return { Operand<A>::Wrap(a), Operand<B>::Wrap(b) };
+    }
+
+    template <class A>
+    __attribute__((always_inline)) inline auto operator-(const A& a) -> std::enable_if_t<IsNode<A>::value, Neg<A>>
+    {
+        return Neg<A>(a);
+    }
+
+    template <class A, class S>
+    __attribute__((always_inline)) inline auto operator*(const A& a, const S& s) -> ScalarOp<A, S, Mul>
+    {
+        return { a, ScalarOperand<S>::Wrap(s) };
+    }
+
+    template <class S, class A>
+    __attribute__((always_inline)) inline auto operator*(const S& s, const A& a) -> ScalarOp<A, S, Mul>
+    {
+        return { a, ScalarOperand<S>::Wrap(s) };
+    }
+
+    template <class A, class S>
+    __attribute__((always_inline)) inline auto operator/(const A& a, const S& s) -> ScalarOp<A, S, Div>
+    {
+        if constexpr (std::is_arithmetic<S>::value)
+            assert(s != 0);
+        return { a, ScalarOperand<S>::Wrap(s) };
+    }
+} // namespace VectorExpr
+
+//**********************************************************************
+//* Entry points
+//**********************************************************************
+/** @brief Start an expression from a single vector. */
+template <class T>
+inline VectorExpr::Ref<Vector2<T>> Lazy(const Vector2<T>& v) { return VectorExpr::Ref<Vector2<T>>(v); }
+
+template <class T>
+inline VectorExpr::Ref<Vector3<T>> Lazy(const Vector3<T>& v) { return VectorExpr::Ref<Vector3<T>>(v); }
+
+template <class T>
+inline VectorExpr::Ref<Vector4<T>> Lazy(const Vector4<T>& v) { return VectorExpr::Ref<Vector4<T>>(v); }
+
+/** @brief Start an expression from an array. Element i of the result uses v[i]. */
+template <class T>
+inline VectorExpr::ArrayRef<Vector2<T>> Lazy(const Vector2<T>* v) { return VectorExpr::ArrayRef<Vector2<T>>(v); }
+
+template <class T>
+inline VectorExpr::ArrayRef<Vector3<T>> Lazy(const Vector3<T>* v) { return VectorExpr::ArrayRef<Vector3<T>>(v); }
+
+template <class T>
+inline VectorExpr::ArrayRef<Vector4<T>> Lazy(const Vector4<T>* v) { return VectorExpr::ArrayRef<Vector4<T>>(v); }
+
+/** @brief Per element scalar operand. Element i of the result uses s[i]. */
+template <class T>
+inline VectorExpr::ScalarArray<T> LazyScalars(const T* s) { return VectorExpr::ScalarArray<T>(s); }
+
+/**
+ * @brief Evaluate an expression for n elements in a single loop
+ *
+ * @param out  Destination array. May be one of the array operands, as each
+ *             element is read completely before it is written
+ * @param n    Number of elements
+ * @param expr Expression built from Lazy() operands
+ */
+template <class V, class E, size_t N>
+inline void Evaluate(V* out, size_t n, const VectorExpr::Node<E, N>& expr)
+{
+    const E& e = expr.Self();
+    for (size_t i = 0; i < n; i++)
+        out[i] = e.template Eval<V>(i);
+}
+
+#endif // VECTOR_EXPR_H
@@ -0,0 +1,264 @@
+/**
+ * @file: VectorSoA.h
+ * @author: Ricard Bitriá Ribes (https://github.com/dracir9)
+ * Created Date: 2026-10-17
+ * -----
+ * Last Modified: 17-10-2026
+ * Modified By: Ricard Bitriá Ribes
+ * -----
+ * @copyright (c) 2026 Ricard Bitriá Ribes
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef VECTOR_SOA_H
+#define VECTOR_SOA_H
+
+#include <stddef.h>
+#include "Vector.h"
+
+//**********************************************************************
+//* Structure of arrays vector streams
+//**********************************************************************
+// Each component is stored in its own lane (x0 x1 x2 .. / y0 y1 y2 ..).
+// Lanes start on a 64 byte boundary and are padded to a multiple of 16
+// floats, so SIMD kernels never need a scalar tail on these containers.
+
+/**
+ * @brief Stream of 3D float vectors stored as separate x/y/z lanes.
+ */
+class Vec3fSoA
+{
+public:
+    static constexpr size_t Alignment = 64;
+
+    Vec3fSoA() = default;
+    explicit Vec3fSoA(size_t n) { Resize(n); }
+
+    /** @brief Build from an array of packed vectors. */
+    Vec3fSoA(const Vec3f* v, size_t n) { Load(v, n); }
+
+    Vec3fSoA(const Vec3fSoA& other);
+    Vec3fSoA(Vec3fSoA&& other) noexcept;
+    Vec3fSoA& operator=(const Vec3fSoA& other);
+    Vec3fSoA& operator=(Vec3fSoA&& other) noexcept;
+    ~Vec3fSoA();
+
+    /**
+     * @brief Change the number of vectors. Existing values are kept,
+     *        new ones are left uninitialized.
+     *
+     * @param n New number of vectors
+     */
+    void Resize(size_t n);
+
+    /** @brief Number of vectors in the stream. */
+    size_t Size() const { return size; }
+
+    /** @brief Number of floats allocated per lane (multiple of 16). */
+    size_t Capacity() const { return capacity; }
+
+    /** @brief Gather vector i. */
+    Vec3f Get(size_t i) const
+    {
+        assert(i < size && "Vec3fSoA: index out of range");
+        return Vec3f(x[i], y[i], z[i]);
+    }
+
+    /** @brief Scatter v into slot i. */
+    void Set(size_t i, const Vec3f& v)
+    {
+        assert(i < size && "Vec3fSoA: index out of range");
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+
+    /**
+     * @brief Replace the contents with a repacked copy of an AoS array
+     *
+     * @param v Packed vectors
+     * @param n Number of vectors
+     */
+    void Load(const Vec3f* v, size_t n);
+
+    /**
+     * @brief Repack the contents into an AoS array
+     *
+     * @param v Destination array with room for Size() vectors
+     */
+    void Store(Vec3f* v) const;
+
+public:
+    // Component lanes. Null while the stream is empty.
+    float* x = nullptr;
+    float* y = nullptr;
+    float* z = nullptr;
+
+private:
+    size_t size = 0;
+    size_t capacity = 0;
+};
+
+/**
+ * @brief Stream of 4D float vectors stored as separate x/y/z/w lanes.
+ */
+class Vec4fSoA
+{
+public:
+    static constexpr size_t Alignment = 64;
+
+    Vec4fSoA() = default;
+    explicit Vec4fSoA(size_t n) { Resize(n); }
+
+    /** @brief Build from an array of packed vectors. */
+    Vec4fSoA(const Vec4f* v, size_t n) { Load(v, n); }
+
+    Vec4fSoA(const Vec4fSoA& other);
+    Vec4fSoA(Vec4fSoA&& other) noexcept;
+    Vec4fSoA& operator=(const Vec4fSoA& other);
+    Vec4fSoA& operator=(Vec4fSoA&& other) noexcept;
+    ~Vec4fSoA();
+
+    /**
+     * @brief Change the number of vectors. Existing values are kept,
+     *        new ones are left uninitialized.
+     *
+     * @param n New number of vectors
+     */
+    void Resize(size_t n);
+
+    /** @brief Number of vectors in the stream. */
+    size_t Size() const { return size; }
+
+    /** @brief Number of floats allocated per lane (multiple of 16). */
+    size_t Capacity() const { return capacity; }
+
+    /** @brief Gather vector i. */
+    Vec4f Get(size_t i) const
+    {
+        assert(i < size && "Vec4fSoA: index out of range");
+        return Vec4f(x[i], y[i], z[i], w[i]);
+    }
+
+    /** @brief Scatter v into slot i. */
+    void Set(size_t i, const Vec4f& v)
+    {
+        assert(i < size && "Vec4fSoA: index out of range");
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+        w[i] = v.w;
+    }
+
+    /**
+     * @brief Replace the contents with a repacked copy of an AoS array
+     *
+     * @param v Packed vectors
+     * @param n Number of vectors
+     */
+    void Load(const Vec4f* v, size_t n);
+
+    /**
+     * @brief Repack the contents into an AoS array
+     *
+     * @param v Destination array with room for Size() vectors
+     */
+    void Store(Vec4f* v) const;
+
+public:
+    // Component lanes. Null while the stream is empty.
+    float* x = nullptr;
+    float* y = nullptr;
+    float* z = nullptr;
+    float* w = nullptr;
+
+private:
+    size_t size = 0;
+    size_t capacity = 0;
+};
+
+//**********************************************************************
+//* AoS <-> SoA repacking kernels
+//**********************************************************************
+// Work on any pointers and any n. Lanes do not need to be aligned.
+
+/** @brief Split packed Vec3f into x/y/z lanes. */
+void RepackToSoA(const Vec3f* in, float* x, float* y, float* z, size_t n);
+
+/** @brief Interleave x/y/z lanes into packed Vec3f. */
+void RepackToAoS(const float* x, const float* y, const float* z, Vec3f* out, size_t n);
+
+/** @brief Split packed Vec4f into x/y/z/w lanes. */
+void RepackToSoA(const Vec4f* in, float* x, float* y, float* z, float* w, size_t n);
+
+/** @brief Interleave x/y/z/w lanes into packed Vec4f. */
+void RepackToAoS(const float* x, const float* y, const float* z, const float* w, Vec4f* out, size_t n);
+
+//**********************************************************************
+//* Vec3fSoA arithmetic
+//**********************************************************************
+// Operands must have the same size. The output is resized to match and may
+// be one of the inputs. Every SIMD level uses plain multiplies and adds (no
+// FMA) in the order shown, so all levels give the same results.
+
+/** @brief Component-wise addition. out[i] = a[i] + b[i] */
+void Add(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& out);
+
+/** @brief Component-wise subtraction. out[i] = a[i] - b[i] */
+void Sub(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& out);
+
+/** @brief Scalar multiplication. out[i] = a[i] * s */
+void Scale(const Vec3fSoA& a, float s, Vec3fSoA& out);
+
+/** @brief Dot products. out[i] = a[i] * b[i]. out must hold a.Size() floats */
+void Dot(const Vec3fSoA& a, const Vec3fSoA& b, float* out);
+
+/** @brief 3D cross products. out[i] = CrossProduct(a[i], b[i]) */
+void CrossProduct(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& out);
+
+/** @brief Linear interpolation. out[i] = Lerp(a[i], b[i], t) */
+void Lerp(const Vec3fSoA& a, const Vec3fSoA& b, float t, Vec3fSoA& out);
+
+/** @brief Component-wise minimum. out[i] = min(a[i], b[i]) */
+void min(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& out);
+
+/** @brief Component-wise maximum. out[i] = max(a[i], b[i]) */
+void max(const Vec3fSoA& a, const Vec3fSoA& b, Vec3fSoA& out);
+
+//**********************************************************************
+//* Vec4fSoA arithmetic
+//**********************************************************************
+/** @brief Component-wise addition. out[i] = a[i] + b[i] */
+void Add(const Vec4fSoA& a, const Vec4fSoA& b, Vec4fSoA& out);
+
+/** @brief Component-wise subtraction. out[i] = a[i] - b[i] */
+void Sub(const Vec4fSoA& a, const Vec4fSoA& b, Vec4fSoA& out);
+
+/** @brief Scalar multiplication. out[i] = a[i] * s */
+void Scale(const Vec4fSoA& a, float s, Vec4fSoA& out);
+
+/** @brief Dot products. out[i] = a[i] * b[i]. out must hold a.Size() floats */
+void Dot(const Vec4fSoA& a, const Vec4fSoA& b, float* out);
+
+/** @brief Linear interpolation. out[i] = Lerp(a[i], b[i], t) */
+void Lerp(const Vec4fSoA& a, const Vec4fSoA& b, float t, Vec4fSoA& out);
+
+/** @brief Component-wise minimum. out[i] = min(a[i], b[i]) */
+void min(const Vec4fSoA& a, const Vec4fSoA& b, Vec4fSoA& out);
+
+/** @brief Component-wise maximum. out[i] = max(a[i], b[i]) */
+void max(const Vec4fSoA& a, const Vec4fSoA& b, Vec4fSoA& out);
+
+#endif // VECTOR_SOA_H